@@ -0,0 +1,240 @@
+#ifndef OPENDIGITIZER_ACQUISITION_TAG_ENCODING_H
+#define OPENDIGITIZER_ACQUISITION_TAG_ENCODING_H
+
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <format>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gnuradio-4.0/Tag.hpp>
+#include <gnuradio-4.0/YamlPmt.hpp>
+
+#include "daq_api.hpp"
+
+namespace opendigitizer::acq {
+
+/**
+ * Compact binary encoding of tag property maps, an alternative to one YAML document per tag (Acquisition::triggerYamlPropertyMaps).
+ * All maps of an update are concatenated into Acquisition::triggerBinaryPropertyMaps, one map per entry of triggerIndices:
+ *
+ *   map   := u32 nEntries, nEntries * entry
+ *   entry := u32 keyLength, key bytes, u8 ValueType, payload
+ *
+ * Scalars are stored as raw host-endian bytes (like YaS, i.e. little-endian on all supported targets), strings and the YAML
+ * fallback as u32 length + bytes, nested maps recursively. Values of other types (vectors, tensors, ...) fall back to YAML.
+ * Bools are one byte 0 or 1, the decoder rejects other values and maps nested deeper than kMaxNestingDepth.
+ */
+namespace tag_encoding {
+
+/// TimeDomainContext::tagEncoding, matched case-insensitively, unknown values reject the subscription
+enum class Format { Yaml, Binary };
+
+enum class ValueType : std::uint8_t { Bool, Int8, Int16, Int32, Int64, UInt8, UInt16, UInt32, UInt64, Float32, Float64, ComplexFloat32, ComplexFloat64, String, Map, Yaml = 0xFF };
+
+/// nested maps below this many levels are rejected by decode() instead of recursing on untrusted input
+inline constexpr std::size_t kMaxNestingDepth = 32UZ;
+
+namespace detail {
+template<typename T>
+inline void appendRaw(std::vector<std::uint8_t>& out, const T& value) {
+    const auto offset = out.size();
+    out.resize(offset + sizeof(T));
+    std::memcpy(out.data() + offset, &value, sizeof(T));
+}
+
+inline void appendString(std::vector<std::uint8_t>& out, std::string_view str) {
+    appendRaw(out, static_cast<std::uint32_t>(str.size()));
+    out.insert(out.end(), str.begin(), str.end());
+}
+
+template<typename T>
+inline bool readRaw(std::span<const std::uint8_t>& in, T& value) {
+    if (in.size() < sizeof(T)) {
+        return false;
+    }
+    std::memcpy(&value, in.data(), sizeof(T));
+    in = in.subspan(sizeof(T));
+    return true;
+}
+
+inline bool readString(std::span<const std::uint8_t>& in, std::string& str) {
+    std::uint32_t size = 0;
+    if (!readRaw(in, size) || in.size() < size) {
+        return false;
+    }
+    str.assign(reinterpret_cast<const char*>(in.data()), size);
+    in = in.subspan(size);
+    return true;
+}
+
+template<typename T, ValueType type>
+inline bool tryAppendScalar(std::vector<std::uint8_t>& out, const gr::pmt::Value& value) {
+    if (const T* v = value.get_if<T>(); v != nullptr) {
+        appendRaw(out, type);
+        appendRaw(out, *v);
+        return true;
+    }
+    return false;
+}
+
+template<typename T>
+inline bool readScalar(std::span<const std::uint8_t>& in, gr::pmt::Value& value) {
+    T v{};
+    if (!readRaw(in, v)) {
+        return false;
+    }
+    value = gr::pmt::Value(v);
+    return true;
+}
+} // namespace detail
+
+inline void encode(const gr::property_map& map, std::vector<std::uint8_t>& out);
+
+inline void encodeValue(std::string_view key, const gr::pmt::Value& value, std::vector<std::uint8_t>& out) {
+    using enum ValueType;
+    if (value.is_string()) {
+        detail::appendRaw(out, String);
+        detail::appendString(out, value.value_or(std::string()));
+        return;
+    }
+    if (const auto* nested = value.get_if<gr::property_map>(); nested != nullptr) {
+        detail::appendRaw(out, Map);
+        encode(*nested, out);
+        return;
+    }
+    const bool isScalar = detail::tryAppendScalar<bool, Bool>(out, value) || detail::tryAppendScalar<std::int8_t, Int8>(out, value) || detail::tryAppendScalar<std::int16_t, Int16>(out, value) //
+                          || detail::tryAppendScalar<std::int32_t, Int32>(out, value) || detail::tryAppendScalar<std::int64_t, Int64>(out, value) || detail::tryAppendScalar<std::uint8_t, UInt8>(out, value)
+                          || detail::tryAppendScalar<std::uint16_t, UInt16>(out, value) || detail::tryAppendScalar<std::uint32_t, UInt32>(out, value) || detail::tryAppendScalar<std::uint64_t, UInt64>(out, value)
+                          || detail::tryAppendScalar<float, Float32>(out, value) || detail::tryAppendScalar<double, Float64>(out, value) || detail::tryAppendScalar<std::complex<float>, ComplexFloat32>(out, value)
+                          || detail::tryAppendScalar<std::complex<double>, ComplexFloat64>(out, value);
+    if (!isScalar) {
+        gr::property_map single;
+        single[gr::property_map::key_type(key)] = value;
+        detail::appendRaw(out, Yaml);
+        detail::appendString(out, gr::pmt::yaml::serialize(single));
+    }
+}
+
+/// appends the binary encoding of `map` to `out`
+inline void encode(const gr::property_map& map, std::vector<std::uint8_t>& out) {
+    detail::appendRaw(out, static_cast<std::uint32_t>(map.size()));
+    for (const auto& [key, value] : map) {
+        detail::appendString(out, std::string_view(key));
+        encodeValue(std::string_view(key), value, out);
+    }
+}
+
+/// decodes one map from the front of `in` and advances `in` past it, `depth` is the nesting level of the map (0 for top-level maps)
+inline std::expected<gr::property_map, std::string> decode(std::span<const std::uint8_t>& in, std::size_t depth = 0UZ) {
+    using enum ValueType;
+    std::uint32_t nEntries = 0;
+    if (!detail::readRaw(in, nEntries)) {
+        return std::unexpected(std::string("truncated map header"));
+    }
+
+    gr::property_map map;
+    std::string      key;
+    for (std::uint32_t i = 0; i < nEntries; ++i) {
+        ValueType type{};
+        if (!detail::readString(in, key) || !detail::readRaw(in, type)) {
+            return std::unexpected(std::string("truncated map entry"));
+        }
+
+        gr::pmt::Value value;
+        bool           ok = true;
+        switch (type) {
+        case Bool: {
+            std::uint8_t raw = 0U; // not read into a bool directly, any byte other than 0 or 1 would be an invalid bool object
+            ok = detail::readRaw(in, raw);
+            if (ok && raw > 1U) {
+                return std::unexpected(std::format("invalid bool value {} for '{}'", raw, key));
+            }
+            value = gr::pmt::Value(raw != 0U);
+            break;
+        }
+        case Int8: ok = detail::readScalar<std::int8_t>(in, value); break;
+        case Int16: ok = detail::readScalar<std::int16_t>(in, value); break;
+        case Int32: ok = detail::readScalar<std::int32_t>(in, value); break;
+        case Int64: ok = detail::readScalar<std::int64_t>(in, value); break;
+        case UInt8: ok = detail::readScalar<std::uint8_t>(in, value); break;
+        case UInt16: ok = detail::readScalar<std::uint16_t>(in, value); break;
+        case UInt32: ok = detail::readScalar<std::uint32_t>(in, value); break;
+        case UInt64: ok = detail::readScalar<std::uint64_t>(in, value); break;
+        case Float32: ok = detail::readScalar<float>(in, value); break;
+        case Float64: ok = detail::readScalar<double>(in, value); break;
+        case ComplexFloat32: ok = detail::readScalar<std::complex<float>>(in, value); break;
+        case ComplexFloat64: ok = detail::readScalar<std::complex<double>>(in, value); break;
+        case String: {
+            std::string str;
+            ok    = detail::readString(in, str);
+            value = gr::pmt::Value(std::move(str));
+            break;
+        }
+        case Map: {
+            if (depth + 1UZ >= kMaxNestingDepth) {
+                return std::unexpected(std::format("maps nested deeper than {} levels at '{}'", kMaxNestingDepth, key));
+            }
+            auto nested = decode(in, depth + 1UZ);
+            if (!nested) {
+                return nested;
+            }
+            value = gr::pmt::Value(std::move(*nested));
+            break;
+        }
+        case Yaml: {
+            std::string yaml;
+            if (!detail::readString(in, yaml)) {
+                return std::unexpected(std::string("truncated yaml value"));
+            }
+            const auto single = gr::pmt::yaml::deserialize(yaml);
+            if (!single) {
+                return std::unexpected(std::format("could not parse yaml value of '{}': {}", key, single.error().message));
+            }
+            for (const auto& [singleKey, singleValue] : *single) {
+                map[singleKey] = singleValue;
+            }
+            continue;
+        }
+        default: return std::unexpected(std::format("unknown value type {} for '{}'", static_cast<int>(type), key));
+        }
+        if (!ok) {
+            return std::unexpected(std::format("truncated value of '{}'", key));
+        }
+        map[gr::property_map::key_type(std::string_view(key))] = std::move(value);
+    }
+    return map;
+}
+
+} // namespace tag_encoding
+
+/// the property maps of the tags of an update (one per triggerIndices entry), from whichever encoding the service used
+inline std::vector<gr::property_map> decodeTriggerPropertyMaps(const Acquisition& acq) {
+    std::vector<gr::property_map> maps;
+    maps.reserve(acq.triggerIndices.size());
+    if (!acq.triggerBinaryPropertyMaps.value().empty()) {
+        std::span<const std::uint8_t> in(acq.triggerBinaryPropertyMaps.value());
+        while (!in.empty() && maps.size() < acq.triggerIndices.size()) {
+            auto map = tag_encoding::decode(in);
+            if (!map) {
+                break;
+            }
+            maps.push_back(std::move(*map));
+        }
+    } else {
+        for (const auto& yaml : acq.triggerYamlPropertyMaps.value()) {
+            auto map = gr::pmt::yaml::deserialize(yaml);
+            maps.push_back(map ? std::move(*map) : gr::property_map{});
+        }
+    }
+    maps.resize(acq.triggerIndices.size()); // missing or undecodable maps are empty
+    return maps;
+}
+
+} // namespace opendigitizer::acq
+
+#endif // OPENDIGITIZER_ACQUISITION_TAG_ENCODING_H
@@ -191,10 +191,12 @@ struct Acquisition {
     Annotated<std::vector<std::string>, opencmw::NoUnit, "S.I. quantities of post-processed signals"> channelQuantities;
     Annotated<int64_t, si::time<nanosecond>, "time-stamp w.r.t. beam-in trigger">                     acqLocalTimeStamp = 0;
     Annotated<std::vector<int64_t>, opencmw::NoUnit, "indices of trigger tags">                       triggerIndices;
+    Annotated<std::vector<int32_t>, opencmw::NoUnit, "channel (row) the trigger tags belong to">      triggerChannelIndices;
     Annotated<std::vector<std::string>, opencmw::NoUnit, "event names of trigger tags">               triggerEventNames;
     Annotated<std::vector<int64_t>, si::time<nanosecond>, "timestamps of trigger tags">               triggerTimestamps;
     Annotated<std::vector<float>, si::time<second>, "sample delay w.r.t. the trigger">                triggerOffsets;
     Annotated<std::vector<std::string>, opencmw::NoUnit, "yaml of Tag's property_map">                triggerYamlPropertyMaps;
+    Annotated<std::vector<std::uint8_t>, opencmw::NoUnit, "binary Tag's property_maps (TagEncoding)"> triggerBinaryPropertyMaps;
     Annotated<std::vector<std::string>, opencmw::NoUnit, "list of error messages for this update">    acqErrors;
 };
 
@@ -230,6 +232,12 @@ struct TimeDomainContext {
     int32_t                 postSamples       = 0;                     // Trigger mode
     int32_t                 maximumWindowSize = 65535;                 // Multiplexed mode
     int64_t                 snapshotDelay     = 0;                     // nanoseconds, Snapshot mode
+    bool                    noErrors          = false;                 // leave channelErrors empty instead of sending all-zero errors
+    bool                    implicitTimeAxis  = false;                 // Continuous mode: leave channelTimeSinceRefTrigger empty, t_i = i / sample_rate
+    std::string             tagEncoding       = "yaml";                // "yaml": triggerYamlPropertyMaps, "binary": triggerBinaryPropertyMaps (TagEncoding.hpp)
+    int32_t                 decimation        = 1;                     // reduce each `decimation` samples to one bucket (1: off)
+    int32_t                 targetPoints      = 0;                     // increase the decimation until a window (Continuous: an update) has at most this many points (0: off)
+    std::string             decimationMode    = "minmax";              // per bucket: "minmax" (envelope, two points), "min", "max" or "mean"
     opencmw::MIME::MimeType contentType       = opencmw::MIME::BINARY; // YaS
 };
 
@@ -238,6 +246,9 @@ struct FreqDomainContext {
     std::string             acquisitionModeFilter = "continuous"; // one of "continuous", "triggered", "multiplexed", "snapshot"
     std::string             triggerNameFilter;
     int32_t                 maxClientUpdateFrequencyFilter = 25;
+    int32_t                 fftSize                        = 1024;                  // number of (decimated) samples per FFT frame
+    int32_t                 decimation                     = 1;                     // block average over this many samples before the FFT
+    int32_t                 averaging                      = 1;                     // number of FFT frames averaged per published spectrum
     opencmw::MIME::MimeType contentType                    = opencmw::MIME::BINARY; // YaS
 };
 
@@ -250,11 +261,11 @@ struct FreqDomainContext {
 
 ENABLE_REFLECTION_FOR(opendigitizer::acq::Acquisition, refTriggerName, refTriggerStamp, channelTimeSinceRefTrigger, channelUserDelay, channelActualDelay, channelNames, channelValues, channelErrors, channelQuantities, //
     channelUnits, status, channelRangeMin, channelRangeMax, temperature, processIndex, sequenceIndex, chainIndex, eventNumber, timingGroupID, acquisitionStamp, eventStamp, processStartStamp, sequenceStartStamp,       //
-    chainStartStamp, acqLocalTimeStamp, triggerIndices, triggerEventNames, triggerTimestamps, triggerOffsets, triggerYamlPropertyMaps, acqErrors)
+    chainStartStamp, acqLocalTimeStamp, triggerIndices, triggerChannelIndices, triggerEventNames, triggerTimestamps, triggerOffsets, triggerYamlPropertyMaps, triggerBinaryPropertyMaps, acqErrors)
 ENABLE_REFLECTION_FOR(opendigitizer::acq::AcquisitionSpectra, selectedFilter, acqTriggerName, acqTriggerTimeStamp, acqLocalTimeStamp, channelName, channelMagnitude, channelMagnitude_dimensions, channelMagnitude_labels, //
     channelMagnitude_dim1_labels, channelMagnitude_dim2_labels, channelPhase, channelPhase_labels, channelPhase_dim1_labels, channelPhase_dim2_labels)
-ENABLE_REFLECTION_FOR(opendigitizer::acq::TimeDomainContext, channelNameFilter, acquisitionModeFilter, triggerNameFilter, maxClientUpdateFrequencyFilter, preSamples, postSamples, maximumWindowSize, snapshotDelay, contentType)
-ENABLE_REFLECTION_FOR(opendigitizer::acq::FreqDomainContext, channelNameFilter, acquisitionModeFilter, triggerNameFilter, maxClientUpdateFrequencyFilter, contentType)
+ENABLE_REFLECTION_FOR(opendigitizer::acq::TimeDomainContext, channelNameFilter, acquisitionModeFilter, triggerNameFilter, maxClientUpdateFrequencyFilter, preSamples, postSamples, maximumWindowSize, snapshotDelay, noErrors, implicitTimeAxis, tagEncoding, decimation, targetPoints, decimationMode, contentType)
+ENABLE_REFLECTION_FOR(opendigitizer::acq::FreqDomainContext, channelNameFilter, acquisitionModeFilter, triggerNameFilter, maxClientUpdateFrequencyFilter, fftSize, decimation, averaging, contentType)
 
 #if defined(__EMSCRIPTEN__) && defined(__clang__)
 #pragma clang diagnostic pop
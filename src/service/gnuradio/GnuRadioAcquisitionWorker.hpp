@@ -2,6 +2,7 @@
 #define OPENDIGITIZER_SERVICE_GNURADIOACQUISITIONWORKER_H
 
 #include "gnuradio-4.0/Message.hpp"
+#include <TagEncoding.hpp>
 #include <daq_api.hpp>
 
 #include <majordomo/Worker.hpp>
@@ -11,11 +12,23 @@
 #include <gnuradio-4.0/PmtTypeHelpers.hpp>
 #include <gnuradio-4.0/Scheduler.hpp>
 #include <gnuradio-4.0/ValueHelper.hpp>
+#include <gnuradio-4.0/YamlPmt.hpp>
 #include <gnuradio-4.0/basic/DataSink.hpp>
+#include <gnuradio-4.0/thread/thread_pool.hpp>
 
+#include <algorithm>
+#include <cctype>
+#include <charconv>
 #include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <map>
 #include <memory>
+#include <numeric>
+#include <optional>
 #include <ranges>
+#include <set>
 #include <string_view>
 #include <utility>
 
@@ -104,6 +117,32 @@ inline std::optional<T> getSetting(const std::shared_ptr<gr::BlockModel>& block,
     return {};
 }
 
+/// recycles the sample vectors of sent replies, so that streaming updates do not allocate fresh buffers on every notify
+template<typename T>
+class BufferPool {
+    std::vector<std::vector<T>> _free;
+    std::size_t                 _maxFree;
+
+public:
+    explicit BufferPool(std::size_t maxFree = 8UZ) : _maxFree(maxFree) {}
+
+    [[nodiscard]] std::vector<T> acquire() {
+        if (_free.empty()) {
+            return {};
+        }
+        auto buffer = std::move(_free.back());
+        _free.pop_back();
+        buffer.clear();
+        return buffer;
+    }
+
+    void release(std::vector<T>&& buffer) {
+        if (buffer.capacity() > 0 && _free.size() < _maxFree) {
+            _free.push_back(std::move(buffer));
+        }
+    }
+};
+
 template<typename TEnum>
 [[nodiscard]] inline constexpr TEnum convertToEnum(std::string_view strEnum) {
     auto enumType = magic_enum::enum_cast<TEnum>(strEnum, magic_enum::case_insensitive);
@@ -113,6 +152,52 @@ template<typename TEnum>
     return enumType.value();
 }
 
+/// type-erased scheduler, so that the execution policy can be chosen at runtime (cf. DigitizerUi::Scheduler)
+struct SchedulerModel {
+    virtual ~SchedulerModel() noexcept = default;
+
+    virtual std::string_view uniqueName() const                                                 = 0;
+    virtual gr::Graph&       graph()                                                            = 0;
+    virtual bool             connect(gr::MsgPortOut& toScheduler, gr::MsgPortIn& fromScheduler) = 0;
+    virtual void             runAndWait()                                                       = 0;
+};
+
+template<typename TScheduler>
+struct SchedulerImpl final : SchedulerModel {
+    TScheduler _scheduler;
+
+    explicit SchedulerImpl(gr::Graph&& graph) { std::ignore = _scheduler.exchange(std::move(graph)); }
+
+    std::string_view uniqueName() const override { return _scheduler.unique_name; }
+    gr::Graph&       graph() override { return _scheduler.graph(); }
+    bool             connect(gr::MsgPortOut& toScheduler, gr::MsgPortIn& fromScheduler) override { return toScheduler.connect(_scheduler.msgIn) && _scheduler.msgOut.connect(fromScheduler); }
+    void             runAndWait() override { _scheduler.runAndWait(); }
+};
+
+inline std::unique_ptr<SchedulerModel> makeScheduler(gr::scheduler::ExecutionPolicy policy, gr::Graph&& graph) {
+    using enum gr::scheduler::ExecutionPolicy;
+    switch (policy) {
+    case singleThreaded: return std::make_unique<SchedulerImpl<gr::scheduler::Simple<singleThreaded>>>(std::move(graph));
+    case multiThreaded: return std::make_unique<SchedulerImpl<gr::scheduler::Simple<multiThreaded>>>(std::move(graph));
+    case singleThreadedBlocking: return std::make_unique<SchedulerImpl<gr::scheduler::Simple<singleThreadedBlocking>>>(std::move(graph));
+    default: throw std::invalid_argument(std::format("Unsupported scheduler execution policy '{}'", magic_enum::enum_name(policy)));
+    }
+}
+
+/// the `scheduler:` section of a GRC document, empty if there is none
+inline gr::property_map schedulerSection(std::string_view grc) {
+    const auto yaml = gr::pmt::yaml::deserialize(grc);
+    if (!yaml) {
+        return {}; // loadGrc reports the parse error
+    }
+    if (const auto it = yaml->find(std::string_view("scheduler")); it != yaml->end()) {
+        if (const auto* section = it->second.get_if<gr::property_map>(); section != nullptr) {
+            return *section;
+        }
+    }
+    return {};
+}
+
 } // namespace detail
 
 using namespace gr;
@@ -123,13 +208,112 @@ using namespace std::chrono_literals;
 
 enum class AcquisitionMode { Continuous, Triggered, Multiplexed, Snapshot, DataSet };
 
+enum class NotifyMode {
+    Polling,    ///< wake up every `rate` and walk all subscriptions
+    EventDriven ///< wake up when the graph made progress (new data), `rate` only bounds how long an idle graph waits for lifecycle/settings messages
+};
+
+/// parses a CPU list like "0-3,6" (taskset/cpuset syntax), throws std::invalid_argument if malformed
+inline std::vector<std::size_t> parseCpuList(std::string_view cpuList) {
+    auto parseCpu = [cpuList](std::string_view str) {
+        std::size_t cpu = 0;
+        if (const auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), cpu); ec != std::errc{} || ptr != str.data() + str.size()) {
+            throw std::invalid_argument(std::format("Invalid CPU list '{}'", cpuList));
+        }
+        return cpu;
+    };
+
+    std::vector<std::size_t> cpus;
+    for (auto part : cpuList | std::views::split(',')) {
+        const auto range = std::string_view(part.begin(), part.end());
+        if (range.empty()) {
+            continue;
+        }
+        const auto dash  = range.find('-');
+        const auto first = parseCpu(range.substr(0, dash));
+        const auto last  = dash == std::string_view::npos ? first : parseCpu(range.substr(dash + 1));
+        if (last < first) {
+            throw std::invalid_argument(std::format("Invalid CPU range '{}' in CPU list '{}'", range, cpuList));
+        }
+        for (std::size_t cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    std::ranges::sort(cpus);
+    const auto duplicates = std::ranges::unique(cpus);
+    cpus.erase(duplicates.begin(), duplicates.end());
+    return cpus;
+}
+
+/// how the flow graph is executed: service-wide defaults (Settings), overridden per graph by the `scheduler:` section of the GRC
+struct SchedulerConfig {
+    static constexpr std::size_t kDefaultThreads = 2UZ; ///< size of the default CPU pool registered by the service (registerDefaultThreadPool() in main.cpp)
+
+    gr::scheduler::ExecutionPolicy policy      = gr::scheduler::ExecutionPolicy::singleThreadedBlocking;
+    std::optional<std::size_t>     threads     = {}; ///< size of the default CPU pool the scheduler (and its workers for multiThreaded) run on, nullopt: keep the pool
+    std::vector<std::size_t>       cpuAffinity = {}; ///< CPUs the pool threads are pinned to, empty: no restriction
+
+    bool operator==(const SchedulerConfig&) const = default;
+
+    /// whether the default CPU pool has to be replaced, the pool registered by the service is kept unless threads or CPUs are configured
+    [[nodiscard]] bool customPool() const noexcept { return threads.has_value() || !cpuAffinity.empty(); }
+
+    /// applies the entries `policy`, `threads` and `cpu_affinity` of a GRC `scheduler:` section, throws std::invalid_argument on invalid values
+    [[nodiscard]] SchedulerConfig withOverrides(const gr::property_map& section) const {
+        auto value = [&section]<typename T>(std::string_view key, std::type_identity<T>) -> std::optional<T> {
+            if (!section.contains(key)) {
+                return std::nullopt;
+            }
+            auto result = detail::get<T>(section, key);
+            if (!result) {
+                throw std::invalid_argument(std::format("Invalid scheduler setting: {}", result.error()));
+            }
+            return *result;
+        };
+
+        SchedulerConfig config = *this;
+        if (const auto policyName = value("policy", std::type_identity<std::string>{})) {
+            config.policy = detail::convertToEnum<gr::scheduler::ExecutionPolicy>(*policyName);
+        }
+        if (const auto nThreads = value("threads", std::type_identity<std::size_t>{})) {
+            config.threads = std::max(*nThreads, 1UZ);
+        }
+        if (const auto cpus = value("cpu_affinity", std::type_identity<std::string>{})) {
+            config.cpuAffinity = parseCpuList(*cpus);
+        }
+        return config;
+    }
+};
+
+using CpuPoolPtr = decltype(gr::thread_pool::Manager::defaultCpuPool());
+
+/// replaces the default CPU pool with one of `config.threads` threads (default: kDefaultThreads), pinned to `config.cpuAffinity` if given,
+/// returns the replaced pool to be handed to restoreCpuPool() once the scheduler running on the new pool has stopped
+[[nodiscard]] inline CpuPoolPtr applyCpuPool(const SchedulerConfig& config) {
+    using namespace gr::thread_pool;
+    CpuPoolPtr previous = Manager::defaultCpuPool();
+    const auto nThreads = static_cast<std::uint32_t>(config.threads.value_or(SchedulerConfig::kDefaultThreads));
+    auto       pool     = std::make_unique<BasicThreadPool>(std::string(kDefaultCpuPoolId), TaskType::CPU_BOUND, nThreads, nThreads);
+    if (!config.cpuAffinity.empty()) {
+        std::vector<bool> mask(config.cpuAffinity.back() + 1UZ, false);
+        for (const auto cpu : config.cpuAffinity) {
+            mask[cpu] = true;
+        }
+        pool->setAffinityMask(mask);
+    }
+    Manager::instance().replacePool(std::string(kDefaultCpuPoolId), std::make_shared<ThreadPoolWrapper>(std::move(pool), "CPU"));
+    return previous;
+}
+
+/// registers a pool returned by applyCpuPool() as the default CPU pool again
+inline void restoreCpuPool(CpuPoolPtr pool) { gr::thread_pool::Manager::instance().replacePool(std::string(gr::thread_pool::kDefaultCpuPoolId), std::move(pool)); }
+
+/// identifies a poller, subscriptions that only differ in their window (preSamples/postSamples/maximumWindowSize) share the same poller
 struct PollerKey {
     AcquisitionMode          mode;
     std::string              signal_name;
-    std::size_t              pre_samples         = 0;   // Trigger
-    std::size_t              post_samples        = 0;   // Trigger
-    std::size_t              maximum_window_size = 0;   // Multiplexed
-    std::chrono::nanoseconds snapshot_delay      = 0ns; // Snapshot
+    std::string              trigger_filter;       // Trigger, Multiplexed, Snapshot
+    std::chrono::nanoseconds snapshot_delay = 0ns; // Snapshot
 
     auto operator<=>(const PollerKey&) const noexcept = default;
 };
@@ -188,6 +372,9 @@ struct TimingEventState {
         }
     }
 
+    /// the state with the more recent event, e.g. of the channels packed into one reply, invalid states never win
+    [[nodiscard]] static const TimingEventState& mostRecent(const TimingEventState& lhs, const TimingEventState& rhs) noexcept { return rhs.valid && (!lhs.valid || rhs.eventStamp > lhs.eventStamp) ? rhs : lhs; }
+
 private:
     static bool hasFairTimingContext(const gr::property_map& tagMap) {
         const auto contextIt = tagMap.find(gr::tag::CONTEXT.shortKey());
@@ -256,6 +443,14 @@ private:
     }
 };
 
+/// the samples, tags and errors drained from a streaming poller in one notify tick. The chunk is shared by the pending data of all
+/// subscriptions of the signal and must not be modified while shared, its buffers are only reused (or moved into a reply) by the last owner
+struct StreamingChunk {
+    std::vector<float>       samples;
+    std::vector<gr::Tag>     tags; // indices relative to the first sample of the chunk
+    std::vector<std::string> errors;
+};
+
 struct StreamingPollerEntry {
     using SampleType                                               = float;
     bool                                                    in_use = true;
@@ -267,6 +462,12 @@ struct StreamingPollerEntry {
     std::optional<float>                                    signal_min;
     std::optional<float>                                    signal_max;
     TimingEventState                                        timingEventState;
+    detail::BufferPool<SampleType>                          bufferPool; // chunk and reply buffers, shared by all subscriptions of this signal
+
+    // data drained from the poller during the current notify tick, referenced by the pending data of all subscriptions of this signal
+    bool                            drained     = false;
+    bool                            wasFinished = false;
+    std::shared_ptr<StreamingChunk> tickChunk;
 
     explicit StreamingPollerEntry(std::shared_ptr<basic::StreamingPoller<SampleType>> p) : poller{p} {}
 
@@ -306,6 +507,107 @@ struct StreamingPollerEntry {
     }
 };
 
+/// continuous-mode state of a single subscription (topic): samples of ticks that were skipped due to maxClientUpdateFrequencyFilter are coalesced into the next update
+struct StreamingSubscriptionState {
+    /// the not yet sent part of the chunks appended since the last update, samples are never copied or moved within the pending data
+    struct PendingSignal {
+        struct ChunkRef {
+            std::shared_ptr<StreamingChunk> chunk;
+            std::size_t                     begin = 0UZ; // first sample not sent yet
+            std::size_t                     end   = 0UZ; // number of samples of the chunk
+        };
+
+        std::deque<ChunkRef>     chunks;
+        std::size_t              nSamples = 0UZ;
+        std::vector<std::string> errors;
+
+        void append(const std::shared_ptr<StreamingChunk>& chunk) {
+            if (!chunk->samples.empty() || !chunk->tags.empty()) {
+                chunks.push_back(ChunkRef{.chunk = chunk, .end = chunk->samples.size()});
+                nSamples += chunk->samples.size();
+            }
+            errors.insert(errors.end(), chunk->errors.begin(), chunk->errors.end());
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept { return nSamples; }
+        [[nodiscard]] bool        empty() const noexcept { return chunks.empty() && errors.empty(); }
+
+        /// the first `n` samples as a buffer that can be moved into a reply: if they are exactly the front chunk and no other
+        /// subscription references it, nothing is copied
+        [[nodiscard]] std::vector<float> takeFront(std::size_t n, detail::BufferPool<float>& pool) {
+            if (auto& front = chunks.front(); front.begin == 0UZ && front.end == n && front.chunk.use_count() == 1) {
+                return std::move(front.chunk->samples);
+            }
+            auto buffer = pool.acquire();
+            buffer.reserve(n);
+            copyFront(n, buffer);
+            return buffer;
+        }
+
+        /// appends the first `n` samples to `out`
+        void copyFront(std::size_t n, std::vector<float>& out) const {
+            for (auto it = chunks.begin(); n > 0UZ && it != chunks.end(); ++it) {
+                const auto count = std::min(n, it->end - it->begin);
+                const auto first = it->chunk->samples.begin() + static_cast<std::ptrdiff_t>(it->begin);
+                out.insert(out.end(), first, first + static_cast<std::ptrdiff_t>(count));
+                n -= count;
+            }
+        }
+
+        /// calls `fn(index, map)` for the pending tags with index < n, the index is relative to the first pending sample
+        void forEachTag(std::size_t n, auto&& fn) const {
+            std::size_t first = 0UZ; // pending index of the chunk's first unsent sample
+            for (auto it = chunks.begin(); it != chunks.end() && first < n; ++it) {
+                for (const auto& tag : it->chunk->tags) {
+                    if (tag.index >= it->begin && first + (tag.index - it->begin) < n) {
+                        fn(first + (tag.index - it->begin), tag.map);
+                    }
+                }
+                first += it->end - it->begin;
+            }
+        }
+
+        /// removes the first `n` samples and their tags by releasing whole chunks and advancing the offset into the front chunk,
+        /// released chunks that are not referenced by other subscriptions hand their buffer to `pool`
+        void dropFront(std::size_t n, detail::BufferPool<float>& pool) {
+            nSamples -= std::min(n, nSamples);
+            while (!chunks.empty()) {
+                auto&      front     = chunks.front();
+                const auto remaining = front.end - front.begin;
+                if (n < remaining || (n == remaining && std::ranges::any_of(front.chunk->tags, [&front](const gr::Tag& tag) { return tag.index >= front.end; }))) {
+                    front.begin += n; // tags behind the last sample of the chunk belong to the next pending sample
+                    return;
+                }
+                n -= remaining;
+                if (front.chunk.use_count() == 1) {
+                    pool.release(std::move(front.chunk->samples));
+                }
+                chunks.pop_front();
+            }
+        }
+    };
+
+    std::map<std::string, PendingSignal, std::less<>> pendingBySignal;
+    std::chrono::steady_clock::time_point             lastNotify{};
+
+    /// channels that do not advance in lock-step (stalled signal) are sent on their own once this many samples are pending
+    static constexpr std::size_t kMaxUnalignedSamples = 1UZ << 20;
+
+    [[nodiscard]] static std::chrono::nanoseconds minUpdateInterval(const TimeDomainContext& context) noexcept { //
+        return context.maxClientUpdateFrequencyFilter > 0 ? std::chrono::nanoseconds(1s) / context.maxClientUpdateFrequencyFilter : 0ns;
+    }
+
+    /// the time the pending data held back by the rate limit may be sent, nullopt if nothing is held back at `now` (nothing
+    /// pending, or pending but already due, i.e. waiting for more samples rather than for the limit)
+    [[nodiscard]] std::optional<std::chrono::steady_clock::time_point> heldBackUntil(std::chrono::nanoseconds minUpdateInterval, std::chrono::steady_clock::time_point now) const {
+        const auto due = lastNotify + minUpdateInterval;
+        if (due <= now || std::ranges::all_of(pendingBySignal | std::views::values, &PendingSignal::empty)) {
+            return std::nullopt;
+        }
+        return due;
+    }
+};
+
 namespace detail {
 
 struct Matcher {
@@ -313,6 +615,26 @@ struct Matcher {
     trigger::MatchResult operator()(std::string_view, const Tag& tag, property_map& filterState) { return trigger::BasicTriggerNameCtxMatcher::filter(filterDefinition, tag, filterState); }
 };
 
+/// splits a comma-separated channelNameFilter, surrounding whitespace and empty entries are dropped
+inline std::vector<std::string> parseSignalNameList(std::string_view input) {
+    namespace views = std::ranges::views;
+
+    auto isNotSpace = [](char ch) { return !std::isspace(static_cast<unsigned char>(ch)); };
+
+    std::vector<std::string> result;
+    for (auto subRange : input | views::split(',')) {
+        std::string str(subRange.begin(), subRange.end());
+
+        auto lead = std::ranges::find_if(str, isNotSpace);
+        if (lead == str.end()) {
+            continue;
+        }
+        auto trailRev = std::ranges::find_if(str | views::reverse, isNotSpace);
+        result.emplace_back(lead, trailRev.base());
+    }
+    return result;
+}
+
 inline const SignalEntry* findSignalEntryByName(const std::map<std::string, SignalEntry>& signalEntryBySink, std::string_view signalName, SignalType type) {
     const auto it = std::ranges::find_if(signalEntryBySink, [signalName, type](const auto& entry) { return entry.second.type == type && entry.second.name == signalName; });
     return it == signalEntryBySink.end() ? nullptr : &it->second;
@@ -323,6 +645,243 @@ inline const SignalEntry* findSignalEntryByName(const std::map<std::string, Sign
 struct DataSetPollerEntry {
     using SampleType = float;
     std::shared_ptr<gr::basic::DataSetPoller<SampleType>> poller;
+    std::size_t                                           pre_samples         = 0; // Trigger: encompassing window of all subscribers
+    std::size_t                                           post_samples        = 0; // Trigger: encompassing window of all subscribers
+    std::size_t                                           maximum_window_size = 0; // Multiplexed: encompassing window of all subscribers
+
+    struct PolledDataSet {
+        gr::DataSet<SampleType> dataSet;
+        std::size_t             postSamples = 0UZ; // Triggered: post_samples of the poller it came from, the trigger is postSamples before its end
+    };
+
+    // DataSets drained from the poller during the current notify tick, shared by all subscriptions of this poller
+    bool                       drained     = false;
+    bool                       wasFinished = false;
+    std::vector<PolledDataSet> tickDataSets;
+    std::vector<PolledDataSet> replacedPollerDataSets; // drained from a poller replaced for a wider window, sent with the next tick
+
+    /// moves all DataSets available from `from` to `to`
+    static void drain(gr::basic::DataSetPoller<SampleType>& from, std::size_t postSamples, std::vector<PolledDataSet>& to) {
+        while (from.process(
+            [&to, postSamples](std::span<const gr::DataSet<SampleType>> dataSets) {
+                for (const auto& dataSet : dataSets) {
+                    to.push_back({.dataSet = dataSet, .postSamples = postSamples});
+                }
+            },
+            1)) {
+        }
+    }
+
+    /// the [first, first + count) sample range of a subscriber's window within a DataSet of this poller
+    [[nodiscard]] static std::pair<std::size_t, std::size_t> subscriberWindow(AcquisitionMode mode, const TimeDomainContext& context, const PolledDataSet& polled) noexcept {
+        const std::size_t nSamples = polled.dataSet.axisValues(0).size();
+        std::size_t       first    = 0UZ;
+        std::size_t       count    = nSamples;
+        if (mode == AcquisitionMode::Triggered) {
+            // the poller waits for all post samples, but the pre samples are clamped to the history available when the trigger arrived
+            const std::size_t trigger = nSamples - std::min(polled.postSamples, nSamples);
+            first                     = trigger - std::min(trigger, static_cast<std::size_t>(std::max(context.preSamples, 0)));
+            count                     = trigger - first + static_cast<std::size_t>(std::max(context.postSamples, 0));
+        } else if (mode == AcquisitionMode::Multiplexed) {
+            count = static_cast<std::size_t>(std::max(context.maximumWindowSize, 0));
+        }
+        first = std::min(first, nSamples);
+        return {first, std::min(count, nSamples - first)};
+    }
+};
+
+/// server-side reduction of an update to one bucket per `factor` samples (TimeDomainContext::decimation/targetPoints/decimationMode),
+/// so that overview displays do not receive every sample while peaks stay visible in the min/max envelope
+struct Decimation {
+    enum class Mode {
+        MinMax, ///< the minimum and maximum of each bucket, in their temporal order, at the first and last time of the bucket
+        Min,
+        Max,
+        Mean
+    };
+
+    std::size_t factor = 1UZ;
+    Mode        mode   = Mode::MinMax;
+
+    [[nodiscard]] bool        active() const noexcept { return factor > 1UZ; }
+    [[nodiscard]] std::size_t pointsPerBucket() const noexcept { return mode == Mode::MinMax ? 2UZ : 1UZ; }
+
+    /// `windowSize` is the number of samples of a triggered/multiplexed/snapshot/dataset update, targetPoints is ignored if 0 (streaming
+    /// updates apply it per update via forWindow())
+    static Decimation fromContext(const TimeDomainContext& context, std::size_t windowSize = 0UZ) {
+        const Decimation decimation{.factor = static_cast<std::size_t>(std::max(context.decimation, 1)), .mode = detail::convertToEnum<Mode>(context.decimationMode)};
+        return decimation.forWindow(context.targetPoints, windowSize);
+    }
+
+    /// increases the factor such that a window of `windowSize` samples results in at most `targetPoints` points (no-op if either is 0)
+    [[nodiscard]] Decimation forWindow(std::int32_t targetPoints, std::size_t windowSize) const {
+        Decimation decimation = *this;
+        if (targetPoints > 0 && windowSize > 0) {
+            const auto maxBuckets = std::max(static_cast<std::size_t>(targetPoints) / pointsPerBucket(), 1UZ);
+            decimation.factor     = std::max(factor, (windowSize + maxBuckets - 1UZ) / maxBuckets);
+        }
+        return decimation;
+    }
+
+    /// replaces the N x M values (and errors, time axis and trigger indices) of the reply by their decimated counterparts,
+    /// the replaced buffers are handed to `pool` if given
+    void apply(Acquisition& reply, detail::BufferPool<float>* pool = nullptr) const {
+        const auto nSignals = static_cast<std::size_t>(reply.channelValues.n(0));
+        const auto nSamples = static_cast<std::size_t>(reply.channelValues.n(1));
+        if (!active() || nSamples == 0UZ) {
+            return;
+        }
+        const std::size_t nBuckets  = (nSamples + factor - 1UZ) / factor;
+        const std::size_t nOut      = nBuckets * pointsPerBucket();
+        const bool        hasErrors = !reply.channelErrors.elements().empty();
+
+        auto acquire = [pool] { return pool != nullptr ? pool->acquire() : std::vector<float>{}; };
+        auto release = [pool](std::vector<float>&& buffer) {
+            if (pool != nullptr) {
+                pool->release(std::move(buffer));
+            }
+        };
+
+        auto values = acquire();
+        auto errors = acquire();
+        values.resize(nSignals * nOut);
+        errors.resize(hasErrors ? nSignals * nOut : 0UZ);
+        for (std::size_t signal = 0; signal < nSignals; ++signal) {
+            const auto inValues = std::span(reply.channelValues.elements()).subspan(signal * nSamples, nSamples);
+            const auto inErrors = hasErrors ? std::span(reply.channelErrors.elements()).subspan(signal * nSamples, nSamples) : std::span<float>{};
+            auto       out      = signal * nOut;
+            for (std::size_t begin = 0; begin < nSamples; begin += factor) {
+                const auto bucket = inValues.subspan(begin, std::min(factor, nSamples - begin));
+                auto       emit   = [&](std::size_t index, float value) {
+                    values[out] = value;
+                    if (hasErrors) {
+                        errors[out] = inErrors[begin + index];
+                    }
+                    ++out;
+                };
+                switch (mode) {
+                case Mode::MinMax: {
+                    const auto [minIt, maxIt] = std::ranges::minmax_element(bucket);
+                    const auto first          = std::min(minIt, maxIt);
+                    const auto second         = std::max(minIt, maxIt);
+                    emit(static_cast<std::size_t>(first - bucket.begin()), *first);
+                    emit(static_cast<std::size_t>(second - bucket.begin()), *second);
+                    break;
+                }
+                case Mode::Min: {
+                    const auto minIt = std::ranges::min_element(bucket);
+                    emit(static_cast<std::size_t>(minIt - bucket.begin()), *minIt);
+                    break;
+                }
+                case Mode::Max: {
+                    const auto maxIt = std::ranges::max_element(bucket);
+                    emit(static_cast<std::size_t>(maxIt - bucket.begin()), *maxIt);
+                    break;
+                }
+                case Mode::Mean: {
+                    const double sum = std::accumulate(bucket.begin(), bucket.end(), 0.0);
+                    values[out]      = static_cast<float>(sum / static_cast<double>(bucket.size()));
+                    if (hasErrors) { // error of the mean of uncorrelated samples
+                        const auto bucketErrors = inErrors.subspan(begin, bucket.size());
+                        const auto sumSquares   = std::transform_reduce(bucketErrors.begin(), bucketErrors.end(), 0.0, std::plus<>(), [](float e) { return static_cast<double>(e) * static_cast<double>(e); });
+                        errors[out]             = static_cast<float>(std::sqrt(sumSquares) / static_cast<double>(bucket.size()));
+                    }
+                    ++out;
+                    break;
+                }
+                }
+            }
+        }
+
+        const std::array<uint32_t, 2> dims{static_cast<uint32_t>(nSignals), static_cast<uint32_t>(nOut)};
+        release(std::move(reply.channelValues.elements()));
+        reply.channelValues = opencmw::MultiArray<float, 2>(std::move(values), dims);
+        if (hasErrors) {
+            release(std::move(reply.channelErrors.elements()));
+            reply.channelErrors = opencmw::MultiArray<float, 2>(std::move(errors), dims);
+        } else {
+            release(std::move(errors));
+        }
+
+        if (auto& timeAxis = reply.channelTimeSinceRefTrigger.value(); timeAxis.size() == nSamples) {
+            auto decimatedAxis = acquire();
+            decimatedAxis.reserve(nOut);
+            for (std::size_t begin = 0; begin < nSamples; begin += factor) {
+                const float first = timeAxis[begin];
+                const float last  = timeAxis[std::min(begin + factor, nSamples) - 1UZ];
+                if (mode == Mode::MinMax) {
+                    decimatedAxis.push_back(first);
+                    decimatedAxis.push_back(last);
+                } else {
+                    decimatedAxis.push_back(0.5f * (first + last));
+                }
+            }
+            release(std::move(timeAxis));
+            timeAxis = std::move(decimatedAxis);
+        }
+
+        for (auto& index : reply.triggerIndices.value()) {
+            index = static_cast<int64_t>((static_cast<std::size_t>(index) / factor) * pointsPerBucket());
+        }
+    }
+};
+
+/// a subscription (topic) parsed once when it appears: context, mode and signal names with their resolved pollers and signal entries,
+/// rebuilt only when the subscription set or the flow graph changes (the resolved iterators/pointers are invalidated with the graph)
+struct SubscriptionPlan {
+    struct Channel {
+        std::string                                         signalName;
+        const SignalEntry*                                  signalEntry = nullptr; // Continuous, nullptr if the graph has no such signal
+        std::map<PollerKey, StreamingPollerEntry>::iterator streamingPoller;       // Continuous
+        StreamingSubscriptionState::PendingSignal*          pending = nullptr;     // Continuous, shared by channels listed twice
+        std::map<PollerKey, DataSetPollerEntry>::iterator   dataSetPoller;         // all other modes
+    };
+
+    TimeDomainContext          context;
+    AcquisitionMode            mode       = AcquisitionMode::Continuous;
+    bool                       binaryTags = false; // context.tagEncoding
+    Decimation                 decimation;
+    std::chrono::nanoseconds   minUpdateInterval = 0ns;
+    std::vector<Channel>       channels;
+    StreamingSubscriptionState streaming; // Continuous
+};
+
+/// the subscription plans by topic: a plan is built once when its topic appears and erased when the topic is gone, so a changed
+/// subscription (i.e. a new topic) gets a new plan. A subscription whose plan cannot be built is kept as rejected until it is gone
+template<typename TPlan>
+class SubscriptionPlanCache {
+    std::map<std::string, std::optional<TPlan>, std::less<>> _plans; // nullopt: invalid subscription, rejected once
+    std::set<std::string, std::less<>>                       _seenTopics;
+
+public:
+    /// starts a pass over the active subscriptions, plans of topics not looked up until endUpdate() are erased
+    void beginUpdate() { _seenTopics.clear(); }
+
+    /// the plan of `topic`, built by `makePlan()` if the topic is new, nullptr if the subscription was rejected.
+    /// An exception thrown by makePlan() is passed on and rejects the subscription
+    template<std::invocable TMakePlan>
+    TPlan* find(std::string_view topic, TMakePlan&& makePlan) {
+        _seenTopics.emplace(topic);
+        auto [planIt, isNewTopic] = _plans.try_emplace(std::string(topic));
+        if (isNewTopic) {
+            planIt->second = std::forward<TMakePlan>(makePlan)();
+        }
+        return planIt->second ? &*planIt->second : nullptr;
+    }
+
+    void endUpdate() {
+        std::erase_if(_plans, [this](const auto& topicAndPlan) { return !_seenTopics.contains(topicAndPlan.first); });
+    }
+
+    /// drops all plans, e.g. when the flow graph (and with it the resolved pollers) is replaced
+    void clear() { _plans.clear(); }
+
+    [[nodiscard]] std::size_t size() const noexcept { return _plans.size(); }
+
+    /// the valid plans
+    [[nodiscard]] auto plans() {
+        return _plans | std::views::values | std::views::filter([](const auto& plan) { return plan.has_value(); }) | std::views::transform([](auto& plan) -> TPlan& { return *plan; });
+    }
 };
 
 template<units::basic_fixed_string serviceName, typename... Meta>
@@ -330,23 +889,39 @@ class GnuRadioAcquisitionWorker : public Worker<serviceName, TimeDomainContext,
     gr::PluginLoader*                             _pluginLoader;
     std::jthread                                  _notifyThread;
     std::function<void(std::vector<SignalEntry>)> _updateSignalEntriesCallback;
+    std::mutex                                    _updateSignalEntriesCallbackMutex; // held while the callback runs
     std::unique_ptr<MsgPortOut>                   _messagesToScheduler;
     std::unique_ptr<MsgPortIn>                    _messagesFromScheduler;
+    NotifyMode                                    _notifyMode;
+    std::mutex                                    _wakeUpMutex;
+    std::condition_variable_any                   _wakeUpCondition;
+    std::uint64_t                                 _wakeUpSequence = 0;
+
+    struct PendingGraphChange {
+        gr::meta::indirect<gr::Graph> graph;
+        gr::property_map              schedulerSection;
+    };
 
-    std::optional<gr::meta::indirect<gr::Graph>>                                           _pendingFlowGraph;
-    std::unique_ptr<scheduler::Simple<scheduler::ExecutionPolicy::singleThreadedBlocking>> _scheduler;
-    std::mutex                                                                             _graphChangeMutex;
+    SchedulerConfig                         _schedulerConfig; ///< defaults for graphs without a `scheduler:` section
+    std::optional<PendingGraphChange>       _pendingFlowGraph;
+    std::unique_ptr<detail::SchedulerModel> _scheduler;
+    std::mutex                              _graphChangeMutex;
 
 public:
     using super_t = Worker<serviceName, TimeDomainContext, Empty, Acquisition, Meta...>;
 
-    explicit GnuRadioAcquisitionWorker(opencmw::URI<opencmw::STRICT> brokerAddress, const opencmw::zmq::Context& context, gr::PluginLoader* pluginLoader, std::chrono::milliseconds rate, Settings settings = {}) : super_t(std::move(brokerAddress), {}, context, std::move(settings)), _pluginLoader(pluginLoader) {
+    /// NotifyMode::EventDriven: minimum time between two notify passes triggered by graph progress (at most 200 passes per second)
+    static constexpr std::chrono::milliseconds kMinEventInterval{5};
+
+    explicit GnuRadioAcquisitionWorker(opencmw::URI<opencmw::STRICT> brokerAddress, const opencmw::zmq::Context& context, gr::PluginLoader* pluginLoader, std::chrono::milliseconds rate, Settings settings = {}, NotifyMode notifyMode = NotifyMode::Polling, SchedulerConfig schedulerConfig = {}) //
+        : super_t(std::move(brokerAddress), {}, context, std::move(settings)), _pluginLoader(pluginLoader), _notifyMode(notifyMode), _schedulerConfig(std::move(schedulerConfig)) {
         // TODO would be useful if one can check if the external broker knows TimeDomainContext and throw an error if not
         init(rate);
     }
 
     template<typename BrokerType>
-    explicit GnuRadioAcquisitionWorker(BrokerType& broker, gr::PluginLoader* pluginLoader, std::chrono::milliseconds rate) : super_t(broker, {}), _pluginLoader(pluginLoader) {
+    explicit GnuRadioAcquisitionWorker(BrokerType& broker, gr::PluginLoader* pluginLoader, std::chrono::milliseconds rate, NotifyMode notifyMode = NotifyMode::Polling, SchedulerConfig schedulerConfig = {}) //
+        : super_t(broker, {}), _pluginLoader(pluginLoader), _notifyMode(notifyMode), _schedulerConfig(std::move(schedulerConfig)) {
         // this makes sure the subscriptions are filtered correctly
         opencmw::query::registerTypes(TimeDomainContext(), broker);
         init(rate);
@@ -357,15 +932,26 @@ public:
         _notifyThread.join();
     }
 
-    void scheduleGraphChange(gr::meta::indirect<gr::Graph> fg) {
-        std::lock_guard lg{_graphChangeMutex};
-        _pendingFlowGraph = std::move(fg);
+    /// `schedulerSection` is the `scheduler:` section of the graph's GRC, its entries override the default SchedulerConfig for this graph
+    void scheduleGraphChange(gr::meta::indirect<gr::Graph> fg, gr::property_map schedulerSection = {}) {
+        {
+            std::lock_guard lg{_graphChangeMutex};
+            _pendingFlowGraph = PendingGraphChange{std::move(fg), std::move(schedulerSection)};
+        }
+        wakeUp();
     }
 
+    [[nodiscard]] NotifyMode notifyMode() const noexcept { return _notifyMode; }
+
     gr::MsgPortOut& messagesToScheduler() { return *_messagesToScheduler; }
     gr::MsgPortIn&  messagesFromScheduler() { return *_messagesFromScheduler; }
 
-    void setUpdateSignalEntriesCallback(std::function<void(std::vector<SignalEntry>)> callback) { _updateSignalEntriesCallback = std::move(callback); }
+    /// the callback runs on the notify thread, also from the destructor with an empty list; replacing it (e.g. with `{}` before
+    /// the objects it captures go away) waits for a running invocation to return
+    void setUpdateSignalEntriesCallback(std::function<void(std::vector<SignalEntry>)> callback) {
+        std::lock_guard lock(_updateSignalEntriesCallbackMutex);
+        _updateSignalEntriesCallback = std::move(callback);
+    }
 
     template<typename Fn, typename Ret = std::invoke_result_t<Fn, gr::Graph&>>
     std::optional<Ret> withGraph(Fn fn) {
@@ -378,18 +964,85 @@ public:
     }
 
 private:
+    void updateSignalEntries(std::vector<SignalEntry> entries) {
+        std::lock_guard lock(_updateSignalEntriesCallbackMutex);
+        if (_updateSignalEntriesCallback) {
+            _updateSignalEntriesCallback(std::move(entries));
+        }
+    }
+
+    void wakeUp() {
+        {
+            std::lock_guard lg{_wakeUpMutex};
+            ++_wakeUpSequence;
+        }
+        _wakeUpCondition.notify_all();
+    }
+
+    /// blocks until wakeUp() was called since `lastSequence`, the stop token is triggered or `timeout` expired
+    void waitForWakeUp(const std::stop_token& stoken, std::uint64_t& lastSequence, std::optional<std::chrono::milliseconds> timeout) {
+        std::unique_lock lock{_wakeUpMutex};
+        const auto       woken = [this, &lastSequence] { return _wakeUpSequence != lastSequence; };
+        if (timeout) {
+            std::ignore = _wakeUpCondition.wait_for(lock, stoken, *timeout, woken);
+        } else {
+            std::ignore = _wakeUpCondition.wait(lock, stoken, woken);
+        }
+        lastSequence = _wakeUpSequence;
+    }
+
+    /// time until the earliest update held back by a subscription's maxClientUpdateFrequencyFilter is due, at most `rate`
+    static std::chrono::milliseconds wakeUpTimeout(SubscriptionPlanCache<SubscriptionPlan>& subscriptionPlans, std::chrono::milliseconds rate) {
+        const auto now     = std::chrono::steady_clock::now();
+        auto       timeout = rate;
+        for (const auto& plan : subscriptionPlans.plans()) {
+            if (plan.mode != AcquisitionMode::Continuous) {
+                continue;
+            }
+            if (const auto due = plan.streaming.heldBackUntil(plan.minUpdateInterval, now)) {
+                timeout = std::min(timeout, std::chrono::ceil<std::chrono::milliseconds>(*due - now));
+            }
+        }
+        return timeout;
+    }
+
+    /// mirrors the UI Scheduler's frame pacer: blocks on the graph progress counter and forwards changes as wake-ups to the notify thread,
+    /// changes within kMinEventInterval of the previous wake-up are coalesced so that a busy graph does not spin the notify loop
+    std::jthread startProgressWatcher(gr::Graph& graph) {
+        return std::jthread([this, &graph](const std::stop_token& stoken) {
+            std::size_t oldProgress = graph.progress().value();
+            auto        lastWakeUp  = std::chrono::steady_clock::time_point{};
+            while (!stoken.stop_requested()) {
+                graph.progress().wait(oldProgress);
+                if (graph.progress().value() == oldProgress) {
+                    continue;
+                }
+                std::this_thread::sleep_until(lastWakeUp + kMinEventInterval);
+                oldProgress = graph.progress().value(); // includes the changes made while waiting out the interval
+                lastWakeUp  = std::chrono::steady_clock::now();
+                wakeUp();
+            }
+        });
+    }
+
     void init(std::chrono::milliseconds rate) {
-        // TODO instead of a notify thread with polling, we could also use callbacks. This would require
-        // the ability to unregister callbacks though (RAII callback "handles" using shared_ptr/weak_ptr like it works for pollers??)
+        // In NotifyMode::EventDriven the notify thread sleeps on the graph progress counter instead of a fixed timer.
+        // Callbacks registered directly on the sinks would avoid the extra watcher thread, but require the ability to unregister
+        // callbacks (RAII callback "handles" using shared_ptr/weak_ptr like it works for pollers??)
         _notifyThread = std::jthread([this, rate](const std::stop_token& stoken) {
-            auto                                      update = std::chrono::system_clock::now();
-            std::map<PollerKey, StreamingPollerEntry> streamingPollers;
-            std::map<PollerKey, DataSetPollerEntry>   dataSetPollers;
-            std::jthread                              schedulerThread;
-            std::string                               schedulerUniqueName;
-            std::map<std::string, SignalEntry>        signalEntryBySink;
-            std::unique_ptr<MsgPortOut>               toScheduler;
-            std::unique_ptr<MsgPortIn>                fromScheduler;
+            auto                                                   update       = std::chrono::system_clock::now();
+            std::uint64_t                                          wakeSequence = 0;
+            std::map<PollerKey, StreamingPollerEntry>              streamingPollers;
+            std::map<PollerKey, DataSetPollerEntry>                dataSetPollers;
+            SubscriptionPlanCache<SubscriptionPlan>                subscriptionPlans;
+            std::jthread                                           schedulerThread;
+            std::jthread                                           progressWatcher;
+            std::optional<SchedulerConfig>                         poolConfig; // threads and affinity of the CPU pool replaced by this worker, nullopt: default pool
+            CpuPoolPtr                                             servicePool; // default CPU pool before this worker replaced it, restored when no longer needed
+            std::string                                            schedulerUniqueName;
+            std::map<std::string, SignalEntry>                     signalEntryBySink;
+            std::unique_ptr<MsgPortOut>                            toScheduler;
+            std::unique_ptr<MsgPortIn>                             fromScheduler;
 
             bool finished = false;
 
@@ -472,37 +1125,50 @@ private:
 
                     std::ignore = messages.consume(messages.size());
 
-                    if (signalInfoChanged && _updateSignalEntriesCallback) {
+                    if (signalInfoChanged) {
+                        for (auto& plan : subscriptionPlans.plans()) { // signal names may have been changed via settings
+                            for (auto& channel : plan.channels) {
+                                channel.signalEntry = detail::findSignalEntryByName(signalEntryBySink, channel.signalName, SignalType::Plain);
+                            }
+                        }
                         auto entries = signalEntryBySink | std::views::values;
-                        _updateSignalEntriesCallback(std::vector(entries.begin(), entries.end()));
+                        updateSignalEntries(std::vector(entries.begin(), entries.end()));
                     }
 
                     bool pollersFinished = true;
                     do {
-                        pollersFinished = handleSubscriptions(streamingPollers, dataSetPollers, signalEntryBySink);
+                        pollersFinished = handleSubscriptions(streamingPollers, dataSetPollers, subscriptionPlans, signalEntryBySink, stopScheduler);
                     } while (stopScheduler && !pollersFinished);
                 }
 
                 if (stopScheduler || schedulerFinished) {
-                    if (_updateSignalEntriesCallback) {
-                        _updateSignalEntriesCallback({});
-                    }
+                    updateSignalEntries({});
                     signalEntryBySink.clear();
                     streamingPollers.clear();
                     dataSetPollers.clear();
+                    subscriptionPlans.clear();
                     _messagesFromScheduler.reset();
                     _messagesToScheduler.reset();
                     schedulerUniqueName.clear();
+                    if (progressWatcher.joinable()) {
+                        progressWatcher.request_stop();
+                        _scheduler->graph()._progress->incrementAndGet(); // wake the blocked wait
+                        progressWatcher.join();
+                    }
                     schedulerThread.join();
                 }
 
                 if (aboutToFinish) {
+                    if (poolConfig) { // the scheduler has been joined above, hand the process-wide pool back
+                        restoreCpuPool(std::exchange(servicePool, {}));
+                        poolConfig.reset();
+                    }
                     finished = true;
                     continue;
                 }
 
                 if (pendingFlowGraph.has_value()) {
-                    gr::graph::forEachBlock<gr::block::Category::NormalBlock>(*pendingFlowGraph.value(), [&signalEntryBySink](const auto& block) {
+                    gr::graph::forEachBlock<gr::block::Category::NormalBlock>(*pendingFlowGraph->graph, [&signalEntryBySink](const auto& block) {
                         if (block->typeName().starts_with("gr::basic::DataSink")) {
                             SignalEntry& entry = signalEntryBySink[std::string(block->uniqueName())];
                             entry.type         = SignalType::Plain;
@@ -519,20 +1185,36 @@ private:
                             entry.sample_rate  = detail::getSetting<float>(block, "sample_rate");
                         }
                     });
-                    if (_updateSignalEntriesCallback) {
-                        auto entries = signalEntryBySink | std::views::values;
-                        _updateSignalEntriesCallback(std::vector(entries.begin(), entries.end()));
+                    auto entries = signalEntryBySink | std::views::values;
+                    updateSignalEntries(std::vector(entries.begin(), entries.end()));
+
+                    const auto schedulerConfig = [this, &pendingFlowGraph] {
+                        try {
+                            return _schedulerConfig.withOverrides(pendingFlowGraph->schedulerSection);
+                        } catch (const std::invalid_argument& e) {
+                            std::println(std::cerr, "Ignoring scheduler section of the flow graph: {}", e.what());
+                            return _schedulerConfig;
+                        }
+                    }();
+                    // the previous scheduler has been joined above, so the pool is idle and can be replaced. The service's pool is kept
+                    // aside while a graph configures threads or CPUs and restored for the next graph that does not (or on shutdown)
+                    const bool customPool = schedulerConfig.customPool();
+                    if (customPool && (!poolConfig || poolConfig->threads != schedulerConfig.threads || poolConfig->cpuAffinity != schedulerConfig.cpuAffinity)) {
+                        auto replaced = applyCpuPool(schedulerConfig);
+                        if (!poolConfig) {
+                            servicePool = std::move(replaced); // otherwise `replaced` is the pool of the previous graph and dropped
+                        }
+                        poolConfig = schedulerConfig;
+                    } else if (!customPool && poolConfig) {
+                        restoreCpuPool(std::exchange(servicePool, {}));
+                        poolConfig.reset();
                     }
 
-                    _scheduler = std::make_unique<scheduler::Simple<scheduler::ExecutionPolicy::singleThreadedBlocking>>();
-
-                    // We do not need the old empty graph
-                    std::ignore            = _scheduler->exchange(std::move(*pendingFlowGraph.value()));
+                    _scheduler             = detail::makeScheduler(schedulerConfig.policy, std::move(*pendingFlowGraph->graph));
                     _messagesToScheduler   = std::make_unique<MsgPortOut>();
                     _messagesFromScheduler = std::make_unique<MsgPortIn>();
-                    std::ignore            = _messagesToScheduler->connect(_scheduler->msgIn);
-                    std::ignore            = _scheduler->msgOut.connect(*_messagesFromScheduler);
-                    schedulerUniqueName    = _scheduler->unique_name;
+                    std::ignore            = _scheduler->connect(*_messagesToScheduler, *_messagesFromScheduler);
+                    schedulerUniqueName    = _scheduler->uniqueName();
                     sendMessage<Subscribe>(*_messagesToScheduler, schedulerUniqueName, block::property::kLifeCycleState, {}, "GnuRadioWorker");
                     sendMessage<Subscribe>(*_messagesToScheduler, "", block::property::kSetting, {}, "GnuRadioWorker");
                     // make sure that we once get all the updated sink settings
@@ -545,9 +1227,19 @@ private:
                     {
                         std::lock_guard lg{_graphChangeMutex};
                         schedulerThread = std::jthread([scheduler = _scheduler.get()] { scheduler->runAndWait(); });
+                        if (_notifyMode == NotifyMode::EventDriven) {
+                            progressWatcher = startProgressWatcher(_scheduler->graph());
+                        }
                     }
                 }
 
+                if (_notifyMode == NotifyMode::EventDriven) {
+                    // without a running graph there is nothing to wait for but a graph change or stop request, otherwise wake up
+                    // in time for data held back by a subscription's rate limit, a quiet graph does not report progress for it
+                    waitForWakeUp(stoken, wakeSequence, schedulerThread.joinable() ? std::optional{wakeUpTimeout(subscriptionPlans, rate)} : std::nullopt);
+                    continue;
+                }
+
                 const auto next_update = update + rate;
                 const auto now         = std::chrono::system_clock::now();
                 if (now < next_update) {
@@ -558,30 +1250,95 @@ private:
         });
     }
 
-    bool handleSubscriptions(std::map<PollerKey, StreamingPollerEntry>& streamingPollers, std::map<PollerKey, DataSetPollerEntry>& dataSetPollers, const std::map<std::string, SignalEntry>& signalEntryBySink) {
-        bool pollersFinished = true;
+    bool handleSubscriptions(std::map<PollerKey, StreamingPollerEntry>& streamingPollers, std::map<PollerKey, DataSetPollerEntry>& dataSetPollers, SubscriptionPlanCache<SubscriptionPlan>& subscriptionPlans, //
+        const std::map<std::string, SignalEntry>& signalEntryBySink, bool flush) {
+        bool       pollersFinished = true;
+        const auto now             = std::chrono::steady_clock::now();
+        for (auto& entry : streamingPollers | std::views::values) {
+            entry.drained = false;
+        }
+        for (auto& entry : dataSetPollers | std::views::values) {
+            entry.drained = false;
+        }
+
+        struct DueStreamingPlan {
+            std::string       topic;
+            SubscriptionPlan* plan;
+            bool              flush;
+        };
+        std::vector<DueStreamingPlan> dueStreamingPlans;
+        subscriptionPlans.beginUpdate();
         for (const auto& subscription : super_t::activeSubscriptions()) {
-            const auto filterIn = opencmw::query::deserialise<TimeDomainContext>(subscription.params());
+            const auto topic = std::string(subscription.toZmqTopic());
             try {
-                const auto acquisitionMode = detail::convertToEnum<AcquisitionMode>(filterIn.acquisitionModeFilter);
-                for (std::string_view signalName : filterIn.channelNameFilter | std::ranges::views::split(',') | std::ranges::views::transform([](const auto&& r) { return std::string_view{&*r.begin(), static_cast<std::size_t>(std::ranges::distance(r))}; })) {
-                    if (acquisitionMode == AcquisitionMode::Continuous) {
-                        if (!handleStreamingSubscription(streamingPollers, signalEntryBySink, filterIn, signalName)) {
-                            pollersFinished = false;
+                auto* planPtr = subscriptionPlans.find(topic, [&] { return makeSubscriptionPlan(subscription.params(), streamingPollers, dataSetPollers, signalEntryBySink); });
+                if (planPtr == nullptr) {
+                    continue;
+                }
+                auto& plan = *planPtr;
+                if (plan.mode == AcquisitionMode::Continuous) {
+                    bool subscriptionFinished = true;
+                    for (auto& channel : plan.channels) {
+                        if (!collectStreamingData(channel)) {
+                            subscriptionFinished = false;
                         }
-                    } else {
-                        if (!handleDataSetSubscription(dataSetPollers, filterIn, acquisitionMode, signalName)) {
+                    }
+                    pollersFinished = pollersFinished && subscriptionFinished;
+                    if (flush || subscriptionFinished || now - plan.streaming.lastNotify >= plan.minUpdateInterval) {
+                        dueStreamingPlans.push_back(DueStreamingPlan{.topic = topic, .plan = &plan, .flush = flush || subscriptionFinished});
+                    }
+                } else {
+                    for (auto& channel : plan.channels) {
+                        if (!handleDataSetSubscription(plan, channel)) {
                             pollersFinished = false;
                         }
                     }
                 }
             } catch (const std::exception& e) {
-                std::println(std::cerr, "Could not handle subscription {}: {}", subscription.toZmqTopic(), e.what());
+                std::println(std::cerr, "Could not handle subscription {}: {}", topic, e.what());
             }
         }
+
+        // the pending data of the subscriptions is the only owner of this tick's chunks now, a single subscriber can move them into its reply
+        for (auto& entry : streamingPollers | std::views::values) {
+            entry.tickChunk.reset();
+        }
+        for (const auto& [topic, plan, flushPlan] : dueStreamingPlans) {
+            try {
+                notifyStreamingSubscription(*plan, now, flushPlan);
+            } catch (const std::exception& e) {
+                std::println(std::cerr, "Could not handle subscription {}: {}", topic, e.what());
+            }
+        }
+        subscriptionPlans.endUpdate();
         return pollersFinished;
     }
 
+    /// parses the subscription and resolves its pollers, throws if the context is invalid
+    SubscriptionPlan makeSubscriptionPlan(const auto& params, std::map<PollerKey, StreamingPollerEntry>& streamingPollers, std::map<PollerKey, DataSetPollerEntry>& dataSetPollers, const std::map<std::string, SignalEntry>& signalEntryBySink) {
+        SubscriptionPlan plan;
+        plan.context           = opencmw::query::deserialise<TimeDomainContext>(params);
+        plan.mode              = detail::convertToEnum<AcquisitionMode>(plan.context.acquisitionModeFilter);
+        plan.binaryTags        = detail::convertToEnum<tag_encoding::Format>(plan.context.tagEncoding) == tag_encoding::Format::Binary;
+        plan.decimation        = Decimation::fromContext(plan.context);
+        plan.minUpdateInterval = StreamingSubscriptionState::minUpdateInterval(plan.context);
+        for (const auto& signalNameRange : plan.context.channelNameFilter | std::ranges::views::split(',')) {
+            std::string signalName(signalNameRange.begin(), signalNameRange.end());
+            if (plan.mode == AcquisitionMode::Continuous && plan.streaming.pendingBySignal.contains(signalName)) {
+                continue; // channel listed twice, it must not be drained into the pending data twice
+            }
+            auto& channel = plan.channels.emplace_back(SubscriptionPlan::Channel{.signalName = std::move(signalName)});
+            if (plan.mode == AcquisitionMode::Continuous) {
+                channel.signalEntry     = detail::findSignalEntryByName(signalEntryBySink, channel.signalName, SignalType::Plain);
+                channel.streamingPoller = getStreamingPoller(streamingPollers, channel.signalName);
+                channel.pending         = &plan.streaming.pendingBySignal[channel.signalName];
+            } else {
+                channel.dataSetPoller = getDataSetPoller(dataSetPollers, plan.context, plan.mode, channel.signalName);
+            }
+        }
+        return plan;
+    }
+
     auto getStreamingPoller(std::map<PollerKey, StreamingPollerEntry>& pollers, std::string_view signalName, std::size_t minRequiredSamples = 40, std::size_t maxRequiredSamples = std::numeric_limits<std::size_t>::max()) {
         const auto key = PollerKey{.mode = AcquisitionMode::Continuous, .signal_name = std::string(signalName)};
 
@@ -593,228 +1350,345 @@ private:
         return pollerIt;
     }
 
-    bool handleStreamingSubscription(std::map<PollerKey, StreamingPollerEntry>& pollers, const std::map<std::string, SignalEntry>& signalEntryBySink, const TimeDomainContext& context, std::string_view signalName) {
-        auto pollerIt = getStreamingPoller(pollers, signalName);
-        if (pollerIt == pollers.end()) { // flushing, do not create new pollers
+    /// drains the signal's poller once per tick into a chunk and appends it to the subscription's pending data, returns whether the poller was finished
+    bool collectStreamingData(SubscriptionPlan::Channel& channel) {
+        auto& pollerEntry = channel.streamingPoller->second;
+        if (pollerEntry.poller == nullptr) {
             return true;
         }
 
-        auto& pollerEntry = pollerIt->second;
-        if (const auto* entry = detail::findSignalEntryByName(signalEntryBySink, signalName, SignalType::Plain)) {
-            pollerEntry.populateFromSignalEntry(*entry);
+        if (!pollerEntry.drained) {
+            if (channel.signalEntry != nullptr) {
+                pollerEntry.populateFromSignalEntry(*channel.signalEntry);
+            }
+            pollerEntry.drained     = true;
+            pollerEntry.wasFinished = pollerEntry.poller->finished.load();
+            // the only copy of the samples: the poller releases its buffer when process() returns
+            auto chunk     = std::make_shared<StreamingChunk>();
+            chunk->samples = pollerEntry.bufferPool.acquire();
+            std::ignore    = pollerEntry.poller->process([&pollerEntry, &chunk](std::span<const StreamingPollerEntry::SampleType> data, std::span<const gr::Tag> tags) {
+                auto errors = pollerEntry.populateFromTags(tags);
+                pollerEntry.timingEventState.updateFromTags(tags);
+                const auto offset = chunk->samples.size();
+                chunk->samples.insert(chunk->samples.end(), data.begin(), data.end());
+                for (const auto& tag : tags) {
+                    chunk->tags.push_back(gr::Tag{tag.index + offset, tag.map});
+                }
+                chunk->errors.insert(chunk->errors.end(), std::make_move_iterator(errors.begin()), std::make_move_iterator(errors.end()));
+            });
+            if (chunk->samples.empty()) {
+                pollerEntry.bufferPool.release(std::move(chunk->samples));
+            }
+            pollerEntry.tickChunk = std::move(chunk);
         }
 
-        if (pollerEntry.poller == nullptr) {
-            return true;
+        channel.pending->append(pollerEntry.tickChunk);
+        return pollerEntry.wasFinished;
+    }
+
+    struct ReplyChannel {
+        StreamingPollerEntry*                      pollerEntry;
+        std::string_view                           signalName;
+        StreamingSubscriptionState::PendingSignal* pending;
+    };
+
+    /// sends the pending data of the subscription: channels with the same sample rate are packed into one N x M Acquisition sharing one time axis,
+    /// M being the number of samples available on all of them (rounded down to whole decimation buckets); the remainder stays pending unless `flush`
+    /// is set or the channels drifted too far apart
+    void notifyStreamingSubscription(SubscriptionPlan& plan, std::chrono::steady_clock::time_point now, bool flush) {
+        const auto&                            decimation = plan.decimation;
+        std::vector<std::vector<ReplyChannel>> groups; // by sample rate, in channelNameFilter order
+        for (const auto& planChannel : plan.channels) {
+            const ReplyChannel channel{.pollerEntry = &planChannel.streamingPoller->second, .signalName = planChannel.signalName, .pending = planChannel.pending};
+            auto               groupIt = std::ranges::find_if(groups, [&channel](const auto& group) { return group.front().pollerEntry->sample_rate == channel.pollerEntry->sample_rate; });
+            if (groupIt == groups.end()) {
+                groups.push_back({channel});
+            } else if (std::ranges::none_of(*groupIt, [&channel](const auto& c) { return c.pending == channel.pending; })) { // channel listed twice
+                groupIt->push_back(channel);
+            }
         }
-        Acquisition reply;
 
-        auto processData = [&reply, signalName, &pollerEntry](std::span<const StreamingPollerEntry::SampleType> data, std::span<const gr::Tag> tags) {
-            std::vector<std::string> errors = pollerEntry.populateFromTags(tags);
-            pollerEntry.timingEventState.updateFromTags(tags);
-            reply.refTriggerName    = "NO_REF_TRIGGER";
-            reply.channelNames      = {pollerEntry.signal_name.value_or(std::string(signalName))};
-            reply.channelUnits      = {pollerEntry.signal_unit.value_or("N/A")};
-            reply.channelQuantities = {pollerEntry.signal_quantity.value_or("N/A")};
-            reply.channelRangeMin   = {pollerEntry.signal_min ? static_cast<float>(*pollerEntry.signal_min) : std::numeric_limits<float>::lowest()};
-            reply.channelRangeMax   = {pollerEntry.signal_max ? static_cast<float>(*pollerEntry.signal_max) : std::numeric_limits<float>::max()};
-            pollerEntry.timingEventState.applyToReply(reply);
-
-            const auto                    nSamples = static_cast<uint32_t>(data.size());
-            const std::array<uint32_t, 2> dims{1U, nSamples}; // 1 signal, N samples
-            reply.channelValues = opencmw::MultiArray<float, 2>(std::vector<float>(data.begin(), data.end()), dims);
-            reply.channelErrors = opencmw::MultiArray<float, 2>(std::vector<float>(nSamples, 0.f), dims);
-            reply.channelTimeSinceRefTrigger.resize(nSamples);
-            if (pollerEntry.sample_rate && *pollerEntry.sample_rate > 0.f) {
-                const float ts = 1.f / *pollerEntry.sample_rate;
-                for (uint32_t i = 0; i < nSamples; ++i) {
-                    reply.channelTimeSinceRefTrigger[i] = static_cast<float>(i) * ts;
+        bool notified = false;
+        for (const auto& group : groups) {
+            const auto pendingSamples  = group | std::views::transform([](const ReplyChannel& c) { return c.pending->size(); });
+            const auto nPending        = std::ranges::min(pendingSamples);
+            const auto groupDecimation = decimation.forWindow(plan.context.targetPoints, nPending); // each update has at most targetPoints points
+            const auto nAligned        = nPending / groupDecimation.factor * groupDecimation.factor;
+            if (nAligned > 0) { // the poller only publishes updates containing samples
+                notifyStreamingReply(plan, group, nAligned, groupDecimation);
+                notified = true;
+            }
+            if (flush || std::ranges::max(pendingSamples) > StreamingSubscriptionState::kMaxUnalignedSamples) {
+                for (const auto& channel : group) {
+                    if (const auto nChannel = channel.pending->size(); nChannel > 0UZ) {
+                        notifyStreamingReply(plan, std::span(&channel, 1UZ), nChannel, decimation.forWindow(plan.context.targetPoints, nChannel));
+                        notified = true;
+                    }
                 }
-            } else {
-                reply.channelTimeSinceRefTrigger.assign(nSamples, 0.f);
-                errors.push_back(std::format("Missing or invalid sample_rate metadata for signal '{}'", signalName));
             }
+        }
+        if (notified) {
+            plan.streaming.lastNotify = now;
+        }
+    }
 
-            // preallocate trigger vectors to number of tags
-            reply.triggerIndices.reserve(tags.size());
-            reply.triggerEventNames.reserve(tags.size());
-            reply.triggerTimestamps.reserve(tags.size());
-            reply.triggerOffsets.reserve(tags.size());
-            reply.triggerYamlPropertyMaps.reserve(tags.size());
-            for (auto& [idx, tagMap] : tags) {
-                if (tagMap.contains(gr::tag::TRIGGER_NAME.shortKey()) && tagMap.contains(gr::tag::TRIGGER_TIME.shortKey())) {
-                    const float Ts_ns       = pollerEntry.sample_rate && *pollerEntry.sample_rate > 0.f ? 1'000'000'000.f / *pollerEntry.sample_rate : 0.f;
-                    const auto  offset      = static_cast<int64_t>(static_cast<float>(idx) * Ts_ns);
-                    const auto  triggerTime = [&](const gr::property_map& m) { return m.find_value(gr::tag::TRIGGER_TIME.shortKey()).value_or(gr::pmt::Value{}).value_or(std::uint64_t{0}); };
-                    const auto  triggerName = [&](const gr::property_map& m) { return std::string(m.find_value(gr::tag::TRIGGER_NAME.shortKey()).value_or(gr::pmt::Value{}).value_or(std::string_view{})); };
-                    if (reply.acqLocalTimeStamp == 0) { // just take the value of the first tag. probably should correct for the tag index times samplerate
-                        reply.acqLocalTimeStamp = static_cast<int64_t>(triggerTime(tagMap)) - offset;
-                    }
-                    if (reply.refTriggerStamp == 0) { // just take the value of the first tag. probably should correct for the tag index times samplerate
-                        reply.refTriggerName  = triggerName(tagMap);
-                        reply.refTriggerStamp = cast_to_signed(triggerTime(tagMap)) - offset;
-                    }
+    void notifyStreamingReply(const SubscriptionPlan& plan, std::span<const ReplyChannel> channels, std::size_t nSamples, const Decimation& decimation) {
+        auto& bufferPool = channels.front().pollerEntry->bufferPool;
+        auto  reply      = buildStreamingReply(channels, nSamples, plan.context, plan.binaryTags, decimation.active());
+        decimation.apply(reply, &bufferPool);
+        super_t::notify(plan.context, reply);
+        // the reply is serialised, hand its buffers back for the next updates
+        bufferPool.release(std::move(reply.channelValues.elements()));
+        bufferPool.release(std::move(reply.channelErrors.elements()));
+        bufferPool.release(std::move(reply.channelTimeSinceRefTrigger.value()));
+    }
+
+    /// packs the first `nSamples` pending samples of each channel into one Acquisition and removes them from the pending data,
+    /// `explicitTimeAxis` overrides context.implicitTimeAxis (decimated updates do not have a fixed sample rate)
+    static Acquisition buildStreamingReply(std::span<const ReplyChannel> channels, std::size_t nSamples, const TimeDomainContext& context, bool binaryTags, bool explicitTimeAxis = false) {
+        Acquisition reply;
+        const auto& firstEntry = *channels.front().pollerEntry;
+        auto&       bufferPool = channels.front().pollerEntry->bufferPool;
+        const auto  nSignals   = static_cast<uint32_t>(channels.size());
+
+        reply.refTriggerName = "NO_REF_TRIGGER";
+        for (const auto& [pollerEntry, signalName, pending] : channels) {
+            reply.channelNames.push_back(pollerEntry->signal_name.value_or(std::string(signalName)));
+            reply.channelUnits.push_back(pollerEntry->signal_unit.value_or("N/A"));
+            reply.channelQuantities.push_back(pollerEntry->signal_quantity.value_or("N/A"));
+            reply.channelRangeMin.push_back(pollerEntry->signal_min ? static_cast<float>(*pollerEntry->signal_min) : std::numeric_limits<float>::lowest());
+            reply.channelRangeMax.push_back(pollerEntry->signal_max ? static_cast<float>(*pollerEntry->signal_max) : std::numeric_limits<float>::max());
+        }
+        // the timing context describes the machine, not a channel: use the most recent timing event any of the channels has seen
+        const TimingEventState* timingEventState = &firstEntry.timingEventState;
+        for (const auto& channel : channels) {
+            timingEventState = &TimingEventState::mostRecent(*timingEventState, channel.pollerEntry->timingEventState);
+        }
+        timingEventState->applyToReply(reply);
+
+        // MultiArray stores internally elements as stride 1D array: <values_signal_1><values_signal_2><values_signal_3>
+        const std::array<uint32_t, 2> dims{nSignals, static_cast<uint32_t>(nSamples)};
+        if (nSignals == 1) {
+            reply.channelValues = opencmw::MultiArray<float, 2>(channels.front().pending->takeFront(nSamples, bufferPool), dims);
+        } else {
+            auto values = bufferPool.acquire();
+            values.reserve(nSignals * nSamples);
+            for (const auto& channel : channels) {
+                channel.pending->copyFront(nSamples, values);
+            }
+            reply.channelValues = opencmw::MultiArray<float, 2>(std::move(values), dims);
+        }
+        if (!context.noErrors) {
+            auto channelErrors = bufferPool.acquire();
+            channelErrors.assign(nSignals * nSamples, 0.f);
+            reply.channelErrors = opencmw::MultiArray<float, 2>(std::move(channelErrors), dims);
+        }
+
+        // all channels share the sample rate (grouped by the caller)
+        std::vector<std::string> errors;
+        const bool               hasSampleRate = firstEntry.sample_rate && *firstEntry.sample_rate > 0.f;
+        if (!context.implicitTimeAxis || explicitTimeAxis) {
+            auto timeAxis = bufferPool.acquire();
+            timeAxis.resize(nSamples, 0.f);
+            if (hasSampleRate) {
+                const float ts = 1.f / *firstEntry.sample_rate;
+                for (std::size_t i = 0; i < nSamples; ++i) {
+                    timeAxis[i] = static_cast<float>(i) * ts;
                 }
-                reply.triggerIndices.push_back(cast_to_signed(idx));
-                reply.triggerEventNames.push_back(tagMap.contains(gr::tag::TRIGGER_NAME.shortKey()) ? std::string(tagMap.find_value(gr::tag::TRIGGER_NAME.shortKey()).value_or(gr::pmt::Value{}).value_or(std::string_view{})) : ""s);
-                reply.triggerTimestamps.push_back(tagMap.contains(gr::tag::TRIGGER_TIME.shortKey()) ? static_cast<int64_t>(tagMap.find_value(gr::tag::TRIGGER_TIME.shortKey()).value_or(gr::pmt::Value{}).value_or(std::uint64_t{0})) : 0LL);
-                reply.triggerOffsets.push_back(tagMap.contains(gr::tag::TRIGGER_OFFSET.shortKey()) ? tagMap.find_value(gr::tag::TRIGGER_OFFSET.shortKey()).value_or(gr::pmt::Value{}).value_or(0.f) : 0.0f);
-                reply.triggerYamlPropertyMaps.push_back(pmt::yaml::serialize(tagMap));
             }
+            reply.channelTimeSinceRefTrigger.value() = std::move(timeAxis);
+        }
 
-            reply.triggerIndices.shrink_to_fit();
-            reply.triggerEventNames.shrink_to_fit();
-            reply.triggerTimestamps.shrink_to_fit();
-            reply.triggerOffsets.shrink_to_fit();
-            reply.triggerYamlPropertyMaps.shrink_to_fit();
-            if (!errors.empty()) {
-                reply.acqErrors = std::move(errors);
+        appendTriggers(reply, channels, nSamples, binaryTags);
+        for (const auto& [pollerEntry, signalName, pending] : channels) {
+            if (!hasSampleRate) {
+                errors.push_back(std::format("Missing or invalid sample_rate metadata for signal '{}'", signalName));
             }
-        };
+            errors.insert(errors.end(), std::make_move_iterator(pending->errors.begin()), std::make_move_iterator(pending->errors.end()));
+            pending->errors.clear();
+            pending->dropFront(nSamples, pollerEntry->bufferPool);
+        }
 
-        const auto wasFinished = pollerEntry.poller->finished.load();
-        if (pollerEntry.poller->process(processData)) {
-            super_t::notify(context, reply);
+        if (!errors.empty()) {
+            reply.acqErrors = std::move(errors);
         }
-        return wasFinished;
+        return reply;
     }
 
-    auto getDataSetPoller(std::map<PollerKey, DataSetPollerEntry>& pollers, const TimeDomainContext& context, AcquisitionMode mode, std::string_view signalName, std::size_t minRequiredSamples = 1, std::size_t maxRequiredSamples = std::numeric_limits<std::size_t>::max()) {
-        const auto key      = PollerKey{.mode = mode, .signal_name = std::string(signalName), .pre_samples = static_cast<std::size_t>(context.preSamples), .post_samples = static_cast<std::size_t>(context.postSamples), .maximum_window_size = static_cast<std::size_t>(context.maximumWindowSize), .snapshot_delay = std::chrono::nanoseconds(context.snapshotDelay)};
-        auto       pollerIt = pollers.find(key);
-        if (pollerIt == pollers.end()) {
-            using SampleType = DataSetPollerEntry::SampleType;
-            const auto query = basic::DataSinkQuery::signalName(signalName);
-            // TODO for triggered/multiplexed subscriptions that only differ in preSamples/postSamples/maximumWindowSize, we could use a single poller for the encompassing range
-            // and send snippets from their datasets to the individual subscribers
-            if (mode == AcquisitionMode::Triggered) {
-                // clang-format off
-                pollerIt = pollers.emplace(key, basic::globalDataSinkRegistry().getTriggerPoller<SampleType>(query, detail::Matcher{.filterDefinition = context.triggerNameFilter}, //
-                                                    {.minRequiredSamples = minRequiredSamples, .maxRequiredSamples = maxRequiredSamples, .preSamples = key.pre_samples, .postSamples = key.post_samples, })).first; //
-                // clang-format on
-            } else if (mode == AcquisitionMode::Snapshot) {
-                pollerIt = pollers.emplace(key, basic::globalDataSinkRegistry().getSnapshotPoller<SampleType>(query, detail::Matcher{.filterDefinition = context.triggerNameFilter}, {.minRequiredSamples = minRequiredSamples, .maxRequiredSamples = maxRequiredSamples, .delay = key.snapshot_delay})).first;
-            } else if (mode == AcquisitionMode::Multiplexed) {
-                pollerIt = pollers.emplace(key, basic::globalDataSinkRegistry().getMultiplexedPoller<SampleType>(query, detail::Matcher{.filterDefinition = context.triggerNameFilter}, {.minRequiredSamples = minRequiredSamples, .maxRequiredSamples = maxRequiredSamples, .maximumWindowSize = key.maximum_window_size})).first;
-            } else if (mode == AcquisitionMode::DataSet) {
-                pollerIt = pollers.emplace(key, basic::globalDataSinkRegistry().getDataSetPoller<SampleType>(query, {.minRequiredSamples = minRequiredSamples, .maxRequiredSamples = maxRequiredSamples})).first;
+    /// appends the pending tags with index < nSamples of all channels to the trigger vectors of the reply, ordered by sample index (and
+    /// channel for tags on the same sample), triggerChannelIndices tells which channel each of them was received on
+    static void appendTriggers(Acquisition& reply, std::span<const ReplyChannel> channels, std::size_t nSamples, bool binaryTags) {
+        struct ChannelTag {
+            std::size_t             index;
+            std::size_t             channel;
+            const gr::property_map* map;
+        };
+        std::vector<ChannelTag> tags;
+        for (std::size_t channel = 0UZ; channel < channels.size(); ++channel) {
+            channels[channel].pending->forEachTag(nSamples, [&tags, channel](std::size_t idx, const gr::property_map& tagMap) { tags.push_back({.index = idx, .channel = channel, .map = &tagMap}); });
+        }
+        std::ranges::stable_sort(tags, {}, &ChannelTag::index);
+
+        for (const auto& [idx, channel, map] : tags) {
+            const StreamingPollerEntry& pollerEntry = *channels[channel].pollerEntry;
+            const gr::property_map&     tagMap      = *map;
+            if (tagMap.contains(gr::tag::TRIGGER_NAME.shortKey()) && tagMap.contains(gr::tag::TRIGGER_TIME.shortKey())) {
+                const float Ts_ns       = pollerEntry.sample_rate && *pollerEntry.sample_rate > 0.f ? 1'000'000'000.f / *pollerEntry.sample_rate : 0.f;
+                const auto  offset      = static_cast<int64_t>(static_cast<float>(idx) * Ts_ns);
+                const auto  triggerTime = [&](const gr::property_map& m) { return m.find_value(gr::tag::TRIGGER_TIME.shortKey()).value_or(gr::pmt::Value{}).value_or(std::uint64_t{0}); };
+                const auto  triggerName = [&](const gr::property_map& m) { return std::string(m.find_value(gr::tag::TRIGGER_NAME.shortKey()).value_or(gr::pmt::Value{}).value_or(std::string_view{})); };
+                if (reply.acqLocalTimeStamp == 0) { // just take the value of the first tag. probably should correct for the tag index times samplerate
+                    reply.acqLocalTimeStamp = static_cast<int64_t>(triggerTime(tagMap)) - offset;
+                }
+                if (reply.refTriggerStamp == 0) { // just take the value of the first tag. probably should correct for the tag index times samplerate
+                    reply.refTriggerName  = triggerName(tagMap);
+                    reply.refTriggerStamp = cast_to_signed(triggerTime(tagMap)) - offset;
+                }
             }
+            reply.triggerIndices.push_back(cast_to_signed(idx));
+            reply.triggerChannelIndices.push_back(static_cast<std::int32_t>(channel));
+            reply.triggerEventNames.push_back(tagMap.contains(gr::tag::TRIGGER_NAME.shortKey()) ? std::string(tagMap.find_value(gr::tag::TRIGGER_NAME.shortKey()).value_or(gr::pmt::Value{}).value_or(std::string_view{})) : ""s);
+            reply.triggerTimestamps.push_back(tagMap.contains(gr::tag::TRIGGER_TIME.shortKey()) ? static_cast<int64_t>(tagMap.find_value(gr::tag::TRIGGER_TIME.shortKey()).value_or(gr::pmt::Value{}).value_or(std::uint64_t{0})) : 0LL);
+            reply.triggerOffsets.push_back(tagMap.contains(gr::tag::TRIGGER_OFFSET.shortKey()) ? tagMap.find_value(gr::tag::TRIGGER_OFFSET.shortKey()).value_or(gr::pmt::Value{}).value_or(0.f) : 0.0f);
+            appendPropertyMap(reply, tagMap, binaryTags);
         }
-        return pollerIt;
     }
 
-    std::vector<std::string> parseSignalNameList(std::string_view input) {
-        namespace views = std::ranges::views;
-
-        auto isNotSpace = [](char ch) { return !std::isspace(static_cast<unsigned char>(ch)); };
+    static void appendPropertyMap(Acquisition& reply, const gr::property_map& tagMap, bool binaryTags) {
+        if (binaryTags) {
+            tag_encoding::encode(tagMap, reply.triggerBinaryPropertyMaps.value());
+        } else {
+            reply.triggerYamlPropertyMaps.push_back(pmt::yaml::serialize(tagMap));
+        }
+    }
 
-        std::vector<std::string> result;
-        for (auto subRange : input | views::split(',')) {
-            std::string str(subRange.begin(), subRange.end());
+    auto getDataSetPoller(std::map<PollerKey, DataSetPollerEntry>& pollers, const TimeDomainContext& context, AcquisitionMode mode, std::string_view signalName, std::size_t minRequiredSamples = 1, std::size_t maxRequiredSamples = std::numeric_limits<std::size_t>::max()) {
+        const auto key               = PollerKey{.mode = mode, .signal_name = std::string(signalName), .trigger_filter = mode == AcquisitionMode::DataSet ? ""s : context.triggerNameFilter, .snapshot_delay = mode == AcquisitionMode::Snapshot ? std::chrono::nanoseconds(context.snapshotDelay) : 0ns};
+        const auto preSamples        = static_cast<std::size_t>(std::max(context.preSamples, 0));
+        const auto postSamples       = static_cast<std::size_t>(std::max(context.postSamples, 0));
+        const auto maximumWindowSize = static_cast<std::size_t>(std::max(context.maximumWindowSize, 0));
+
+        auto [pollerIt, inserted] = pollers.try_emplace(key);
+        auto&      entry          = pollerIt->second;
+        const bool windowGrows    = (mode == AcquisitionMode::Triggered && (preSamples > entry.pre_samples || postSamples > entry.post_samples)) || (mode == AcquisitionMode::Multiplexed && maximumWindowSize > entry.maximum_window_size);
+        if (!inserted && !windowGrows) {
+            return pollerIt;
+        }
 
-            auto lead = std::ranges::find_if(str, isNotSpace);
-            if (lead == str.end()) {
-                continue;
-            }
-            auto trailRev = std::ranges::find_if(str | views::reverse, isNotSpace);
-            result.emplace_back(lead, trailRev.base());
+        // triggered/multiplexed subscriptions that only differ in preSamples/postSamples/maximumWindowSize share a single poller for the encompassing range,
+        // the poller is replaced when a subscriber needs a wider window, the individual windows are cut out in handleDataSetSubscription()
+        auto              replacedPoller      = std::move(entry.poller);
+        const std::size_t replacedPostSamples = entry.post_samples;
+        entry.pre_samples                     = std::max(entry.pre_samples, preSamples);
+        entry.post_samples                    = std::max(entry.post_samples, postSamples);
+        entry.maximum_window_size             = std::max(entry.maximum_window_size, maximumWindowSize);
+
+        using SampleType = DataSetPollerEntry::SampleType;
+        const auto query = basic::DataSinkQuery::signalName(signalName);
+        if (mode == AcquisitionMode::Triggered) {
+            // clang-format off
+            entry.poller = basic::globalDataSinkRegistry().getTriggerPoller<SampleType>(query, detail::Matcher{.filterDefinition = context.triggerNameFilter}, //
+                                {.minRequiredSamples = minRequiredSamples, .maxRequiredSamples = maxRequiredSamples, .preSamples = entry.pre_samples, .postSamples = entry.post_samples, }); //
+            // clang-format on
+        } else if (mode == AcquisitionMode::Snapshot) {
+            entry.poller = basic::globalDataSinkRegistry().getSnapshotPoller<SampleType>(query, detail::Matcher{.filterDefinition = context.triggerNameFilter}, {.minRequiredSamples = minRequiredSamples, .maxRequiredSamples = maxRequiredSamples, .delay = key.snapshot_delay});
+        } else if (mode == AcquisitionMode::Multiplexed) {
+            entry.poller = basic::globalDataSinkRegistry().getMultiplexedPoller<SampleType>(query, detail::Matcher{.filterDefinition = context.triggerNameFilter}, {.minRequiredSamples = minRequiredSamples, .maxRequiredSamples = maxRequiredSamples, .maximumWindowSize = entry.maximum_window_size});
+        } else if (mode == AcquisitionMode::DataSet) {
+            entry.poller = basic::globalDataSinkRegistry().getDataSetPoller<SampleType>(query, {.minRequiredSamples = minRequiredSamples, .maxRequiredSamples = maxRequiredSamples});
         }
-        return result;
+        if (replacedPoller) {
+            // DataSets the replaced poller completed up to now (the new one is registered, so nothing in between is lost) go out with the next
+            // tick, cut for the narrower window, which subscriberWindow() clamps the wider windows to
+            DataSetPollerEntry::drain(*replacedPoller, replacedPostSamples, entry.replacedPollerDataSets);
+        }
+        return pollerIt;
     }
 
-    bool handleDataSetSubscription(std::map<PollerKey, DataSetPollerEntry>& pollers, const TimeDomainContext& context, AcquisitionMode mode, std::string_view signalName_) {
-        const std::string signalName(signalName_);
-        auto              pollerIt = getDataSetPoller(pollers, context, mode, signalName);
-        if (pollerIt == pollers.end()) { // flushing, do not create new pollers
+    bool handleDataSetSubscription(const SubscriptionPlan& plan, SubscriptionPlan::Channel& channel) {
+        const auto& context     = plan.context;
+        auto&       pollerEntry = channel.dataSetPoller->second;
+        if (pollerEntry.poller == nullptr) {
             return true;
         }
 
-        const auto& key         = pollerIt->first;
-        auto&       pollerEntry = pollerIt->second;
+        if (!pollerEntry.drained) {
+            pollerEntry.drained      = true;
+            pollerEntry.wasFinished  = pollerEntry.poller->finished.load();
+            pollerEntry.tickDataSets = std::exchange(pollerEntry.replacedPollerDataSets, {});
+            DataSetPollerEntry::drain(*pollerEntry.poller, pollerEntry.post_samples, pollerEntry.tickDataSets);
+        }
 
-        if (pollerEntry.poller == nullptr) {
-            return true;
+        for (const auto& polled : pollerEntry.tickDataSets) {
+            const auto [first, count] = DataSetPollerEntry::subscriberWindow(plan.mode, context, polled);
+            auto reply = buildDataSetReply(polled.dataSet, first, count, context, plan.binaryTags);
+            plan.decimation.forWindow(context.targetPoints, count).apply(reply);
+            super_t::notify(context, reply);
         }
+
+        return pollerEntry.wasFinished;
+    }
+
+    /// converts the [first, first + count) sample range of the DataSet into an Acquisition
+    static Acquisition buildDataSetReply(const gr::DataSet<DataSetPollerEntry::SampleType>& dataSet, std::size_t first, std::size_t count, const TimeDomainContext& context, bool binaryTags) {
         Acquisition reply;
-        auto        processData = [&reply, &key, signalName, &pollerEntry](std::span<const gr::DataSet<DataSetPollerEntry::SampleType>> dataSets) {
-            const auto& dataSet = dataSets[0];
-
-            if (!dataSet.timing_events.empty()) {
-                const auto [triggerName, triggerTime] = detail::findTrigger(dataSet.timing_events[0]);
-                reply.refTriggerName                  = triggerName;
-                reply.refTriggerStamp                 = static_cast<std::int64_t>(triggerTime);
-            }
-
-            const std::size_t nSignals = static_cast<uint32_t>(dataSet.size());
-            const std::size_t nSamples = static_cast<uint32_t>(dataSet.axisValues(0).size());
-
-            reply.channelNames.clear();
-            reply.channelNames.reserve(nSignals);
-            reply.channelQuantities.clear();
-            reply.channelQuantities.reserve(nSignals);
-            reply.channelUnits.clear();
-            reply.channelUnits.reserve(nSignals);
-            reply.channelRangeMin.clear();
-            reply.channelRangeMin.reserve(nSignals);
-            reply.channelRangeMax.clear();
-            reply.channelRangeMax.reserve(nSignals);
-            reply.status.clear();
-            reply.status.reserve(nSignals);
-            reply.temperature.clear();
-            reply.temperature.reserve(nSignals);
-
-            for (std::size_t i = 0; i < nSignals; i++) {
-                reply.channelNames.push_back(std::string(dataSet.signalName(i)));
-                reply.channelQuantities.push_back(std::string(dataSet.signalQuantity(i)));
-                reply.channelUnits.push_back(std::string(dataSet.signalUnit(i)));
-
-                const auto& range = dataSet.signalRange(i);
-                reply.channelRangeMin.push_back(static_cast<float>(range.min));
-                reply.channelRangeMax.push_back(static_cast<float>(range.max));
-            }
-            // MultiArray stores internally elements as stride 1D array: <values_signal_1><values_signal_2><values_signal_3>
-            std::vector<float> values;
-            values.reserve(nSignals * nSamples);
-            for (uint32_t i = 0; i < nSignals; ++i) {
-                auto span = dataSet.signalValues(i);
-                values.insert(values.end(), span.begin(), span.end());
-            }
-            reply.channelValues = opencmw::MultiArray<float, 2>(std::move(values), std::array<uint32_t, 2>{static_cast<uint32_t>(nSignals), static_cast<uint32_t>(nSamples)});
+        if (!dataSet.timing_events.empty()) {
+            const auto [triggerName, triggerTime] = detail::findTrigger(dataSet.timing_events[0]);
+            reply.refTriggerName                  = triggerName;
+            reply.refTriggerStamp                 = static_cast<std::int64_t>(triggerTime);
+        }
+
+        const std::size_t nSignals = static_cast<uint32_t>(dataSet.size());
+        const std::size_t nSamples = count;
+
+        reply.channelNames.reserve(nSignals);
+        reply.channelQuantities.reserve(nSignals);
+        reply.channelUnits.reserve(nSignals);
+        reply.channelRangeMin.reserve(nSignals);
+        reply.channelRangeMax.reserve(nSignals);
+
+        for (std::size_t i = 0; i < nSignals; i++) {
+            reply.channelNames.push_back(std::string(dataSet.signalName(i)));
+            reply.channelQuantities.push_back(std::string(dataSet.signalQuantity(i)));
+            reply.channelUnits.push_back(std::string(dataSet.signalUnit(i)));
+
+            const auto& range = dataSet.signalRange(i);
+            reply.channelRangeMin.push_back(static_cast<float>(range.min));
+            reply.channelRangeMax.push_back(static_cast<float>(range.max));
+        }
+        // MultiArray stores internally elements as stride 1D array: <values_signal_1><values_signal_2><values_signal_3>
+        std::vector<float> values;
+        values.reserve(nSignals * nSamples);
+        for (uint32_t i = 0; i < nSignals; ++i) {
+            auto span = dataSet.signalValues(i).subspan(first, nSamples);
+            values.insert(values.end(), span.begin(), span.end());
+        }
+        reply.channelValues = opencmw::MultiArray<float, 2>(std::move(values), std::array<uint32_t, 2>{static_cast<uint32_t>(nSignals), static_cast<uint32_t>(nSamples)});
 
+        if (!context.noErrors) {
             std::vector<float> errors(nSignals * nSamples, 0.f);
             reply.channelErrors = opencmw::MultiArray<float, 2>(std::move(errors), std::array<uint32_t, 2>{static_cast<uint32_t>(nSignals), static_cast<uint32_t>(nSamples)});
+        }
+
+        const auto timeAxis = std::span(dataSet.axis_values[0]).subspan(first, nSamples);
+        reply.channelTimeSinceRefTrigger.assign(timeAxis.begin(), timeAxis.end());
 
-            reply.channelTimeSinceRefTrigger = dataSet.axis_values[0];
-
-            // copy event_timing information, TODO: now we copy all data only from timing_events[0]
-            if (!dataSet.timing_events.empty()) {
-                const auto& tags = dataSet.timing_events[0];
-                reply.triggerIndices.reserve(tags.size());
-                reply.triggerEventNames.reserve(tags.size());
-                reply.triggerTimestamps.reserve(tags.size());
-                reply.triggerOffsets.reserve(tags.size());
-                reply.triggerYamlPropertyMaps.reserve(tags.size());
-                for (auto& [idx, tagMap] : tags) {
-                    reply.triggerIndices.push_back(static_cast<int64_t>(idx));
-                    reply.triggerEventNames.push_back("");
-                    reply.triggerTimestamps.push_back(0LL);
-                    reply.triggerOffsets.push_back(0.f);
-                    reply.triggerYamlPropertyMaps.push_back(pmt::yaml::serialize(tagMap));
+        // copy event_timing information within the window, TODO: now we copy all data only from timing_events[0]
+        if (!dataSet.timing_events.empty()) {
+            const auto& tags = dataSet.timing_events[0];
+            for (auto& [idx, tagMap] : tags) {
+                if (idx < static_cast<std::ptrdiff_t>(first) || idx >= static_cast<std::ptrdiff_t>(first + nSamples)) {
+                    continue;
                 }
-                reply.triggerIndices.shrink_to_fit();
-                reply.triggerEventNames.shrink_to_fit();
-                reply.triggerTimestamps.shrink_to_fit();
-                reply.triggerOffsets.shrink_to_fit();
-                reply.triggerYamlPropertyMaps.shrink_to_fit();
+                reply.triggerIndices.push_back(static_cast<int64_t>(idx) - static_cast<int64_t>(first));
+                reply.triggerChannelIndices.push_back(0);
+                reply.triggerEventNames.push_back("");
+                reply.triggerTimestamps.push_back(0LL);
+                reply.triggerOffsets.push_back(0.f);
+                appendPropertyMap(reply, tagMap, binaryTags);
             }
-        };
-
-        const auto wasFinished = pollerEntry.poller->finished.load();
-        while (pollerEntry.poller->process(processData, 1)) {
-            super_t::notify(context, reply);
         }
-
-        return wasFinished;
+        return reply;
     }
 };
 
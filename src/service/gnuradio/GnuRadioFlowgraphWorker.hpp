@@ -9,6 +9,7 @@
 #include <gnuradio-4.0/Graph.hpp>
 #include <gnuradio-4.0/Graph_yaml_importer.hpp>
 #include <gnuradio-4.0/Scheduler.hpp>
+#include <gnuradio-4.0/YamlPmt.hpp>
 
 #include <chrono>
 #include <memory>
@@ -16,6 +17,8 @@
 #include <string_view>
 #include <utility>
 
+#include "GnuRadioAcquisitionWorker.hpp"
+
 namespace opendigitizer::gnuradio {
 
 using namespace gr;
@@ -31,6 +34,7 @@ class GnuRadioFlowGraphWorker : public Worker<serviceName, flowgraph::FilterCont
     TAcquisitionWorker&  _acquisitionWorker;
     std::mutex           _flowgraphLock;
     flowgraph::Flowgraph _flowgraph;
+    gr::property_map     _schedulerSection; // kept to round-trip the `scheduler:` section, saveGrc only knows about the graph
 
 public:
     using super_t = Worker<serviceName, flowgraph::FilterContext, flowgraph::SerialisedFlowgraphMessage, flowgraph::SerialisedFlowgraphMessage, Meta...>;
@@ -109,15 +113,29 @@ private:
         if (!grGraph.has_value()) {
             throw std::invalid_argument(std::format("Could not parse flow graph: {}", grGraph.error().message));
         }
-        _flowgraph = std::move(initialFlowGraph);
-        _acquisitionWorker.scheduleGraphChange(std::move(grGraph).value());
+        _schedulerSection = parseSchedulerSection(initialFlowGraph.serialisedFlowgraph);
+        _flowgraph        = std::move(initialFlowGraph);
+        _acquisitionWorker.scheduleGraphChange(std::move(grGraph).value(), _schedulerSection);
+    }
+
+    static gr::property_map parseSchedulerSection(std::string_view grc) {
+        auto section = detail::schedulerSection(grc);
+        std::ignore  = SchedulerConfig{}.withOverrides(section); // reject invalid values with the request instead of when the graph is started
+        return section;
     }
 
     void handleGetRequest(flowgraph::Flowgraph& out) {
         std::lock_guard lockGuard(_flowgraphLock);
         out = _flowgraph;
 
-        auto serialisedFlowgraph = _acquisitionWorker.withGraph([this](const auto& graph) { return gr::saveGrc(*_pluginLoader, graph); });
+        auto serialisedFlowgraph = _acquisitionWorker.withGraph([this](const auto& graph) {
+            if (_schedulerSection.empty()) {
+                return gr::saveGrc(*_pluginLoader, graph);
+            }
+            auto graphMap                                    = gr::detail::saveGraphToMap(*_pluginLoader, graph);
+            graphMap[gr::property_map::key_type("scheduler")] = _schedulerSection;
+            return gr::pmt::yaml::serialize(graphMap);
+        });
 
         out.serialisedFlowgraph = serialisedFlowgraph.value_or("");
     }
@@ -129,10 +147,11 @@ private:
             if (!grGraph.has_value()) {
                 throw std::invalid_argument(std::format("Could not parse flow graph: {}", grGraph.error().message));
             }
-            _flowgraph = in;
-            out        = in;
+            _schedulerSection = parseSchedulerSection(in.serialisedFlowgraph);
+            _flowgraph        = in;
+            out               = in;
 
-            _acquisitionWorker.scheduleGraphChange(std::move(grGraph).value());
+            _acquisitionWorker.scheduleGraphChange(std::move(grGraph).value(), _schedulerSection);
         }
         notifyUpdate();
     }
@@ -0,0 +1,366 @@
+#ifndef OPENDIGITIZER_SERVICE_GNURADIOSPECTRUMWORKER_H
+#define OPENDIGITIZER_SERVICE_GNURADIOSPECTRUMWORKER_H
+
+#include <daq_api.hpp>
+
+#include <majordomo/Worker.hpp>
+
+#include <gnuradio-4.0/algorithm/fourier/fft.hpp>
+#include <gnuradio-4.0/algorithm/fourier/window.hpp>
+#include <gnuradio-4.0/basic/DataSink.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <set>
+#include <span>
+#include <string_view>
+
+#include "GnuRadioAcquisitionWorker.hpp"
+
+namespace opendigitizer::gnuradio {
+
+/// FFT parameters of a spectrum subscription, subscriptions of the same signal with equal parameters share one computation
+struct SpectrumConfig {
+    std::size_t fft_size   = 1024;
+    std::size_t decimation = 1;
+    std::size_t averaging  = 1;
+
+    [[nodiscard]] static SpectrumConfig fromContext(const FreqDomainContext& context) noexcept {
+        return {.fft_size = static_cast<std::size_t>(std::max(context.fftSize, 2)), .decimation = static_cast<std::size_t>(std::max(context.decimation, 1)), .averaging = static_cast<std::size_t>(std::max(context.averaging, 1))};
+    }
+
+    auto operator<=>(const SpectrumConfig&) const noexcept = default;
+};
+
+struct SpectrumKey {
+    std::string    signal_name;
+    SpectrumConfig config;
+
+    auto operator<=>(const SpectrumKey&) const noexcept = default;
+};
+
+/**
+ * Decimates (block average), windows (Hann) and transforms the samples of one signal. The single-sided magnitude spectra of
+ * `averaging` consecutive, non-overlapping frames are averaged linearly, the phase is the one of the last frame.
+ */
+class SpectrumEngine {
+public:
+    struct Result {
+        std::uint64_t      sequence  = 0; ///< incremented for every new spectrum, 0: no spectrum computed yet
+        std::int64_t       timeStamp = 0; ///< UTC [ns] when the last frame of the spectrum was completed
+        std::vector<float> magnitude;
+        std::vector<float> phase;
+        std::vector<float> frequencies; ///< [Hz], normalised to the (decimated) sample rate if the signal has no sample_rate
+    };
+
+private:
+    SpectrumConfig                                               _config;
+    std::vector<float>                                           _window;
+    float                                                        _windowGain;
+    gr::algorithm::FFT<std::complex<float>, std::complex<float>> _fft;
+    std::vector<std::complex<float>>                             _frame;
+    std::vector<float>                                           _magnitudeSum;
+    std::size_t                                                  _nAveraged       = 0;
+    float                                                        _decimationSum   = 0.f;
+    std::size_t                                                  _decimationCount = 0;
+    Result                                                       _latest;
+
+public:
+    explicit SpectrumEngine(SpectrumConfig config) : _config(config), _window(gr::algorithm::window::create(gr::algorithm::window::Type::Hann, config.fft_size)), _windowGain(std::accumulate(_window.begin(), _window.end(), 0.f)) { _frame.reserve(config.fft_size); }
+
+    [[nodiscard]] const Result& latest() const noexcept { return _latest; }
+
+    void process(std::span<const float> samples, float sampleRate) {
+        for (const float sample : samples) {
+            _decimationSum += sample;
+            if (++_decimationCount < _config.decimation) {
+                continue;
+            }
+            _frame.emplace_back(_decimationSum / static_cast<float>(_decimationCount), 0.f);
+            _decimationSum   = 0.f;
+            _decimationCount = 0;
+            if (_frame.size() == _config.fft_size) {
+                transformFrame(sampleRate);
+                _frame.clear();
+            }
+        }
+    }
+
+private:
+    void transformFrame(float sampleRate) {
+        for (std::size_t i = 0; i < _frame.size(); ++i) {
+            _frame[i] *= _window[i];
+        }
+        const auto spectrum = _fft.compute(_frame);
+
+        const std::size_t nBins = _config.fft_size / 2;
+        _magnitudeSum.resize(nBins, 0.f);
+        _latest.phase.resize(nBins);
+        const float norm = _windowGain > 0.f ? 1.f / _windowGain : 1.f;
+        for (std::size_t i = 0; i < nBins; ++i) {
+            _magnitudeSum[i] += std::abs(spectrum[i]) * (i == 0 ? norm : 2.f * norm); // single-sided amplitude spectrum
+            _latest.phase[i] = std::arg(spectrum[i]);
+        }
+
+        if (++_nAveraged < _config.averaging) {
+            return;
+        }
+
+        _latest.magnitude.resize(nBins);
+        std::ranges::transform(_magnitudeSum, _latest.magnitude.begin(), [n = static_cast<float>(_nAveraged)](float sum) { return sum / n; });
+        std::ranges::fill(_magnitudeSum, 0.f);
+        _nAveraged = 0;
+
+        const float binWidth = (sampleRate > 0.f ? sampleRate : 1.f) / static_cast<float>(_config.decimation * _config.fft_size);
+        _latest.frequencies.resize(nBins);
+        for (std::size_t i = 0; i < nBins; ++i) {
+            _latest.frequencies[i] = static_cast<float>(i) * binWidth;
+        }
+        _latest.timeStamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        ++_latest.sequence;
+    }
+};
+
+struct SpectrumPollerEntry {
+    using SampleType = float;
+    std::shared_ptr<gr::basic::StreamingPoller<SampleType>> poller;
+    std::optional<float>                                    tag_sample_rate;             ///< from sample_rate tags of the stream
+    float                                                   setting_sample_rate = 0.f;   ///< sample_rate setting of the sink, until the stream carries a tag
+    bool                                                    restarted           = false; ///< the poller finished during the current tick (graph replaced or stopped)
+    std::vector<SampleType>                                 tickSamples;                 // drained during the current notify tick, shared by all spectra of this signal
+
+    [[nodiscard]] float sampleRate() const noexcept { return tag_sample_rate.value_or(setting_sample_rate); }
+};
+
+/// a spectrum subscription (topic) parsed once when it appears, with the last spectrum sent for each signal and the time of the last update
+struct SpectrumSubscriptionPlan {
+    FreqDomainContext                                 context;
+    SpectrumConfig                                    config;
+    std::vector<std::string>                          signalNames;
+    std::chrono::nanoseconds                          minUpdateInterval = 0ns; // maxClientUpdateFrequencyFilter
+    std::map<std::string, std::uint64_t, std::less<>> lastSequenceBySignal;
+    std::chrono::steady_clock::time_point             lastNotify{};
+};
+
+/**
+ * Serves AcquisitionSpectra for the DataSink signals of the flow graph run by the GnuRadioAcquisitionWorker.
+ * The spectra are computed once per signal and FFT configuration (fftSize, decimation, averaging) and published to all
+ * matching subscribers, at most maxClientUpdateFrequencyFilter times per second. Only acquisition mode "continuous" is supported.
+ * Signals without sample_rate tags use the sample_rate setting of their sink, see setSignalEntries().
+ */
+template<units::basic_fixed_string serviceName, typename... Meta>
+class GnuRadioSpectrumWorker : public Worker<serviceName, FreqDomainContext, Empty, AcquisitionSpectra, Meta...> {
+    std::jthread                              _notifyThread;
+    std::mutex                                _sampleRatesMutex;
+    std::map<std::string, float, std::less<>> _sampleRateBySignal; // sample_rate settings of the sinks, see setSignalEntries()
+    std::uint64_t                             _sampleRatesVersion = 0;
+
+public:
+    using super_t = Worker<serviceName, FreqDomainContext, Empty, AcquisitionSpectra, Meta...>;
+
+    explicit GnuRadioSpectrumWorker(opencmw::URI<opencmw::STRICT> brokerAddress, const opencmw::zmq::Context& context, std::chrono::milliseconds rate, Settings settings = {}) //
+        : super_t(std::move(brokerAddress), {}, context, std::move(settings)) {
+        init(rate);
+    }
+
+    template<typename BrokerType>
+    explicit GnuRadioSpectrumWorker(BrokerType& broker, std::chrono::milliseconds rate) : super_t(broker, {}) {
+        // this makes sure the subscriptions are filtered correctly
+        opencmw::query::registerTypes(FreqDomainContext(), broker);
+        init(rate);
+    }
+
+    ~GnuRadioSpectrumWorker() {
+        _notifyThread.request_stop();
+        _notifyThread.join();
+    }
+
+    /// the sinks of the running flow graph as reported by GnuRadioAcquisitionWorker::setUpdateSignalEntriesCallback
+    void setSignalEntries(const std::vector<SignalEntry>& entries) {
+        std::lock_guard lock(_sampleRatesMutex);
+        _sampleRateBySignal.clear();
+        for (const auto& entry : entries) {
+            if (entry.type == SignalType::Plain && entry.sample_rate) {
+                _sampleRateBySignal.emplace(entry.name, *entry.sample_rate);
+            }
+        }
+        ++_sampleRatesVersion;
+    }
+
+private:
+    void init(std::chrono::milliseconds rate) {
+        _notifyThread = std::jthread([this, rate](const std::stop_token& stoken) {
+            auto                                                           update = std::chrono::system_clock::now();
+            std::map<std::string, SpectrumPollerEntry, std::less<>>        pollers;
+            std::map<SpectrumKey, SpectrumEngine>                          engines;
+            SubscriptionPlanCache<SpectrumSubscriptionPlan>                subscriptionPlans;
+            std::map<std::string, float, std::less<>>                      sampleRateBySignal;
+            std::uint64_t                                                  sampleRatesVersion = 0;
+
+            while (!stoken.stop_requested()) {
+                {
+                    std::lock_guard lock(_sampleRatesMutex);
+                    if (sampleRatesVersion != _sampleRatesVersion) {
+                        sampleRateBySignal = _sampleRateBySignal;
+                        sampleRatesVersion = _sampleRatesVersion;
+                    }
+                }
+                handleSubscriptions(pollers, engines, subscriptionPlans, sampleRateBySignal);
+
+                const auto next_update = update + rate;
+                const auto now         = std::chrono::system_clock::now();
+                if (now < next_update) {
+                    std::this_thread::sleep_for(next_update - now);
+                }
+                update = next_update;
+            }
+        });
+    }
+
+    /// parses the subscription, throws if the context is invalid or asks for anything but continuous spectra
+    static SpectrumSubscriptionPlan makeSubscriptionPlan(const auto& params) {
+        SpectrumSubscriptionPlan plan;
+        plan.context = opencmw::query::deserialise<FreqDomainContext>(params);
+        if (detail::convertToEnum<AcquisitionMode>(plan.context.acquisitionModeFilter) != AcquisitionMode::Continuous) {
+            throw std::invalid_argument(std::format("Unsupported acquisition mode '{}', spectra are only available for 'continuous'", plan.context.acquisitionModeFilter));
+        }
+        plan.config            = SpectrumConfig::fromContext(plan.context);
+        plan.signalNames       = detail::parseSignalNameList(plan.context.channelNameFilter);
+        plan.minUpdateInterval = plan.context.maxClientUpdateFrequencyFilter > 0 ? std::chrono::nanoseconds(1s) / plan.context.maxClientUpdateFrequencyFilter : 0ns;
+        return plan;
+    }
+
+    void handleSubscriptions(std::map<std::string, SpectrumPollerEntry, std::less<>>& pollers, std::map<SpectrumKey, SpectrumEngine>& engines, SubscriptionPlanCache<SpectrumSubscriptionPlan>& subscriptionPlans, //
+        const std::map<std::string, float, std::less<>>& sampleRateBySignal) {
+        subscriptionPlans.beginUpdate();
+        for (const auto& subscription : super_t::activeSubscriptions()) {
+            const auto topic = std::string(subscription.toZmqTopic());
+            try {
+                std::ignore = subscriptionPlans.find(topic, [&subscription] { return makeSubscriptionPlan(subscription.params()); });
+            } catch (const std::exception& e) {
+                std::println(std::cerr, "Could not handle subscription {}: {}", topic, e.what());
+            }
+        }
+        subscriptionPlans.endUpdate();
+        auto plans = subscriptionPlans.plans();
+
+        // drain every signal once per tick, independent of the number of subscribers
+        std::set<std::string, std::less<>> usedSignals;
+        for (const auto& plan : plans) {
+            usedSignals.insert(plan.signalNames.begin(), plan.signalNames.end());
+        }
+        std::erase_if(pollers, [&usedSignals](const auto& signalAndPoller) { return !usedSignals.contains(signalAndPoller.first); });
+        for (const auto& signalName : usedSignals) {
+            const auto sampleRateIt = sampleRateBySignal.find(signalName);
+            drainPoller(pollers, signalName, sampleRateIt != sampleRateBySignal.end() ? sampleRateIt->second : 0.f);
+        }
+
+        // compute each (signal, configuration) spectrum once per tick
+        std::set<SpectrumKey> usedKeys;
+        for (const auto& plan : plans) {
+            for (const auto& signalName : plan.signalNames) {
+                usedKeys.insert(SpectrumKey{.signal_name = signalName, .config = plan.config});
+            }
+        }
+        std::erase_if(engines, [&usedKeys](const auto& keyAndEngine) { return !usedKeys.contains(keyAndEngine.first); });
+        for (const auto& key : usedKeys) {
+            const auto& pollerEntry = pollers.find(key.signal_name)->second;
+            engines.try_emplace(key, key.config).first->second.process(pollerEntry.tickSamples, pollerEntry.sampleRate());
+        }
+
+        // publish the latest spectra, rate-limited per subscription
+        const auto now = std::chrono::steady_clock::now();
+        for (auto& plan : plans) {
+            if (now - plan.lastNotify < plan.minUpdateInterval) {
+                continue;
+            }
+            bool notified = false;
+            for (const auto& signalName : plan.signalNames) {
+                const auto& result       = engines.find(SpectrumKey{.signal_name = signalName, .config = plan.config})->second.latest();
+                auto&       lastSequence = plan.lastSequenceBySignal[signalName];
+                if (result.sequence == lastSequence) {
+                    continue;
+                }
+                super_t::notify(plan.context, buildSpectrumReply(plan.context, signalName, result));
+                lastSequence = result.sequence;
+                notified     = true;
+            }
+            if (notified) {
+                plan.lastNotify = now;
+            }
+        }
+
+        // partial frames and running averages of a replaced or stopped graph must not leak into the spectra of the next one
+        for (const auto& [signalName, pollerEntry] : pollers) {
+            if (!pollerEntry.restarted) {
+                continue;
+            }
+            std::erase_if(engines, [&signalName](const auto& keyAndEngine) { return keyAndEngine.first.signal_name == signalName; });
+            for (auto& plan : plans) {
+                plan.lastSequenceBySignal.erase(signalName);
+            }
+        }
+    }
+
+    /// drains the signal's poller into tickSamples, pollers that are missing (no such sink yet) or finished (graph was replaced) are re-created on the next tick
+    void drainPoller(std::map<std::string, SpectrumPollerEntry, std::less<>>& pollers, std::string_view signalName, float settingSampleRate) {
+        auto pollerIt = pollers.find(signalName);
+        if (pollerIt == pollers.end()) {
+            pollerIt = pollers.emplace(std::string(signalName), SpectrumPollerEntry{}).first;
+        }
+
+        auto& pollerEntry = pollerIt->second;
+        pollerEntry.tickSamples.clear();
+        pollerEntry.restarted           = false;
+        pollerEntry.setting_sample_rate = settingSampleRate;
+        if (pollerEntry.poller == nullptr) {
+            pollerEntry.poller = gr::basic::globalDataSinkRegistry().getStreamingPoller<SpectrumPollerEntry::SampleType>(basic::DataSinkQuery::signalName(signalName), {});
+            if (pollerEntry.poller == nullptr) {
+                return;
+            }
+        }
+
+        const bool wasFinished = pollerEntry.poller->finished.load();
+        std::ignore            = pollerEntry.poller->process([&pollerEntry](std::span<const SpectrumPollerEntry::SampleType> data, std::span<const gr::Tag> tags) {
+            for (const auto& tag : tags) {
+                if (const auto sampleRate = detail::get<float>(tag.map, gr::tag::SAMPLE_RATE.shortKey())) {
+                    pollerEntry.tag_sample_rate = *sampleRate;
+                }
+            }
+            pollerEntry.tickSamples.insert(pollerEntry.tickSamples.end(), data.begin(), data.end());
+        });
+        if (wasFinished) {
+            pollerEntry.poller.reset();
+            pollerEntry.tag_sample_rate.reset();
+            pollerEntry.restarted = true;
+        }
+    }
+
+    static AcquisitionSpectra buildSpectrumReply(const FreqDomainContext& context, std::string_view signalName, const SpectrumEngine::Result& result) {
+        const auto nBins = static_cast<std::int32_t>(result.magnitude.size());
+
+        AcquisitionSpectra reply;
+        reply.selectedFilter               = std::format("{}:{}", context.acquisitionModeFilter, signalName);
+        reply.acqLocalTimeStamp            = result.timeStamp;
+        reply.channelName                  = std::string(signalName);
+        reply.channelMagnitude             = result.magnitude;
+        reply.channelMagnitude_dimensions  = {1, nBins}; // 1 measurement, N bins
+        reply.channelMagnitude_labels      = {"time"s, "frequency"s};
+        reply.channelMagnitude_dim1_labels = {static_cast<long>(result.timeStamp)};
+        reply.channelMagnitude_dim2_labels = result.frequencies;
+        reply.channelPhase                 = result.phase;
+        reply.channelPhase_labels          = {"time"s, "frequency"s};
+        reply.channelPhase_dim1_labels     = {static_cast<long>(result.timeStamp)};
+        reply.channelPhase_dim2_labels     = result.frequencies;
+        return reply;
+    }
+};
+
+} // namespace opendigitizer::gnuradio
+
+#endif // OPENDIGITIZER_SERVICE_GNURADIOSPECTRUMWORKER_H
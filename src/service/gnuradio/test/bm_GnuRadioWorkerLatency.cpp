@@ -0,0 +1,169 @@
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wnull-dereference" // OpenCMW headers
+#endif
+
+#include <Client.hpp>
+#include <IoSerialiserYaS.hpp>
+#include <majordomo/Broker.hpp>
+#include <majordomo/Worker.hpp>
+#include <zmq/ZmqUtils.hpp>
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#include <algorithm>
+#include <array>
+#include <boost/ut.hpp>
+#include <format>
+#include <numeric>
+#include <print>
+
+#include "GnuRadioAcquisitionWorker.hpp"
+
+/**
+ * Measures the time between a sample being produced in the flow graph and the client receiving the corresponding
+ * Acquisition update, for the polling and the event-driven notify mode of the GnuRadioAcquisitionWorker. The subscription
+ * disables the client update rate limit (maxClientUpdateFrequencyFilter=0), otherwise both modes would mostly measure it.
+ *
+ * Not registered with ctest, run manually: ./bm_GnuRadioWorkerLatency
+ */
+
+using namespace opencmw;
+using namespace opendigitizer::gnuradio;
+using namespace std::chrono_literals;
+using namespace boost::ut;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+const Clock::time_point kEpoch = Clock::now();
+
+float millisecondsSinceEpoch() { return std::chrono::duration<float, std::milli>(Clock::now() - kEpoch).count(); }
+} // namespace
+
+/// produces `sample_rate` samples per second (wall-clock), each sample carries its production time in ms since kEpoch
+template<typename T>
+struct TimestampSource : public gr::Block<TimestampSource<T>> {
+    gr::PortOut<T> out;
+
+    float sample_rate = 10'000.f;
+
+    GR_MAKE_REFLECTABLE(TimestampSource, out, sample_rate);
+
+    std::optional<Clock::time_point> _start;
+    std::size_t                      _produced = 0;
+
+    gr::work::Status processBulk(gr::OutputSpanLike auto& output) noexcept {
+        const auto now = Clock::now();
+        if (!_start) {
+            _start = now;
+        }
+        const auto due = static_cast<std::size_t>(std::chrono::duration<double>(now - *_start).count() * static_cast<double>(sample_rate));
+        const auto n   = std::min(output.size(), due - std::min(due, _produced));
+        if (n == 0) {
+            std::this_thread::sleep_for(50us);
+            output.publish(0UZ);
+            return gr::work::Status::OK;
+        }
+        std::ranges::fill(std::span(output.begin(), output.end()).first(n), static_cast<T>(millisecondsSinceEpoch()));
+        output.publish(n);
+        _produced += n;
+        return gr::work::Status::OK;
+    }
+};
+
+namespace {
+struct LatencyStats {
+    std::vector<float> samples;
+
+    void print(std::string_view label) {
+        if (samples.empty()) {
+            std::println("{:>12}: no updates received", label);
+            return;
+        }
+        std::ranges::sort(samples);
+        const auto percentile = [this](double p) { return samples[std::min(samples.size() - 1UZ, static_cast<std::size_t>(p * static_cast<double>(samples.size())))]; };
+        const auto mean       = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(samples.size());
+        std::println("{:>12}: updates: {:6} mean: {:7.2f} ms  p50: {:7.2f} ms  p99: {:7.2f} ms  max: {:7.2f} ms", label, samples.size(), mean, percentile(0.5), percentile(0.99), samples.back());
+    }
+};
+
+LatencyStats measureLatency(NotifyMode mode, std::chrono::milliseconds rate, std::chrono::seconds duration) {
+    using AcqWorker = GnuRadioAcquisitionWorker<"/GnuRadio/Acquisition", description<"Provides data acquisition updates">>;
+
+    constexpr std::string_view kMdsHost = "mds://127.0.0.1:12355";
+    constexpr std::string_view grc      = R"(
+blocks:
+  - id: TimestampSource<float32>
+    parameters:
+      name: source
+      sample_rate: 10000
+  - id: gr::basic::DataSink<float32>
+    parameters:
+      name: sink
+      signal_name: "Latency"
+      sample_rate: 10000
+connections:
+  - [source, 0, sink, 0]
+)";
+
+    gr::BlockRegistry registry;
+    gr::registerBlock<TimestampSource, float>(registry);
+    gr::registerBlock<gr::basic::DataSink, float>(registry);
+    gr::PluginLoader    pluginLoader(registry, gr::globalSchedulerRegistry(), {});
+    majordomo::Broker<> broker("/PrimaryBroker");
+    expect(broker.bind(URI<>(std::string(kMdsHost))).has_value());
+    AcqWorker    acqWorker(broker, &pluginLoader, rate, mode);
+    std::jthread brokerThread([&broker] { broker.run(); });
+    std::jthread acqWorkerThread([&acqWorker] { acqWorker.run(); });
+
+    zmq::Context                                     ctx;
+    std::vector<std::unique_ptr<client::ClientBase>> clients;
+    clients.emplace_back(std::make_unique<client::MDClientCtx>(ctx, 20ms, ""));
+    client::ClientContext client{std::move(clients)};
+
+    std::mutex   statsMutex;
+    LatencyStats stats;
+    client.subscribe(URI(std::format("{}/GnuRadio/Acquisition?channelNameFilter=Latency&maxClientUpdateFrequencyFilter=0", kMdsHost)), [&stats, &statsMutex](const mdp::Message& update) {
+        const float receivedAt = millisecondsSinceEpoch();
+        if (!update.error.empty()) {
+            return;
+        }
+        Acquisition acq;
+        IoBuffer    buffer(update.data);
+        std::ignore = deserialise<YaS, ProtocolCheck::IGNORE>(buffer, acq);
+        if (acq.channelValues.elements().empty()) {
+            return;
+        }
+        std::lock_guard lock(statsMutex);
+        stats.samples.push_back(receivedAt - acq.channelValues.elements().back());
+    });
+
+    std::this_thread::sleep_for(100ms);
+    auto graph = gr::loadGrc(pluginLoader, std::string(grc));
+    expect(graph.has_value());
+    acqWorker.scheduleGraphChange(std::move(graph).value());
+
+    std::this_thread::sleep_for(duration);
+
+    client.stop();
+    broker.shutdown();
+    brokerThread.join();
+    acqWorkerThread.join();
+
+    std::lock_guard lock(statsMutex);
+    return std::move(stats);
+}
+} // namespace
+
+const boost::ut::suite GnuRadioWorkerLatency_benchmarks = [] {
+    "notify latency"_test = [] {
+        constexpr auto kDuration = 5s;
+        measureLatency(NotifyMode::Polling, 50ms, kDuration).print("Polling");
+        measureLatency(NotifyMode::EventDriven, 1000ms, kDuration).print("EventDriven");
+    };
+};
+
+int main() { /* not needed for ut */ }
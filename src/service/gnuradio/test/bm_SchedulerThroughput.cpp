@@ -0,0 +1,134 @@
+#include <atomic>
+#include <boost/ut.hpp>
+#include <chrono>
+#include <cmath>
+#include <format>
+#include <print>
+
+#include "GnuRadioAcquisitionWorker.hpp"
+
+#include "CountSource.hpp"
+
+/**
+ * Throughput of the scheduler execution policies selectable via SchedulerConfig on a CountSource driven graph that fans
+ * out into several independent, CPU-heavy processing chains (similar to a digitizer with filters/FFTs per channel).
+ *
+ * Not registered with ctest, run manually: ./bm_SchedulerThroughput
+ */
+
+using namespace opendigitizer::gnuradio;
+using namespace boost::ut;
+
+/// stands in for a filter: a few transcendental operations per sample
+template<typename T>
+struct BusyWork : public gr::Block<BusyWork<T>> {
+    gr::PortIn<T>  in;
+    gr::PortOut<T> out;
+
+    std::uint32_t iterations = 8;
+
+    GR_MAKE_REFLECTABLE(BusyWork, in, out, iterations);
+
+    [[nodiscard]] T processOne(T value) const noexcept {
+        T acc = value;
+        for (std::uint32_t i = 0; i < iterations; ++i) {
+            acc = std::sin(acc) + std::cos(acc) * T(0.5);
+        }
+        return acc;
+    }
+};
+
+namespace {
+std::atomic<std::uint64_t> gReceivedSamples = 0;
+} // namespace
+
+/// counts the samples arriving at the end of a chain
+template<typename T>
+struct CountingSink : public gr::Block<CountingSink<T>> {
+    gr::PortIn<T> in;
+
+    GR_MAKE_REFLECTABLE(CountingSink, in);
+
+    gr::work::Status processBulk(gr::InputSpanLike auto& input) noexcept {
+        gReceivedSamples += input.size();
+        return gr::work::Status::OK;
+    }
+};
+
+namespace {
+constexpr std::size_t kChains      = 4UZ;
+constexpr std::size_t kChainLength = 3UZ;
+constexpr std::size_t kSamples     = 2'000'000UZ;
+constexpr std::size_t kRepetitions = 3UZ;
+
+std::string makeGrc() {
+    std::string blocks      = std::format("blocks:\n  - id: CountSource<float32>\n    parameters:\n      name: source\n      n_samples: {}\n", kSamples);
+    std::string connections = "connections:\n";
+    for (std::size_t chain = 0; chain < kChains; ++chain) {
+        std::string previous = "source";
+        for (std::size_t stage = 0; stage < kChainLength; ++stage) {
+            const auto name = std::format("busy_{}_{}", chain, stage);
+            blocks += std::format("  - id: BusyWork<float32>\n    parameters:\n      name: {}\n", name);
+            connections += std::format("  - [{}, 0, {}, 0]\n", previous, name);
+            previous = name;
+        }
+        blocks += std::format("  - id: CountingSink<float32>\n    parameters:\n      name: sink_{}\n", chain);
+        connections += std::format("  - [{}, 0, sink_{}, 0]\n", previous, chain);
+    }
+    return blocks + connections;
+}
+
+double measureThroughput(gr::PluginLoader& pluginLoader, const std::string& grc, const SchedulerConfig& config) {
+    const auto servicePool = applyCpuPool(config);
+
+    double bestSamplesPerSecond = 0.0;
+    for (std::size_t repetition = 0; repetition < kRepetitions; ++repetition) {
+        auto loaded = gr::loadGrc(pluginLoader, grc);
+        expect(fatal(loaded.has_value()));
+        gr::meta::indirect<gr::Graph> graph     = std::move(loaded).value();
+        auto                          scheduler = opendigitizer::gnuradio::detail::makeScheduler(config.policy, std::move(*graph));
+
+        gReceivedSamples = 0;
+        const auto start = std::chrono::steady_clock::now();
+        scheduler->runAndWait();
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        expect(eq(gReceivedSamples.load(), static_cast<std::uint64_t>(kChains * kSamples))) << "all chains must see all samples";
+
+        bestSamplesPerSecond = std::max(bestSamplesPerSecond, static_cast<double>(kSamples) / elapsed);
+    }
+    restoreCpuPool(servicePool);
+    return bestSamplesPerSecond;
+}
+} // namespace
+
+const boost::ut::suite SchedulerThroughput_benchmarks = [] {
+    "execution policies"_test = [] {
+        using enum gr::scheduler::ExecutionPolicy;
+        gr::BlockRegistry registry;
+        gr::registerBlock<CountSource, float>(registry);
+        gr::registerBlock<BusyWork, float>(registry);
+        gr::registerBlock<CountingSink, float>(registry);
+        gr::PluginLoader pluginLoader(registry, gr::globalSchedulerRegistry(), {});
+        const auto       grc = makeGrc();
+
+        const std::vector<std::pair<std::string_view, SchedulerConfig>> configs{
+            {"singleThreadedBlocking", {.policy = singleThreadedBlocking, .threads = SchedulerConfig::kDefaultThreads}}, // the former hard-coded default
+            {"singleThreaded", {.policy = singleThreaded, .threads = 1UZ}},                                              //
+            {"multiThreaded", {.policy = multiThreaded, .threads = 2UZ}},                                                //
+            {"multiThreaded", {.policy = multiThreaded, .threads = kChains}},                                            //
+        };
+
+        std::println("{} chains x {} BusyWork blocks, {} samples, best of {} runs", kChains, kChainLength, kSamples, kRepetitions);
+        double baseline = 0.0;
+        for (const auto& [label, config] : configs) {
+            const auto samplesPerSecond = measureThroughput(pluginLoader, grc, config);
+            if (baseline == 0.0) {
+                baseline = samplesPerSecond;
+            }
+            std::println("{:>24}: threads: {:2}  {:8.2f} MS/s  speed-up: {:.2f}x", label, config.threads.value_or(SchedulerConfig::kDefaultThreads), samplesPerSecond * 1e-6, samplesPerSecond / baseline);
+        }
+    };
+};
+
+int main() { /* not needed for ut */ }
@@ -0,0 +1,95 @@
+#include <boost/ut.hpp>
+
+#include <chrono>
+#include <format>
+#include <print>
+
+#include <gnuradio-4.0/Tag.hpp>
+#include <gnuradio-4.0/YamlPmt.hpp>
+
+#include <TagEncoding.hpp>
+
+/**
+ * Round-trip cost of the tag property maps in Acquisition updates: one YAML document per tag vs. the binary TagEncoding.
+ *
+ * Not registered with ctest, run manually: ./bm_TagEncoding
+ */
+
+using namespace opendigitizer::acq;
+using namespace boost::ut;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+/// timing-system like tags: trigger name/time/offset, context and the FAIR meta info
+std::vector<gr::property_map> makeTimingTags(std::size_t nTags) {
+    std::vector<gr::property_map> tags;
+    tags.reserve(nTags);
+    for (std::size_t i = 0; i < nTags; ++i) {
+        const gr::property_map metaInfo{{"BPCID", static_cast<int>(i % 16)}, {"SID", static_cast<int>(i % 7)}, {"BPID", static_cast<int>(i % 3)}, {"GID", 42}, {"EVENT-NO", static_cast<int>(256 + i % 4)}};
+        tags.push_back(gr::property_map{
+            {gr::tag::TRIGGER_NAME.shortKey(), std::string(i % 2 == 0 ? "CMD_BP_START" : "CMD_SEQ_START")}, //
+            {gr::tag::TRIGGER_TIME.shortKey(), std::uint64_t{1'700'000'000'000'000'000ULL + i * 1000ULL}},  //
+            {gr::tag::TRIGGER_OFFSET.shortKey(), 0.5f * static_cast<float>(i % 10)},                        //
+            {gr::tag::CONTEXT.shortKey(), std::format("FAIR-TIMING:C={}:S={}:P={}", i % 16, i % 7, i % 3)}, //
+            {gr::tag::TRIGGER_META_INFO.shortKey(), metaInfo}});
+    }
+    return tags;
+}
+
+double elapsedMs(Clock::time_point start) { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); }
+} // namespace
+
+const boost::ut::suite TagEncoding_benchmarks = [] {
+    "tag round trip"_test = [] {
+        constexpr std::size_t kTags       = 10'000;
+        constexpr std::size_t kIterations = 5;
+        const auto            tags        = makeTimingTags(kTags);
+
+        double      yamlMs    = 0.0;
+        double      binaryMs  = 0.0;
+        std::size_t yamlBytes = 0UZ;
+        std::size_t binBytes  = 0UZ;
+        for (std::size_t iteration = 0; iteration < kIterations; ++iteration) {
+            // YAML: what the service and RemoteSource did per tag so far
+            auto start = Clock::now();
+            {
+                Acquisition acq;
+                for (const auto& tag : tags) {
+                    acq.triggerIndices.push_back(0);
+                    acq.triggerYamlPropertyMaps.push_back(gr::pmt::yaml::serialize(tag));
+                }
+                const auto decoded = decodeTriggerPropertyMaps(acq);
+                expect(eq(decoded.size(), kTags));
+                yamlBytes = 0UZ;
+                for (const auto& yaml : acq.triggerYamlPropertyMaps.value()) {
+                    yamlBytes += yaml.size();
+                }
+            }
+            yamlMs += elapsedMs(start);
+
+            start = Clock::now();
+            Acquisition acq;
+            for (const auto& tag : tags) {
+                acq.triggerIndices.push_back(0);
+                tag_encoding::encode(tag, acq.triggerBinaryPropertyMaps.value());
+            }
+            const auto decoded = decodeTriggerPropertyMaps(acq);
+            binaryMs += elapsedMs(start);
+
+            expect(eq(decoded.size(), kTags));
+            binBytes = acq.triggerBinaryPropertyMaps.value().size();
+            if (iteration == 0) { // round trip must be lossless
+                for (std::size_t i = 0; i < kTags; ++i) {
+                    expect(eq(gr::pmt::yaml::serialize(decoded[i]), gr::pmt::yaml::serialize(tags[i]))) << "tag" << i;
+                }
+            }
+        }
+
+        std::println("{} tags, mean of {} iterations (encode + decode)", kTags, kIterations);
+        std::println("{:>8}: {:8.2f} ms  {:9} bytes", "yaml", yamlMs / kIterations, yamlBytes);
+        std::println("{:>8}: {:8.2f} ms  {:9} bytes  speed-up: {:.1f}x", "binary", binaryMs / kIterations, binBytes, yamlMs / binaryMs);
+    };
+};
+
+int main() { /* not needed for ut */ }
@@ -31,6 +31,7 @@
 
 #include "GnuRadioAcquisitionWorker.hpp"
 #include "GnuRadioFlowgraphWorker.hpp"
+#include "GnuRadioSpectrumWorker.hpp"
 
 #include "CountSource.hpp"
 
@@ -230,8 +231,9 @@ struct TestConfig {
 };
 
 struct TestApp {
-    using AcqWorker = GnuRadioAcquisitionWorker<"/GnuRadio/Acquisition", description<"Provides data acquisition updates">>;
-    using FgWorker  = GnuRadioFlowGraphWorker<AcqWorker, "/GnuRadio/FlowGraph", description<"Provides access to flow graph">>;
+    using AcqWorker      = GnuRadioAcquisitionWorker<"/GnuRadio/Acquisition", description<"Provides data acquisition updates">>;
+    using FgWorker       = GnuRadioFlowGraphWorker<AcqWorker, "/GnuRadio/FlowGraph", description<"Provides access to flow graph">>;
+    using SpectrumWorker = GnuRadioSpectrumWorker<"/GnuRadio/AcquisitionSpectra", description<"Provides spectra of the flow graph signals">>;
 
     inline static constexpr std::uint16_t    httpPort = 12347;
     inline static constexpr std::string_view httpHost = "https://127.0.0.1:12347";
@@ -239,23 +241,26 @@ struct TestApp {
     inline static constexpr std::string_view mdsHost  = "mds://127.0.0.1:12345";
 
     TestConfig config;
+    NotifyMode notifyMode = NotifyMode::Polling;
 
     gr::BlockRegistry registry = [] {
         gr::BlockRegistry r;
         registerTestBlocks(r);
         return r;
     }();
-    gr::PluginLoader      pluginLoader = gr::PluginLoader(registry, gr::globalSchedulerRegistry(), {});
-    majordomo::Broker<>   broker       = majordomo::Broker<>("/PrimaryBroker");
-    AcqWorker             acqWorker    = AcqWorker(broker, &pluginLoader, 50ms);
-    FgWorker              fgWorker     = FgWorker(broker, &pluginLoader, {}, acqWorker);
+    gr::PluginLoader      pluginLoader   = gr::PluginLoader(registry, gr::globalSchedulerRegistry(), {});
+    majordomo::Broker<>   broker         = majordomo::Broker<>("/PrimaryBroker");
+    SpectrumWorker        spectrumWorker = SpectrumWorker(broker, 50ms); // outlives acqWorker, whose destructor still reports to it
+    AcqWorker             acqWorker      = AcqWorker(broker, &pluginLoader, notifyMode == NotifyMode::EventDriven ? 1000ms : 50ms, notifyMode);
+    FgWorker              fgWorker       = FgWorker(broker, &pluginLoader, {}, acqWorker);
     std::jthread          brokerThread;
     std::jthread          acqWorkerThread;
     std::jthread          fgWorkerThread;
+    std::jthread          spectrumWorkerThread;
     zmq::Context          ctx;
     client::ClientContext client = makeClient(ctx);
 
-    explicit TestApp(std::function<void(std::vector<SignalEntry>)> dnsCallback = {}) {
+    explicit TestApp(std::function<void(std::vector<SignalEntry>)> dnsCallback = {}, NotifyMode notifyMode_ = NotifyMode::Polling) : notifyMode(notifyMode_) {
         const auto brokerPubAddress = broker.bind(URI<>(std::string(mdsHost)));
         expect((brokerPubAddress.has_value() == "bound successful"_b));
         const auto brokerRouterAddress = broker.bind(URI<>(std::string(mdpHost)));
@@ -272,11 +277,17 @@ struct TestApp {
         if (auto rc = broker.bindRest(restSettings); !rc) {
             std::println(std::cerr, "Could not bind REST bridge: {}", rc.error());
         }
-        acqWorker.setUpdateSignalEntriesCallback(std::move(dnsCallback));
+        acqWorker.setUpdateSignalEntriesCallback([this, dnsCallback = std::move(dnsCallback)](std::vector<SignalEntry> entries) {
+            spectrumWorker.setSignalEntries(entries);
+            if (dnsCallback) {
+                dnsCallback(std::move(entries));
+            }
+        });
 
-        brokerThread    = std::jthread([this] { broker.run(); });
-        acqWorkerThread = std::jthread([this] { acqWorker.run(); });
-        fgWorkerThread  = std::jthread([this] { fgWorker.run(); });
+        brokerThread         = std::jthread([this] { broker.run(); });
+        acqWorkerThread      = std::jthread([this] { acqWorker.run(); });
+        fgWorkerThread       = std::jthread([this] { fgWorker.run(); });
+        spectrumWorkerThread = std::jthread([this] { spectrumWorker.run(); });
         // let's give everyone some time to spin up and sort themselves
         std::this_thread::sleep_for(100ms);
     }
@@ -326,6 +337,21 @@ struct TestApp {
         });
     }
 
+    void subscribeSpectrumClient(std::string_view relativeUri, std::function<void(const AcquisitionSpectra&)>&& handlerFnc) {
+        client.subscribe(URI(std::format("{}{}", mdsHost, relativeUri)), [handler = std::move(handlerFnc)](const mdp::Message& update) {
+            if (update.error != "") {
+                return;
+            }
+            AcquisitionSpectra spectra;
+            IoBuffer           buffer(update.data);
+            const auto         result = deserialise<opencmw::YaS, ProtocolCheck::ALWAYS>(buffer, spectra);
+            if (!result.exceptions.empty()) {
+                throw result.exceptions.front();
+            }
+            handler(spectra);
+        });
+    }
+
     void setGrc(std::string_view grc, auto callback) {
         opendigitizer::flowgraph::Flowgraph fg{std::string(grc), {}};
         gr::Message                         message;
@@ -360,6 +386,7 @@ struct TestApp {
         brokerThread.join();
         acqWorkerThread.join();
         fgWorkerThread.join();
+        spectrumWorkerThread.join();
     }
 };
 
@@ -499,6 +526,696 @@ connections:
         waitWhile([&] { return receivedCount == 0; });
     } | testConfigs;
 
+    "Streaming rate limited"_test = [] {
+        constexpr std::string_view grc = R"(
+blocks:
+  - id: CountSource<float32>
+    parameters:
+      name: count
+      n_samples: 100000
+      sample_rate: 1000
+  - id: gr::testing::Delay<float32>
+    parameters:
+      name: delay
+      delay_ms: 600
+  - id: gr::basic::DataSink<float32>
+    parameters:
+      name: test_sink
+      signal_name: "Signal_A"
+connections:
+  - [count, 0, delay, 0]
+  - [delay, 0, test_sink, 0]
+)";
+        TestApp test;
+
+        constexpr std::size_t    kExpectedSamples = 100'000;
+        std::vector<float>       receivedData;
+        std::atomic<std::size_t> receivedCount = 0;
+        std::atomic<std::size_t> updateCount   = 0;
+
+        // 1 Hz: all samples of the burst must arrive (coalesced into few updates), none may be dropped
+        test.subscribeClient("/GnuRadio/Acquisition?channelNameFilter=Signal_A&maxClientUpdateFrequencyFilter=1", [&](const Acquisition& acq) {
+            const auto samples = samplesForSignalIndex(acq.channelValues, 0);
+            checkAcquisitionMeta(acq, 1UZ, samples.size(), {"Signal_A"}, {}, {}, {}, {}, "");
+            checkTimeAxis(acq, 1000.f, "");
+            receivedData.insert(receivedData.end(), samples.begin(), samples.end());
+            receivedCount = receivedData.size();
+            updateCount++;
+        });
+
+        std::this_thread::sleep_for(50ms);
+        test.setGrc(grc);
+
+        waitWhile([&] { return receivedCount < kExpectedSamples; });
+
+        expect(eq(receivedData, getIota(kExpectedSamples)));
+        expect(le(updateCount.load(), 3UZ)) << "skipped ticks must be coalesced into the next update";
+    };
+
+    "Streaming event driven"_test = [] {
+        constexpr std::string_view grc = R"(
+blocks:
+  - id: CountSource<float32>
+    parameters:
+      name: count
+      n_samples: 50000
+      sample_rate: 1000
+  - id: gr::testing::Delay<float32>
+    parameters:
+      name: delay
+      delay_ms: 600
+  - id: gr::basic::DataSink<float32>
+    parameters:
+      name: test_sink
+      signal_name: "Signal_A"
+connections:
+  - [count, 0, delay, 0]
+  - [delay, 0, test_sink, 0]
+)";
+        constexpr std::string_view grcForever = R"(
+blocks:
+  - id: ForeverSource<float32>
+    parameters:
+      name: source
+  - id: gr::basic::DataSink<float32>
+    parameters:
+      name: test_sink
+      signal_name: "Signal_A"
+connections:
+  - [source, 0, test_sink, 0]
+)";
+        constexpr std::size_t    kExpectedSamples = 50'000;
+        std::mutex               receivedMutex;
+        std::vector<float>       receivedData;
+        std::atomic<std::size_t> receivedCount = 0;
+        {
+            TestApp test({}, NotifyMode::EventDriven); // the 1 s rate only bounds the idle wait, updates are triggered by graph progress
+            expect(test.acqWorker.notifyMode() == NotifyMode::EventDriven);
+
+            test.subscribeClient("/GnuRadio/Acquisition?channelNameFilter=Signal_A", [&](const Acquisition& acq) {
+                const auto      samples = samplesForSignalIndex(acq.channelValues, 0);
+                std::lock_guard lock(receivedMutex);
+                receivedData.insert(receivedData.end(), samples.begin(), samples.end());
+                receivedCount = receivedData.size();
+            });
+
+            std::this_thread::sleep_for(50ms);
+            test.setGrc(grc);
+            waitWhile([&] { return receivedCount < kExpectedSamples; });
+
+            // the progress watcher is restarted on the replacement graph
+            test.setGrc(grcForever);
+            waitWhile([&] { return receivedCount < 2UZ * kExpectedSamples; });
+        } // ~TestApp stops the still running graph and joins the progress watcher and the notify thread
+
+        std::lock_guard lock(receivedMutex);
+        expect(eq(std::vector(receivedData.begin(), receivedData.begin() + static_cast<std::ptrdiff_t>(kExpectedSamples)), getIota(kExpectedSamples)));
+    };
+
+    "Streaming multiple channels"_test = [] {
+        constexpr std::string_view grc = R"(
+blocks:
+  - id: CountSource<float32>
+    parameters:
+      name: count_up
+      n_samples: 20000
+      timing_tags: !!str
+        - 100,up_first
+        - 5000,up_second
+  - id: gr::testing::Delay<float32>
+    parameters:
+      name: delay_up
+      delay_ms: 600
+  - id: CountSource<float32>
+    parameters:
+      name: count_down
+      n_samples: 20000
+      initial_value: 19999
+      direction: down
+      timing_tags: !!str
+        - 50,down_first
+        - 5000,down_second
+  - id: gr::testing::Delay<float32>
+    parameters:
+      name: delay_down
+      delay_ms: 600
+  - id: gr::basic::DataSink<float32>
+    parameters:
+      name: test_sink_up
+      signal_name: "Signal_Up"
+  - id: gr::basic::DataSink<float32>
+    parameters:
+      name: test_sink_down
+      signal_name: "Signal_Down"
+connections:
+  - [count_up, 0, delay_up, 0]
+  - [delay_up, 0, test_sink_up, 0]
+  - [count_down, 0, delay_down, 0]
+  - [delay_down, 0, test_sink_down, 0]
+)";
+        TestApp test;
+
+        constexpr std::size_t                           kExpectedSamples = 20'000;
+        std::map<std::string, std::vector<float>>       receivedData;
+        std::atomic<std::size_t>                        receivedCount = 0;
+        std::atomic<std::size_t>                        batchedCount  = 0;
+        std::map<std::string, std::vector<std::string>> receivedTriggers; // by the channel they were attributed to
+        std::size_t                                     unsortedTriggers = 0UZ;
+
+        // both channels are packed into one update with a shared time axis, remainders at the end of the stream may arrive per channel
+        test.subscribeClient("/GnuRadio/Acquisition?channelNameFilter=Signal_Up,Signal_Down", [&](const Acquisition& acq) {
+            const auto nSignals = static_cast<std::size_t>(acq.channelValues.n(0));
+            expect(eq(acq.channelNames.size(), nSignals));
+            expect(eq(acq.channelTimeSinceRefTrigger.size(), static_cast<std::size_t>(acq.channelValues.n(1))));
+            if (nSignals == 2) {
+                expect(eq(acq.channelNames.value(), std::vector<std::string>{"Signal_Up", "Signal_Down"}));
+                ++batchedCount;
+            }
+            for (std::size_t i = 0; i < nSignals; ++i) {
+                const auto samples = samplesForSignalIndex(acq.channelValues, i);
+                auto&      data    = receivedData[acq.channelNames[i]];
+                data.insert(data.end(), samples.begin(), samples.end());
+            }
+            expect(eq(acq.triggerChannelIndices.size(), acq.triggerIndices.size()));
+            for (std::size_t i = 0; i < std::min(acq.triggerChannelIndices.size(), acq.triggerEventNames.size()); ++i) {
+                receivedTriggers[acq.channelNames[static_cast<std::size_t>(acq.triggerChannelIndices[i])]].push_back(acq.triggerEventNames[i]);
+            }
+            if (!std::ranges::is_sorted(acq.triggerIndices.value())) {
+                ++unsortedTriggers;
+            }
+            receivedCount = std::min(receivedData["Signal_Up"].size(), receivedData["Signal_Down"].size());
+        });
+
+        std::this_thread::sleep_for(50ms);
+        test.setGrc(grc);
+
+        waitWhile([&] { return receivedCount < kExpectedSamples; });
+
+        const std::vector<float> expectedUpData   = getIota(kExpectedSamples);
+        auto                     expectedDownData = expectedUpData;
+        std::reverse(expectedDownData.begin(), expectedDownData.end());
+        expect(gt(batchedCount.load(), 0UZ));
+        expect(eq(receivedData["Signal_Up"], expectedUpData));
+        expect(eq(receivedData["Signal_Down"], expectedDownData));
+        expect(eq(receivedTriggers["Signal_Up"], std::vector<std::string>{"up_first", "up_second"}));
+        expect(eq(receivedTriggers["Signal_Down"], std::vector<std::string>{"down_first", "down_second"}));
+        expect(eq(unsortedTriggers, 0UZ));
+    };
+
+    "Streaming binary tags"_test = [] {
+        constexpr std::string_view grc = R"(
+blocks:
+  - id: CountSource<float32>
+    parameters:
+      name: count
+      n_samples: 100
+      timing_tags: !!str
+        - 10,first
+        - 50,second/ctx
+  - id: gr::testing::Delay<float32>
+    parameters:
+      name: delay
+      delay_ms: 600
+  - id: gr::basic::DataSink<float32>
+    parameters:
+      name: test_sink
+      signal_name: "Signal_A"
+connections:
+  - [count, 0, delay, 0]
+  - [delay, 0, test_sink, 0]
+)";
+        TestApp test;
+
+        std::vector<std::string> receivedTriggerNames;
+        std::atomic<std::size_t> receivedCount = 0;
+
+        test.subscribeClient("/GnuRadio/Acquisition?channelNameFilter=Signal_A&tagEncoding=binary", [&](const Acquisition& acq) {
+            expect(acq.triggerYamlPropertyMaps.value().empty());
+            const auto maps = decodeTriggerPropertyMaps(acq);
+            expect(eq(maps.size(), acq.triggerIndices.size()));
+            for (const auto& map : maps) {
+                auto it = map.find(std::string_view{gr::tag::TRIGGER_NAME});
+                if (it == map.end()) {
+                    it = map.find(gr::tag::TRIGGER_NAME.shortKey());
+                }
+                if (it != map.end()) {
+                    receivedTriggerNames.push_back(it->second.value_or(std::string()));
+                }
+            }
+            receivedCount += static_cast<std::size_t>(acq.channelValues.n(1));
+        });
+        std::atomic<std::size_t> invalidEncodingUpdates = 0;
+        test.subscribeClient("/GnuRadio/Acquisition?channelNameFilter=Signal_A&tagEncoding=noSuchEncoding", [&](const Acquisition&) { invalidEncodingUpdates++; });
+
+        std::this_thread::sleep_for(50ms);
+        test.setGrc(grc);
+
+        waitWhile([&] { return receivedCount < 100; });
+
+        expect(eq(receivedTriggerNames, std::vector<std::string>{"first", "second"}));
+        expect(eq(invalidEncodingUpdates.load(), 0UZ)); // rejected when the subscription plan is built
+    };
+
+    "Binary tag encoding of malformed payloads"_test = [] {
+        namespace tag_encoding = opendigitizer::acq::tag_encoding;
+
+        gr::property_map map{{"flag", true}, {"name", std::string("first")}, {"ctx", gr::property_map{{"off", false}}}};
+        std::vector<std::uint8_t> encoded;
+        tag_encoding::encode(map, encoded);
+        std::span<const std::uint8_t> in(encoded);
+        const auto                    decoded = tag_encoding::decode(in);
+        expect(fatal(decoded.has_value()));
+        expect(in.empty());
+        expect(eq(decoded->size(), 3UZ));
+        const auto* flag = decoded->at("flag").get_if<bool>();
+        const auto* ctx  = decoded->at("ctx").get_if<gr::property_map>();
+        expect(fatal(flag != nullptr && ctx != nullptr));
+        expect(*flag);
+        expect(eq(decoded->at("name").value_or(std::string()), std::string("first")));
+        expect(ctx->at("off").get_if<bool>() != nullptr && !*ctx->at("off").get_if<bool>());
+
+        // bool payload other than 0/1
+        std::vector<std::uint8_t> invalidBool;
+        tag_encoding::encode(gr::property_map{{"flag", true}}, invalidBool);
+        invalidBool.back() = 2U;
+        std::span<const std::uint8_t> invalidBoolIn(invalidBool);
+        expect(!tag_encoding::decode(invalidBoolIn).has_value());
+
+        // every truncation of a valid payload is an error, not a read past the end
+        for (std::size_t n = 0UZ; n < encoded.size(); ++n) {
+            std::span<const std::uint8_t> truncated(encoded.data(), n);
+            expect(!tag_encoding::decode(truncated).has_value()) << "truncated to" << n << "bytes";
+        }
+
+        // deeply nested maps (hand-written payload) are rejected before the recursion runs out of stack
+        std::vector<std::uint8_t> nested;
+        for (std::size_t level = 0UZ; level < 100'000UZ; ++level) {
+            const std::array<std::uint8_t, 10> entry{1U, 0U, 0U, 0U, 1U, 0U, 0U, 0U, 'm', static_cast<std::uint8_t>(tag_encoding::ValueType::Map)}; // 1 entry, key "m"
+            nested.insert(nested.end(), entry.begin(), entry.end());
+        }
+        nested.insert(nested.end(), {0U, 0U, 0U, 0U}); // innermost map is empty
+        std::span<const std::uint8_t> nestedIn(nested);
+        const auto                    nestedResult = tag_encoding::decode(nestedIn);
+        expect(fatal(!nestedResult.has_value()));
+        expect(nestedResult.error().contains("nested")) << nestedResult.error();
+
+        // the deepest accepted nesting still decodes
+        gr::property_map deepest;
+        for (std::size_t level = 1UZ; level < tag_encoding::kMaxNestingDepth; ++level) {
+            deepest = gr::property_map{{"m", std::move(deepest)}};
+        }
+        std::vector<std::uint8_t> deepestEncoded;
+        tag_encoding::encode(deepest, deepestEncoded);
+        std::span<const std::uint8_t> deepestIn(deepestEncoded);
+        expect(tag_encoding::decode(deepestIn).has_value());
+    };
+
+    "Streaming without errors and time axis"_test = [] {
+        constexpr std::string_view grc = R"(
+blocks:
+  - id: CountSource<float32>
+    parameters:
+      name: count
+      n_samples: 10000
+      sample_rate: 1000
+  - id: gr::testing::Delay<float32>
+    parameters:
+      name: delay
+      delay_ms: 600
+  - id: gr::basic::DataSink<float32>
+    parameters:
+      name: test_sink
+      signal_name: "Signal_A"
+connections:
+  - [count, 0, delay, 0]
+  - [delay, 0, test_sink, 0]
+)";
+        TestApp test;
+
+        constexpr std::size_t    kExpectedSamples = 10'000;
+        std::vector<float>       receivedData;
+        std::atomic<std::size_t> receivedCount = 0;
+
+        test.subscribeClient("/GnuRadio/Acquisition?channelNameFilter=Signal_A&noErrors=true&implicitTimeAxis=true", [&](const Acquisition& acq) {
+            const auto samples = samplesForSignalIndex(acq.channelValues, 0);
+            expect(eq(acq.channelValues.n(0), 1U));
+            expect(acq.channelErrors.elements().empty());
+            expect(acq.channelTimeSinceRefTrigger.value().empty());
+            receivedData.insert(receivedData.end(), samples.begin(), samples.end());
+            receivedCount = receivedData.size();
+        });
+
+        std::this_thread::sleep_for(50ms);
+        test.setGrc(grc);
+
+        waitWhile([&] { return receivedCount < kExpectedSamples; });
+
+        expect(eq(receivedData, getIota(kExpectedSamples)));
+    };
+
+    "Decimation"_test = [] {
+        Acquisition acq;
+        acq.channelValues                      = opencmw::MultiArray<float, 2>({0.f, 5.f, -1.f, 2.f, 3.f, /**/ 1.f, 1.f, 1.f, 1.f, 7.f}, std::array<uint32_t, 2>{2U, 5U});
+        acq.channelErrors                      = opencmw::MultiArray<float, 2>(std::vector<float>(10UZ, 0.5f), std::array<uint32_t, 2>{2U, 5U});
+        acq.channelTimeSinceRefTrigger.value() = {0.f, 1.f, 2.f, 3.f, 4.f};
+        acq.triggerIndices.value()             = {0, 3, 4};
+
+        auto envelope = acq;
+        Decimation{.factor = 2UZ, .mode = Decimation::Mode::MinMax}.apply(envelope);
+        expect(eq(envelope.channelValues.n(0), 2U));
+        expect(eq(envelope.channelValues.n(1), 6U));
+        expect(eq(envelope.channelValues.elements(), std::vector<float>{0.f, 5.f, -1.f, 2.f, 3.f, 3.f, /**/ 1.f, 1.f, 1.f, 1.f, 7.f, 7.f}));
+        expect(eq(envelope.channelErrors.elements().size(), 12UZ));
+        expect(eq(envelope.channelTimeSinceRefTrigger.value(), std::vector<float>{0.f, 1.f, 2.f, 3.f, 4.f, 4.f}));
+        expect(eq(envelope.triggerIndices.value(), std::vector<int64_t>{0, 2, 4}));
+
+        auto mean = acq;
+        Decimation{.factor = 5UZ, .mode = Decimation::Mode::Mean}.apply(mean);
+        expect(eq(mean.channelValues.elements(), std::vector<float>{1.8f, 2.2f}));
+        expect(approx(mean.channelErrors.elements()[0], 0.5f / std::sqrt(5.f), 1e-6f));
+        expect(eq(mean.channelTimeSinceRefTrigger.value(), std::vector<float>{2.f}));
+
+        TimeDomainContext context;
+        context.targetPoints = 100;
+        expect(eq(Decimation::fromContext(context, 1000UZ).factor, 20UZ)); // minmax: two points per bucket
+        expect(eq(Decimation::fromContext(context).factor, 1UZ));          // streaming applies targetPoints per update
+        context.decimationMode = "noSuchMode";
+        expect(throws<std::invalid_argument>([&context] { std::ignore = Decimation::fromContext(context); }));
+    };
+
+    "Subscription plan cache"_test = [] {
+        SubscriptionPlanCache<std::string> cache;
+        std::size_t                        nBuilt = 0UZ;
+        auto                               update = [&cache, &nBuilt](const std::vector<std::string>& topics) {
+            std::size_t nRejected = 0UZ;
+            cache.beginUpdate();
+            for (const auto& topic : topics) {
+                try {
+                    std::ignore = cache.find(topic, [&] {
+                        ++nBuilt;
+                        if (topic.contains("invalid")) {
+                            throw std::invalid_argument("invalid subscription");
+                        }
+                        return topic;
+                    });
+                } catch (const std::invalid_argument&) {
+                    ++nRejected;
+                }
+            }
+            cache.endUpdate();
+            return nRejected;
+        };
+
+        expect(eq(update({"/a?channelNameFilter=A", "/a?acquisitionModeFilter=invalid"}), 1UZ));
+        expect(eq(nBuilt, 2UZ));
+        expect(eq(update({"/a?channelNameFilter=A", "/a?acquisitionModeFilter=invalid"}), 0UZ)); // cached, the invalid subscription is rejected once
+        expect(eq(nBuilt, 2UZ));
+        expect(eq(cache.size(), 2UZ));
+        expect(eq(std::ranges::distance(cache.plans()), 1));
+
+        expect(eq(update({"/a?channelNameFilter=B"}), 0UZ)); // changed topic: new plan, the removed ones are erased
+        expect(eq(nBuilt, 3UZ));
+        expect(eq(cache.size(), 1UZ));
+        expect(eq(*cache.plans().begin(), "/a?channelNameFilter=B"s));
+
+        expect(eq(update({"/a?acquisitionModeFilter=invalid"}), 1UZ)); // a removed and re-added invalid subscription is reported again
+        expect(eq(nBuilt, 4UZ));
+        expect(eq(cache.size(), 1UZ));
+
+        cache.clear(); // flow graph change
+        expect(eq(update({"/a?channelNameFilter=B"}), 0UZ));
+        expect(eq(nBuilt, 5UZ));
+    };
+
+    "Streaming pending data"_test = [] {
+        using PendingSignal = StreamingSubscriptionState::PendingSignal;
+        using BufferPool    = opendigitizer::gnuradio::detail::BufferPool<float>;
+        BufferPool pool;
+        auto       makeChunk  = [](std::vector<float> samples, std::vector<gr::Tag> tags) { return std::make_shared<StreamingChunk>(StreamingChunk{.samples = std::move(samples), .tags = std::move(tags), .errors = {}}); };
+        auto       tagIndices = [](const PendingSignal& pending, std::size_t n) {
+            std::vector<std::size_t> indices;
+            pending.forEachTag(n, [&indices](std::size_t idx, const gr::property_map&) { indices.push_back(idx); });
+            return indices;
+        };
+
+        auto first  = makeChunk({0.f, 1.f, 2.f}, {gr::Tag{1UZ, {}}, gr::Tag{3UZ, {}}}); // index 3: behind the last sample
+        auto second = makeChunk({3.f, 4.f}, {gr::Tag{0UZ, {}}});
+
+        PendingSignal pending;
+        PendingSignal other; // second subscription of the same signal
+        for (auto* p : {&pending, &other}) {
+            p->append(first);
+            p->append(second);
+        }
+        expect(eq(pending.size(), 5UZ));
+        expect(eq(tagIndices(pending, 5UZ), std::vector<std::size_t>{1UZ, 3UZ, 3UZ}));
+
+        pending.dropFront(2UZ, pool); // partial drop within the first chunk, nothing is copied or moved
+        expect(eq(pending.size(), 3UZ));
+        expect(eq(pending.chunks.size(), 2UZ));
+        expect(eq(first->samples, std::vector<float>{0.f, 1.f, 2.f}));
+        std::vector<float> values;
+        pending.copyFront(3UZ, values);
+        expect(eq(values, std::vector<float>{2.f, 3.f, 4.f}));
+        expect(eq(tagIndices(pending, 3UZ), std::vector<std::size_t>{1UZ, 1UZ}));
+
+        pending.dropFront(1UZ, pool); // the first chunk is consumed but keeps the tag behind its last sample
+        expect(eq(pending.chunks.size(), 2UZ));
+        expect(eq(tagIndices(pending, 2UZ), std::vector<std::size_t>{0UZ, 0UZ}));
+
+        first.reset();
+        second.reset();
+        other.dropFront(4UZ, pool); // across the chunk boundary, the tag behind the first chunk belonged to a dropped sample
+        expect(eq(other.size(), 1UZ));
+        expect(eq(other.chunks.size(), 1UZ));
+        expect(tagIndices(other, 1UZ).empty());
+
+        const auto taken = pending.takeFront(2UZ, pool); // the chunk is still referenced by `other`: copied
+        expect(eq(taken, std::vector<float>{3.f, 4.f}));
+        expect(eq(other.chunks.front().chunk->samples, std::vector<float>{3.f, 4.f}));
+        pending.dropFront(2UZ, pool);
+        expect(eq(pending.size(), 0UZ));
+        expect(pending.chunks.empty());
+
+        other.append(makeChunk({5.f, 6.f}, {}));
+        other.dropFront(1UZ, pool);
+        const auto moved = other.takeFront(2UZ, pool); // sole owner of the whole chunk: moved instead of copied
+        expect(eq(moved, std::vector<float>{5.f, 6.f}));
+        expect(other.chunks.front().chunk->samples.empty());
+        other.dropFront(2UZ, pool);
+        expect(other.empty());
+    };
+
+    "Streaming held back update"_test = [] {
+        using namespace std::chrono_literals;
+        constexpr auto kInterval = 40ms; // maxClientUpdateFrequencyFilter=25
+        const auto     now       = std::chrono::steady_clock::now();
+
+        StreamingSubscriptionState state;
+        state.lastNotify = now - 10ms;
+        expect(!state.heldBackUntil(kInterval, now).has_value()) << "nothing pending";
+
+        state.pendingBySignal["Signal_A"].append(std::make_shared<StreamingChunk>(StreamingChunk{.samples = {1.f, 2.f}, .tags = {}, .errors = {}}));
+        const auto due = state.heldBackUntil(kInterval, now);
+        expect(fatal(due.has_value())) << "pending data within the rate limit interval is held back";
+        expect(*due == state.lastNotify + kInterval);
+
+        state.lastNotify = now - 50ms;
+        expect(!state.heldBackUntil(kInterval, now).has_value()) << "already due, i.e. waiting for samples rather than the limit";
+        expect(!state.heldBackUntil(0ns, now).has_value()) << "no rate limit";
+    };
+
+    "Streaming decimated"_test = [] {
+        constexpr std::string_view grc = R"(
+blocks:
+  - id: CountSource<float32>
+    parameters:
+      name: count
+      n_samples: 10000
+      sample_rate: 1000
+  - id: gr::testing::Delay<float32>
+    parameters:
+      name: delay
+      delay_ms: 600
+  - id: gr::basic::DataSink<float32>
+    parameters:
+      name: test_sink
+      signal_name: "Signal_A"
+connections:
+  - [count, 0, delay, 0]
+  - [delay, 0, test_sink, 0]
+)";
+        TestApp test;
+
+        constexpr std::size_t    kExpectedPoints = 200; // 100 buckets of 100 samples, min and max each
+        std::vector<float>       receivedData;
+        std::atomic<std::size_t> receivedCount = 0;
+
+        test.subscribeClient("/GnuRadio/Acquisition?channelNameFilter=Signal_A&decimation=100&decimationMode=minmax&implicitTimeAxis=true", [&](const Acquisition& acq) {
+            const auto samples = samplesForSignalIndex(acq.channelValues, 0);
+            expect(eq(samples.size() % 2UZ, 0UZ)) << "whole buckets only";
+            expect(eq(acq.channelTimeSinceRefTrigger.value().size(), samples.size())) << "decimated updates carry their time axis";
+            expect(std::ranges::is_sorted(acq.channelTimeSinceRefTrigger.value()));
+            receivedData.insert(receivedData.end(), samples.begin(), samples.end());
+            receivedCount = receivedData.size();
+        });
+
+        std::this_thread::sleep_for(50ms);
+        test.setGrc(grc);
+
+        waitWhile([&] { return receivedCount < kExpectedPoints; });
+
+        std::vector<float> expectedData;
+        for (std::size_t bucket = 0; bucket < 100; ++bucket) {
+            expectedData.push_back(static_cast<float>(bucket * 100));
+            expectedData.push_back(static_cast<float>(bucket * 100 + 99));
+        }
+        expect(eq(receivedData, expectedData));
+    };
+
+    "Streaming decimated to target points"_test = [] {
+        constexpr std::string_view grc = R"(
+blocks:
+  - id: CountSource<float32>
+    parameters:
+      name: count
+      n_samples: 10000
+      sample_rate: 1000
+  - id: gr::testing::Delay<float32>
+    parameters:
+      name: delay
+      delay_ms: 600
+  - id: gr::basic::DataSink<float32>
+    parameters:
+      name: test_sink
+      signal_name: "Signal_A"
+connections:
+  - [count, 0, delay, 0]
+  - [delay, 0, test_sink, 0]
+)";
+        TestApp test;
+
+        constexpr std::size_t    kTargetPoints = 20;
+        std::mutex               receivedMutex;
+        std::vector<float>       receivedData;
+        std::size_t              maxUpdateSize = 0UZ;
+        std::atomic<bool>        receivedLast  = false;
+        std::atomic<std::size_t> receivedCount = 0;
+
+        test.subscribeClient(std::format("/GnuRadio/Acquisition?channelNameFilter=Signal_A&targetPoints={}&decimationMode=minmax", kTargetPoints), [&](const Acquisition& acq) {
+            const auto      samples = samplesForSignalIndex(acq.channelValues, 0);
+            std::lock_guard lock(receivedMutex);
+            maxUpdateSize = std::max(maxUpdateSize, samples.size());
+            receivedData.insert(receivedData.end(), samples.begin(), samples.end());
+            receivedCount = receivedData.size();
+            receivedLast  = receivedLast || std::ranges::find(samples, 9999.f) != samples.end();
+        });
+
+        std::this_thread::sleep_for(50ms);
+        test.setGrc(grc);
+
+        waitWhile([&] { return !receivedLast; });
+
+        std::lock_guard lock(receivedMutex);
+        expect(le(maxUpdateSize, kTargetPoints)) << "each Continuous update is reduced to targetPoints";
+        expect(lt(receivedCount.load(), 10000UZ)) << "the stream must have been decimated";
+        expect(fatal(!receivedData.empty()));
+        expect(eq(receivedData.front(), 0.f)) << "the first bucket's minimum";
+        expect(std::ranges::is_sorted(receivedData)) << "the envelope of a ramp keeps the sample order";
+    };
+
+    "Spectrum"_test = [] {
+        constexpr std::string_view grc = R"(
+blocks:
+  - id: CountSource<float32>
+    parameters:
+      name: count
+      n_samples: 50000
+      initial_value: 10000
+      sample_rate: 1000
+  - id: gr::testing::Delay<float32>
+    parameters:
+      name: delay
+      delay_ms: 600
+  - id: gr::basic::DataSink<float32>
+    parameters:
+      name: test_sink
+      signal_name: "Signal_A"
+      sample_rate: 1000
+connections:
+  - [count, 0, delay, 0]
+  - [delay, 0, test_sink, 0]
+)";
+
+        TestApp test;
+
+        std::mutex                      receivedMutex;
+        std::vector<AcquisitionSpectra> receivedSpectra;
+        std::atomic<std::size_t>        receivedCount = 0;
+        // two subscribers with identical FFT settings share one computation, the third one uses its own
+        for (std::string_view params : {"fftSize=256&decimation=2&averaging=2"sv, "fftSize=256&decimation=2&averaging=2&maxClientUpdateFrequencyFilter=10"sv, "fftSize=128"sv}) {
+            test.subscribeSpectrumClient(std::format("/GnuRadio/AcquisitionSpectra?channelNameFilter=Signal_A&{}", params), [&](const AcquisitionSpectra& spectra) {
+                std::lock_guard lock(receivedMutex);
+                receivedSpectra.push_back(spectra);
+                receivedCount = receivedSpectra.size();
+            });
+        }
+
+        std::this_thread::sleep_for(50ms);
+        test.setGrc(grc);
+
+        waitWhile([&] { return receivedCount < 3; });
+
+        std::lock_guard lock(receivedMutex);
+        for (const auto& spectra : receivedSpectra) {
+            const auto nBins = spectra.channelMagnitude.size();
+            expect(nBins == 128UZ || nBins == 64UZ);
+            expect(eq(spectra.channelName.value(), "Signal_A"s));
+            expect(eq(spectra.channelPhase.size(), nBins));
+            expect(eq(spectra.channelMagnitude_dim2_labels.size(), nBins));
+            expect(eq(spectra.channelMagnitude_dimensions.value(), std::vector<std::int32_t>{1, static_cast<std::int32_t>(nBins)}));
+            const float expectedBinWidth = nBins == 128UZ ? 1000.f / (2.f * 256.f) : 1000.f / 128.f;
+            expect(approx(spectra.channelMagnitude_dim2_labels[1] - spectra.channelMagnitude_dim2_labels[0], expectedBinWidth, 1e-3f));
+            // the offset counting ramp is dominated by its mean value
+            const auto& magnitude = spectra.channelMagnitude.value();
+            expect(eq(std::distance(magnitude.begin(), std::ranges::max_element(magnitude)), 0));
+        }
+    };
+
+    "Spectrum sample rate from sink settings"_test = [] {
+        // ForeverSource publishes no sample_rate tags, the spectra must use the sample_rate setting of the sink
+        constexpr std::string_view grcTemplate = R"(
+blocks:
+  - id: ForeverSource<float32>
+    parameters:
+      name: source
+  - id: gr::basic::DataSink<float32>
+    parameters:
+      name: test_sink
+      signal_name: "Signal_A"
+      sample_rate: {}
+connections:
+  - [source, 0, test_sink, 0]
+)";
+        TestApp test;
+
+        std::atomic<float> lastBinWidth = 0.f;
+        test.subscribeSpectrumClient("/GnuRadio/AcquisitionSpectra?channelNameFilter=Signal_A&fftSize=128", [&lastBinWidth](const AcquisitionSpectra& spectra) {
+            const auto& frequencies = spectra.channelMagnitude_dim2_labels.value();
+            expect(fatal(ge(frequencies.size(), 2UZ)));
+            lastBinWidth = frequencies[1] - frequencies[0];
+        });
+
+        std::this_thread::sleep_for(50ms);
+        test.setGrc(std::format(grcTemplate, 1000));
+        waitWhile([&] { return lastBinWidth.load() == 0.f; });
+        expect(approx(lastBinWidth.load(), 1000.f / 128.f, 1e-3f));
+
+        // the replacement graph starts with fresh spectra using its own sink settings
+        test.setGrc(std::format(grcTemplate, 2000));
+        waitWhile([&] { return std::abs(lastBinWidth.load() - 2000.f / 128.f) > 1e-3f; });
+    };
+
     "Flow graph management"_test = [] {
         constexpr std::string_view grc1 = R"(
 blocks:
@@ -586,6 +1303,74 @@ connections:
         expect(eq(receivedDownData, expectedDownData));
     };
 
+    "Flow graph scheduler section"_test = [] {
+        expect(eq(parseCpuList(""), std::vector<std::size_t>{}));
+        expect(eq(parseCpuList("0-3,6,2"), std::vector<std::size_t>{0, 1, 2, 3, 6}));
+        expect(throws<std::invalid_argument>([] { std::ignore = parseCpuList("3-1"); }));
+        expect(throws<std::invalid_argument>([] { std::ignore = parseCpuList("a"); }));
+
+        const auto config = SchedulerConfig{}.withOverrides({{"policy", "multiThreaded"s}, {"threads", 4}, {"cpu_affinity", "0-1"s}});
+        expect(config.policy == gr::scheduler::ExecutionPolicy::multiThreaded);
+        expect(eq(config.threads.value_or(0UZ), 4UZ));
+        expect(eq(config.cpuAffinity, std::vector<std::size_t>{0, 1}));
+        expect(config.customPool());
+        expect(SchedulerConfig{}.withOverrides({}) == SchedulerConfig{});
+        expect(!SchedulerConfig{}.customPool()); // the service's default pool is kept
+        expect(!SchedulerConfig{}.withOverrides({{"policy", "multiThreaded"s}}).customPool());
+        expect(SchedulerConfig{}.withOverrides({{"cpu_affinity", "0"s}}).customPool());
+        expect(throws<std::invalid_argument>([] { std::ignore = opendigitizer::gnuradio::detail::makeScheduler(static_cast<gr::scheduler::ExecutionPolicy>(-1), gr::Graph{}); }));
+        expect(throws<std::invalid_argument>([] { std::ignore = SchedulerConfig{}.withOverrides({{"policy", "noSuchPolicy"s}}); }));
+
+        constexpr std::string_view grc = R"(
+scheduler:
+  policy: multiThreaded
+  threads: 2
+blocks:
+  - id: CountSource<float32>
+    parameters:
+      name: count
+      n_samples: 100
+  - id: gr::testing::Delay<float32>
+    parameters:
+      name: delay
+      delay_ms: 600
+  - id: gr::basic::DataSink<float32>
+    parameters:
+      name: test_sink
+      signal_name: "Signal_A"
+connections:
+  - [count, 0, delay, 0]
+  - [delay, 0, test_sink, 0]
+)";
+        const auto servicePool = gr::thread_pool::Manager::defaultCpuPool();
+        {
+            TestApp test;
+
+            std::vector<float>       receivedData;
+            std::atomic<std::size_t> receivedCount = 0;
+            test.subscribeClient("/GnuRadio/Acquisition?channelNameFilter=Signal_A", [&receivedData, &receivedCount](const auto& acq) {
+                const auto samples = samplesForSignalIndex(acq.channelValues, 0);
+                receivedData.insert(receivedData.end(), samples.begin(), samples.end());
+                receivedCount = receivedData.size();
+            });
+
+            std::this_thread::sleep_for(50ms);
+            test.setGrc(grc);
+            waitWhile([&] { return receivedCount < 100; });
+            expect(eq(receivedData, getIota(100)));
+            expect(gr::thread_pool::Manager::defaultCpuPool() != servicePool) << "graph with `threads` runs on its own pool";
+
+            // invalid scheduler settings are rejected with the request
+            std::atomic<bool> receivedReply = false;
+            test.setGrc(std::string(grc).replace(grc.find("multiThreaded"), "multiThreaded"sv.size(), "noSuchPolicy"), [&receivedReply](const auto& reply) {
+                expect(!reply.error.empty());
+                receivedReply = true;
+            });
+            waitWhile([&receivedReply] { return !receivedReply.load(); });
+        }
+        expect(gr::thread_pool::Manager::defaultCpuPool() == servicePool) << "the worker must hand the process-wide pool back";
+    };
+
     "Flow graph management non-terminating graphs"_test = [] {
         constexpr std::string_view grc1 = R"(
 blocks:
@@ -705,6 +1490,78 @@ connections:
         expect(eq(receivedData, getIota(20, 45)));
     };
 
+    "Trigger - shared poller with different windows"_test = [] {
+        // subscriber windows are cut around the actual trigger of the DataSet, which is post_samples of its poller before the end
+        const auto polled = [](std::size_t nSamples, std::size_t postSamples) {
+            DataSetPollerEntry::PolledDataSet result{.postSamples = postSamples};
+            result.dataSet.axis_values = {std::vector<float>(nSamples, 0.f)};
+            return result;
+        };
+        TimeDomainContext narrow;
+        narrow.preSamples  = 2;
+        narrow.postSamples = 3;
+        TimeDomainContext wide;
+        wide.preSamples  = 10;
+        wide.postSamples = 5;
+        expect(DataSetPollerEntry::subscriberWindow(AcquisitionMode::Triggered, narrow, polled(15UZ, 5UZ)) == std::pair{8UZ, 5UZ});
+        expect(DataSetPollerEntry::subscriberWindow(AcquisitionMode::Triggered, narrow, polled(9UZ, 5UZ)) == std::pair{2UZ, 5UZ}) << "history shorter than pre_samples";
+        expect(DataSetPollerEntry::subscriberWindow(AcquisitionMode::Triggered, narrow, polled(6UZ, 3UZ)) == std::pair{1UZ, 5UZ}) << "DataSet of a replaced, narrower poller";
+        expect(DataSetPollerEntry::subscriberWindow(AcquisitionMode::Triggered, wide, polled(9UZ, 5UZ)) == std::pair{0UZ, 9UZ});
+        expect(DataSetPollerEntry::subscriberWindow(AcquisitionMode::Triggered, wide, polled(6UZ, 3UZ)) == std::pair{0UZ, 6UZ});
+
+        constexpr std::string_view grc = R"(
+blocks:
+  - id: CountSource<float32>
+    parameters:
+      name: count
+      n_samples: 100
+      timing_tags: !!str
+        - 40,notatrigger
+        - 50,hello
+        - 60,ignoreme
+  - id: gr::testing::Delay<float32>
+    parameters:
+      name: delay
+      delay_ms: 600
+  - id: gr::basic::DataSink<float32>
+    parameters:
+      name: test_sink
+      signal_name: "Signal_A"
+connections:
+  - [count, 0, delay, 0]
+  - [delay, 0, test_sink, 0]
+)";
+
+        TestApp test;
+
+        std::vector<float>       receivedWide;
+        std::atomic<std::size_t> receivedWideCount = 0;
+        std::vector<float>       receivedNarrow;
+        std::atomic<std::size_t> receivedNarrowCount = 0;
+
+        test.subscribeClient("/GnuRadio/Acquisition?channelNameFilter=Signal_A&acquisitionModeFilter=triggered&triggerNameFilter=hello&preSamples=5&postSamples=15", [&receivedWide, &receivedWideCount](const auto& acq) {
+            expect(eq(acq.refTriggerName.value(), "hello"sv));
+            const auto samples = samplesForSignalIndex(acq.channelValues, 0);
+            receivedWide.insert(receivedWide.end(), samples.begin(), samples.end());
+            receivedWideCount = receivedWide.size();
+        });
+        test.subscribeClient("/GnuRadio/Acquisition?channelNameFilter=Signal_A&acquisitionModeFilter=triggered&triggerNameFilter=hello&preSamples=2&postSamples=3", [&receivedNarrow, &receivedNarrowCount](const auto& acq) {
+            expect(eq(acq.refTriggerName.value(), "hello"sv));
+            const auto samples = samplesForSignalIndex(acq.channelValues, 0);
+            expect(eq(acq.channelTimeSinceRefTrigger.size(), samples.size()));
+            receivedNarrow.insert(receivedNarrow.end(), samples.begin(), samples.end());
+            receivedNarrowCount = receivedNarrow.size();
+        });
+
+        std::this_thread::sleep_for(50ms);
+        test.setGrc(grc);
+
+        waitWhile([&] { return receivedWideCount < 20 || receivedNarrowCount < 5; });
+
+        expect(eq(receivedWide, getIota(20, 45)));
+        expect(eq(receivedNarrow, getIota(5, 48)));
+    };
+
     "Trigger - sparse tags"_test = [] {
         // Tests that tags detection and offsets work when the tag data is spread among multiple threads
         constexpr std::string_view grc = R"(
@@ -1133,6 +1990,14 @@ connections:
         expect(eq(acq.chainStartStamp.value(), 1000LL));
         expect(eq(acq.sequenceStartStamp.value(), 1000LL));
         expect(eq(acq.processStartStamp.value(), 1200LL));
+
+        // channels packed into one reply report the most recent event any of them has seen
+        TimingEventState other;
+        expect(&TimingEventState::mostRecent(state, other) == &state) << "invalid states never win";
+        expect(&TimingEventState::mostRecent(other, state) == &state);
+        other.updateFromTags(std::array{gr::Tag{0, makeFairTimingTagMap(1300, 778)}});
+        expect(&TimingEventState::mostRecent(state, other) == &other);
+        expect(&TimingEventState::mostRecent(other, state) == &other);
     };
 };
 
@@ -20,6 +20,7 @@
 #endif
 
 #include <algorithm>
+#include <cstdint>
 #include <format>
 #include <fstream>
 #include <thread>
@@ -39,6 +40,7 @@
 #include "dashboard/dashboardWorker.hpp"
 #include "gnuradio/GnuRadioAcquisitionWorker.hpp"
 #include "gnuradio/GnuRadioFlowgraphWorker.hpp"
+#include "gnuradio/GnuRadioSpectrumWorker.hpp"
 
 #include <version.hpp>
 
@@ -81,7 +83,8 @@ using namespace opencmw::majordomo;
 
 void registerDefaultThreadPool() {
     using namespace gr::thread_pool;
-    Manager::instance().replacePool(std::string(kDefaultCpuPoolId), std::make_shared<ThreadPoolWrapper>(std::make_unique<BasicThreadPool>(std::string(kDefaultCpuPoolId), TaskType::CPU_BOUND, 2U, 2U), "CPU"));
+    constexpr auto nThreads = static_cast<std::uint32_t>(opendigitizer::gnuradio::SchedulerConfig::kDefaultThreads);
+    Manager::instance().replacePool(std::string(kDefaultCpuPoolId), std::make_shared<ThreadPoolWrapper>(std::make_unique<BasicThreadPool>(std::string(kDefaultCpuPoolId), TaskType::CPU_BOUND, nThreads, nThreads), "CPU"));
 }
 
 std::unique_ptr<Broker<>> setupBroker(const Digitizer::Settings& settings) {
@@ -230,6 +233,19 @@ connections:
     Digitizer::Settings& settings = Digitizer::Settings::instance();
 
     registerDefaultThreadPool();
+
+    // the acquisition worker replaces the CPU pool only if threads or CPUs are configured, the `scheduler:` section of the GRC may override these defaults
+    SchedulerConfig schedulerConfig;
+    try {
+        schedulerConfig = SchedulerConfig{}.withOverrides({{"policy", settings.schedulerPolicy}, {"cpu_affinity", settings.schedulerCpuAffinity}});
+        if (settings.schedulerThreads > 0UZ) {
+            schedulerConfig = schedulerConfig.withOverrides({{"threads", settings.schedulerThreads}});
+        }
+    } catch (const std::invalid_argument& e) {
+        std::println(stderr, "Invalid scheduler settings: {}", e.what());
+        return 1;
+    }
+
     auto broker = setupBroker(settings);
     if (broker == nullptr) {
         return 1;
@@ -261,13 +277,16 @@ connections:
     opencmw::OAuthWorker oauthWorker{opencmw::URI(redirectBase), opencmw::URI(kcBase + "/realms/testrealm/protocol/openid-connect/auth"), opencmw::URI(kcBase + "/realms/testrealm/protocol/openid-connect/token"), opencmw::URI(kcBase + "/realms/testrealm/protocol/openid-connect/userinfo"), *broker};
     std::jthread         oauthWorkerThread([&oauthWorker] { oauthWorker.run(); });
 
-    using GrAcqWorker = GnuRadioAcquisitionWorker<"/GnuRadio/Acquisition", description<"Provides data from a GnuRadio flow graph execution">>;
-    using GrFgWorker  = GnuRadioFlowGraphWorker<GrAcqWorker, "/flowgraph", description<"Provides access to the GnuRadio flow graph">>;
+    using GrAcqWorker      = GnuRadioAcquisitionWorker<"/GnuRadio/Acquisition", description<"Provides data from a GnuRadio flow graph execution">>;
+    using GrFgWorker       = GnuRadioFlowGraphWorker<GrAcqWorker, "/flowgraph", description<"Provides access to the GnuRadio flow graph">>;
+    using GrSpectrumWorker = GnuRadioSpectrumWorker<"/GnuRadio/AcquisitionSpectra", description<"Provides spectra of the GnuRadio flow graph signals">>;
     gr::BlockRegistry registry;
     registerTestBlocks(registry);
     gr::PluginLoader                                       pluginLoader(registry, gr::globalSchedulerRegistry(), {});
-    GrAcqWorker                                            grAcqWorker(*broker, &pluginLoader, 50ms);
+    const auto                                             notifyMode = settings.eventDrivenNotify ? NotifyMode::EventDriven : NotifyMode::Polling;
+    GrAcqWorker                                            grAcqWorker(*broker, &pluginLoader, settings.eventDrivenNotify ? 1000ms : 50ms, notifyMode, schedulerConfig);
     GrFgWorker                                             grFgWorker(*broker, &pluginLoader, opendigitizer::flowgraph::Flowgraph{grc, {}}, grAcqWorker);
+    GrSpectrumWorker                                       grSpectrumWorker(*broker, 50ms);
     std::optional<opencmw::majordomo::load_test::Worker<>> loadTestWorker{};
     if (loadTest) {
         loadTestWorker.emplace(*broker);
@@ -284,7 +303,8 @@ connections:
     const auto restUrl = settings.serviceUrl().build();
 
     std::vector<SignalEntry> registeredSignals;
-    grAcqWorker.setUpdateSignalEntriesCallback([&registeredSignals, &dns_client, &restUrl](std::vector<SignalEntry> signals) {
+    grAcqWorker.setUpdateSignalEntriesCallback([&registeredSignals, &dns_client, &restUrl, &grSpectrumWorker](std::vector<SignalEntry> signals) {
+        grSpectrumWorker.setSignalEntries(signals);
         if (::getenv("OPENDIGITIZER_LOAD_TEST_SIGNALS")) {
             size_t x = 0;
             for (auto& i : fair::testDeviceNames) {
@@ -339,6 +359,7 @@ connections:
 
     std::jthread                grAcqWorkerThread([&grAcqWorker] { grAcqWorker.run(); });
     std::jthread                grFgWorkerThread([&grFgWorker] { grFgWorker.run(); });
+    std::jthread                grSpectrumWorkerThread([&grSpectrumWorker] { grSpectrumWorker.run(); });
     std::optional<std::jthread> loadTestWorkerThread{};
     if (loadTestWorker && loadTest) {
         loadTestWorkerThread.emplace([&loadTestWorker] { loadTestWorker->run(); });
@@ -352,7 +373,10 @@ connections:
     oauthWorkerThread.join();
     grAcqWorkerThread.join();
     grFgWorkerThread.join();
+    grSpectrumWorkerThread.join();
     if (loadTestWorkerThread) {
         loadTestWorkerThread->join();
     }
+    // ~GnuRadioAcquisitionWorker reports an empty signal list, the spectrum worker and the DNS client are gone by then
+    grAcqWorker.setUpdateSignalEntriesCallback({});
 }
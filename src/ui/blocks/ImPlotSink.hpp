@@ -6,15 +6,19 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cmath>
+#include <deque>
 #include <expected>
 #include <format>
 #include <functional>
 #include <limits>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <gnuradio-4.0/Block.hpp>
@@ -35,8 +39,11 @@
 #include "conversion.hpp"
 
 #include "../charts/Chart.hpp"
+#include "../charts/ImplicitTimeAxis.hpp"
+#include "../charts/MinMaxPyramid.hpp"
 #include "../charts/SignalSink.hpp"
 #include "../charts/SinkRegistry.hpp"
+#include "../charts/TagIndex.hpp"
 #include "../utils/EmscriptenHelper.hpp"
 
 namespace opendigitizer {
@@ -112,17 +119,68 @@ struct ImPlotSink : gr::Block<ImPlotSink<T>, gr::Drawable<gr::UICategory::Conten
         return duration<double, std::nano>(now).count() * 1e-9;
     }(); // utc timestamp of the last tag or first sample
     bool                      _xUtcOffsetInitialised = false; // set to true after first Tag with TRIGGER_TIME arrives and the _xUtcOffset is set
-    gr::HistoryBuffer<double> _xValues{required_size};        // needs to be 'double' because of required ns-level UTC timestamp precision
+    charts::ImplicitTimeAxis  _xValues{IsStreaming ? static_cast<std::size_t>(required_size) : 0UZ}; // 'double' (ns-level UTC precision) generated from per-segment anchors
     gr::HistoryBuffer<T>      _yValues{required_size};
-    std::deque<TagData>       _tagValues{};
+    charts::TagIndex<TagData> _tagValues{}; // sorted by timestamp
 
-    double      _sample_period = 1.0 / static_cast<double>(sample_rate);
-    std::size_t _sample_count  = 0UZ;
+    // min/max summaries of _yValues (streaming only), lets charts fetch the envelope of any range in O(log(range))
+    charts::MinMaxPyramid<ValueType> _yPyramid{IsStreaming ? static_cast<std::size_t>(required_size) : 0UZ};
+
+    // signal value range of each DataSet in _yValues (same order), computed once on arrival instead of every frame
+    gr::HistoryBuffer<std::pair<ValueType, ValueType>> _dataSetYRanges{IsDataSet ? static_cast<std::size_t>(required_size) : 1UZ};
+
+    double      _sample_period        = 1.0 / static_cast<double>(sample_rate);
+    std::size_t _sample_count         = 0UZ; // producer-side sample counter (X time base)
+    std::size_t _publishedSampleCount = 0UZ; // samples published since creation, guarded by _dataMutex
+    std::size_t _dataGeneration       = 0UZ; // bumped on every change of _xValues/_yValues/_tagValues, guarded by _dataMutex
 
     // shared mutex for thread-safe data access between processBulk() and draw()
     // shared_ptr so SinkAdapter can safely hold a reference that outlives the block
     std::shared_ptr<std::mutex> _dataMutex = std::make_shared<std::mutex>();
 
+    // segment received by processBulk() while a renderer held _dataMutex and not yet published to _xValues/_yValues/_tagValues:
+    // the producer never waits for that lock, it publishes the input span straight into the history buffers when it gets the
+    // lock without blocking and only stages it here otherwise, the next holder of the lock (reader or producer) publishes it;
+    // guarded by _pendingMutex, which is only held for appending and publishing, lock order _dataMutex -> _pendingMutex
+    struct PendingSegment {
+        std::vector<charts::ImplicitTimeAxis::Run> x;
+        std::vector<T>                             y;
+        std::vector<TagData>                       tags;
+
+        [[nodiscard]] bool empty() const noexcept { return y.empty() && tags.empty(); }
+    };
+    PendingSegment       _pending;
+    std::mutex           _pendingMutex;
+    std::vector<TagData> _inputTags; // tags of the span processBulk() is working on (producer only, keeps its capacity)
+
+    // plot-ready copy of the data, taken under _dataMutex at the start of draw() so that ImPlot renders without the lock (UI thread
+    // only); the streaming trace is M4-decimated to the plot's pixel columns, i.e. its size follows the plot width, not required_size
+    struct DrawSnapshot {
+        std::size_t                                 generation  = std::numeric_limits<std::size_t>::max(); // _dataGeneration it was taken at
+        bool                                        withTags    = false;
+        AxisScale                                   axisScale   = AxisScale::Linear;
+        double                                      columnWidth = 0.0; // X extent of one pixel column of the plot it was taken for
+        double                                      xFirst      = 0.0; // streaming: X of the oldest and newest retained sample
+        double                                      xLast       = 0.0;
+        std::vector<double>                         x;        // streaming, transformed for axisScale
+        std::vector<double>                         y;
+        std::vector<TagData>                        tags;     // streaming tags within [xFirst, xLast]
+        std::deque<T>                               dataSets; // newest first, at most n_history, only DataSets published since the last frame are copied
+        std::deque<std::pair<ValueType, ValueType>> dataSetYRanges;
+        std::size_t                                 publishedCount = 0UZ; // _publishedSampleCount the DataSet copy is up to date with
+
+        /// whether the streaming trace has to be re-decimated for a plot with `otherColumnWidth` (zoom or plot size changed),
+        /// panning alone is caught up with when the next data arrives
+        [[nodiscard]] bool viewDiffers(AxisScale otherScale, double otherColumnWidth) const noexcept { return axisScale != otherScale || std::abs(columnWidth - otherColumnWidth) > 0.01 * std::max(columnWidth, otherColumnWidth); }
+    };
+    DrawSnapshot _drawSnapshot;
+
+    // beyond kMaxPendingBuffers buffer capacities (i.e. a renderer that stopped releasing the lock), processBulk() falls back to waiting
+    static constexpr std::size_t kMaxPendingBuffers = 4UZ;
+
+    // required_size as of its last update under _dataMutex, read by processBulk() when it could not take that lock
+    std::atomic<std::size_t> _capacitySnapshot{static_cast<std::size_t>(required_size)};
+
     // capacity request tracking with auto-expiry
     struct CapacityRequest {
         std::size_t                                        capacity;
@@ -140,7 +198,11 @@ struct ImPlotSink : gr::Block<ImPlotSink<T>, gr::Drawable<gr::UICategory::Conten
 
     ~ImPlotSink() {
         if (_sinkAdapter) {
-            static_cast<SinkAdapter<ImPlotSink<T>>*>(_sinkAdapter.get())->invalidate();
+            {
+                // waits for holders of the data lock, e.g. render-prep jobs, which re-check the adapter's block under it
+                std::lock_guard lock(*_dataMutex);
+                static_cast<SinkAdapter<ImPlotSink<T>>*>(_sinkAdapter.get())->invalidate();
+            }
             charts::SinkRegistry::instance().unregisterSink(this->unique_name);
         }
     }
@@ -157,10 +219,13 @@ struct ImPlotSink : gr::Block<ImPlotSink<T>, gr::Drawable<gr::UICategory::Conten
 
         {
             std::lock_guard lock(*_dataMutex);
-            if (_xValues.capacity() != required_size || _yValues.capacity() != required_size) {
-                _xValues.resize(required_size);
+            _capacitySnapshot.store(static_cast<std::size_t>(required_size), std::memory_order_relaxed);
+            ++_dataGeneration; // e.g. n_history, which selects what draw() copies
+            if (_yValues.capacity() != required_size) {
+                _xValues.resize(IsStreaming ? static_cast<std::size_t>(required_size) : 0UZ);
                 _yValues.resize(required_size);
                 _tagValues.clear();
+                rebuildSummaries();
             }
         }
 
@@ -202,7 +267,7 @@ struct ImPlotSink : gr::Block<ImPlotSink<T>, gr::Drawable<gr::UICategory::Conten
         }
     }
 
-    [[nodiscard]] std::size_t totalSampleCount() const noexcept { return _sample_count; }
+    [[nodiscard]] std::size_t totalSampleCount() const noexcept { return _publishedSampleCount; }
 
     [[nodiscard]] std::size_t size() const noexcept {
         if constexpr (IsStreaming) {
@@ -222,7 +287,7 @@ struct ImPlotSink : gr::Block<ImPlotSink<T>, gr::Drawable<gr::UICategory::Conten
 
     [[nodiscard]] double xAt(std::size_t i) const {
         if constexpr (IsStreaming) {
-            return _xValues.get_span(0)[i];
+            return _xValues[i];
         } else if constexpr (IsDataSet) {
             if (_yValues.empty()) {
                 return 0.0;
@@ -261,13 +326,49 @@ struct ImPlotSink : gr::Block<ImPlotSink<T>, gr::Drawable<gr::UICategory::Conten
         return 0.0f;
     }
 
+    /// [startIndex, startIndex + count): Y as a view into the HistoryBuffer (no copy for float samples), X is not materialised but
+    /// read from the segment anchors via SampleSpans::xAt()/fillX() (caller must hold the data mutex)
+    [[nodiscard]] SignalSink::SampleSpans samples(std::size_t startIndex, std::size_t count) const
+    requires IsStreaming
+    {
+        const auto ySpan = _yValues.get_span(0).subspan(startIndex, count);
+        if constexpr (std::is_same_v<ValueType, float>) {
+            return {.x = {}, .y = ySpan, ._xStorage = {}, ._yStorage = {}, .xAxis = &_xValues, .xAxisStart = startIndex};
+        } else {
+            auto storage = std::make_shared<std::vector<float>>(ySpan.size());
+            std::ranges::transform(ySpan, storage->begin(), [](ValueType y) { return static_cast<float>(y); });
+            return {.x = {}, .y = std::span<const float>(*storage), ._xStorage = {}, ._yStorage = std::move(storage), .xAxis = &_xValues, .xAxisStart = startIndex};
+        }
+    }
+
+    /// min/max of the Y values in [startIndex, startIndex + count) via the min/max pyramid (caller must hold the data mutex)
+    [[nodiscard]] SignalSink::YExtrema yExtrema(std::size_t startIndex, std::size_t count) const
+    requires IsStreaming
+    {
+        const auto        ySpan    = _yValues.get_span(0);
+        const std::size_t absFirst = _yPyramid.count() - ySpan.size(); // absolute index of ySpan[0]
+        const auto        extrema  = _yPyramid.extrema(absFirst + startIndex, count, [&ySpan, absFirst](std::size_t absIndex) { return ySpan[absIndex - absFirst]; });
+        return {.min_index = extrema.minIndex - absFirst, .max_index = extrema.maxIndex - absFirst, .min = static_cast<float>(extrema.min), .max = static_cast<float>(extrema.max)};
+    }
+
+    /// re-seeds the pyramid from the retained samples and re-aligns the per-DataSet ranges after the buffers were resized
+    void rebuildSummaries() {
+        ++_dataGeneration;
+        if constexpr (IsStreaming) {
+            _yPyramid.reset(_yValues.capacity());
+            _yPyramid.pushRange(_yValues.get_span(0));
+        }
+        if constexpr (IsDataSet) {
+            _dataSetYRanges.resize(_yValues.capacity()); // keeps the newest entries, like _yValues
+        }
+    }
+
     [[nodiscard]] PlotData plotData() const {
         if constexpr (IsStreaming) {
             static auto getter = +[](int idx, void* userData) -> PlotPoint {
                 auto* self  = static_cast<const ImPlotSink*>(userData);
-                auto  xSpan = self->_xValues.get_span(0);
                 auto  ySpan = self->_yValues.get_span(0);
-                return {xSpan[static_cast<std::size_t>(idx)], static_cast<double>(ySpan[static_cast<std::size_t>(idx)])};
+                return {self->_xValues[static_cast<std::size_t>(idx)], static_cast<double>(ySpan[static_cast<std::size_t>(idx)])};
             };
             return {getter, const_cast<ImPlotSink*>(this), static_cast<int>(_xValues.size())};
         } else if constexpr (IsDataSet) {
@@ -331,16 +432,24 @@ struct ImPlotSink : gr::Block<ImPlotSink<T>, gr::Drawable<gr::UICategory::Conten
         }
     }
 
+    void forEachTagInRange(double tMin, double tMax, std::function<void(double, const gr::property_map&)> callback) const {
+        if constexpr (IsStreaming) {
+            for (const auto& tag : _tagValues.range(tMin, tMax)) {
+                callback(tag.timestamp, tag.map);
+            }
+        }
+    }
+
     [[nodiscard]] double timeFirst() const noexcept {
         if constexpr (IsStreaming) {
-            return _xValues.empty() ? 0.0 : _xValues.get_span(0).front();
+            return _xValues.empty() ? 0.0 : _xValues.front();
         }
         return 0.0;
     }
 
     [[nodiscard]] double timeLast() const noexcept {
         if constexpr (IsStreaming) {
-            return _xValues.empty() ? 0.0 : _xValues.get_span(0).back();
+            return _xValues.empty() ? 0.0 : _xValues.back();
         }
         return 0.0;
     }
@@ -349,7 +458,11 @@ struct ImPlotSink : gr::Block<ImPlotSink<T>, gr::Drawable<gr::UICategory::Conten
 
     void requestCapacity(std::string_view source, std::size_t capacity, std::chrono::seconds timeout = std::chrono::seconds{60}) {
         std::lock_guard lock(*_dataMutex);
+        requestCapacityLocked(source, capacity, timeout);
+    }
 
+    /// requestCapacity() for callers already holding the data mutex
+    void requestCapacityLocked(std::string_view source, std::size_t capacity, std::chrono::seconds timeout) {
         auto expiry_time                       = std::chrono::steady_clock::now() + timeout;
         _capacityRequests[std::string(source)] = CapacityRequest{capacity, expiry_time};
 
@@ -360,14 +473,21 @@ struct ImPlotSink : gr::Block<ImPlotSink<T>, gr::Drawable<gr::UICategory::Conten
         }
         if (maxCapacity != static_cast<std::size_t>(required_size)) {
             required_size = static_cast<gr::Size_t>(maxCapacity);
-            _xValues.resize(required_size);
+            _capacitySnapshot.store(maxCapacity, std::memory_order_relaxed);
+            _xValues.resize(IsStreaming ? static_cast<std::size_t>(required_size) : 0UZ);
             _yValues.resize(required_size);
+            rebuildSummaries();
         }
     }
 
     void expireCapacityRequests() {
         std::lock_guard lock(*_dataMutex);
-        auto            now = std::chrono::steady_clock::now();
+        expireCapacityRequestsLocked();
+    }
+
+    /// expireCapacityRequests() for callers already holding the data mutex
+    void expireCapacityRequestsLocked() {
+        auto now = std::chrono::steady_clock::now();
 
         std::erase_if(_capacityRequests, [now](const auto& pair) { return pair.second.expiry_time < now; });
 
@@ -377,6 +497,7 @@ struct ImPlotSink : gr::Block<ImPlotSink<T>, gr::Drawable<gr::UICategory::Conten
             maxCapacity = std::max(maxCapacity, request.capacity);
         }
         required_size = static_cast<gr::Size_t>(maxCapacity);
+        _capacitySnapshot.store(maxCapacity, std::memory_order_relaxed);
     }
 
     [[nodiscard]] SignalSink::DataRange getXRange(double tMin, double tMax) const {
@@ -384,16 +505,13 @@ struct ImPlotSink : gr::Block<ImPlotSink<T>, gr::Drawable<gr::UICategory::Conten
             if (_xValues.empty()) {
                 return {0, 0};
             }
-            auto xSpan = _xValues.get_span(0);
             // Binary search for range bounds
-            auto itBegin = std::lower_bound(xSpan.begin(), xSpan.end(), tMin);
-            auto itEnd   = std::upper_bound(xSpan.begin(), xSpan.end(), tMax);
-            if (itBegin >= itEnd) {
+            const std::size_t startIdx = _xValues.lowerBound(tMin);
+            const std::size_t endIdx   = _xValues.upperBound(tMax);
+            if (startIdx >= endIdx) {
                 return {0, 0};
             }
-            std::size_t startIdx = static_cast<std::size_t>(std::distance(xSpan.begin(), itBegin));
-            std::size_t count    = static_cast<std::size_t>(std::distance(itBegin, itEnd));
-            return {startIdx, count};
+            return {startIdx, endIdx - startIdx};
         }
         return {0, 0};
     }
@@ -403,16 +521,12 @@ struct ImPlotSink : gr::Block<ImPlotSink<T>, gr::Drawable<gr::UICategory::Conten
             if (_tagValues.empty()) {
                 return {0, 0};
             }
-            // Find first tag >= tMin
-            auto itBegin = std::find_if(_tagValues.begin(), _tagValues.end(), [tMin](const TagData& tag) { return tag.timestamp >= tMin; });
-            // Find first tag > tMax
-            auto itEnd = std::find_if(itBegin, _tagValues.end(), [tMax](const TagData& tag) { return tag.timestamp > tMax; });
-            if (itBegin >= itEnd) {
+            const std::size_t startIdx = _tagValues.lowerIndex(tMin); // first tag >= tMin
+            const std::size_t endIdx   = _tagValues.upperIndex(tMax); // first tag > tMax
+            if (startIdx >= endIdx) {
                 return {0, 0};
             }
-            std::size_t startIdx = static_cast<std::size_t>(std::distance(_tagValues.begin(), itBegin));
-            std::size_t count    = static_cast<std::size_t>(std::distance(itBegin, itEnd));
-            return {startIdx, count};
+            return {startIdx, endIdx - startIdx};
         }
         return {0, 0};
     }
@@ -420,31 +534,29 @@ struct ImPlotSink : gr::Block<ImPlotSink<T>, gr::Drawable<gr::UICategory::Conten
     [[nodiscard]] SignalSink::XRangeResult getX(double tMin = -std::numeric_limits<double>::infinity(), double tMax = +std::numeric_limits<double>::infinity()) const {
         if constexpr (IsStreaming) {
             if (_xValues.empty()) {
-                return {{}, 0.0, 0.0};
+                return {{}, 0.0, 0.0, {}};
             }
-            auto xSpan = _xValues.get_span(0);
             // Clamp requested range to available data
-            double dataMin      = xSpan.front();
-            double dataMax      = xSpan.back();
+            double dataMin      = _xValues.front();
+            double dataMax      = _xValues.back();
             double effectiveMin = std::max(tMin, dataMin);
             double effectiveMax = std::min(tMax, dataMax);
 
             if (effectiveMin > effectiveMax) {
-                return {{}, dataMin, dataMax}; // Requested range outside data
+                return {{}, dataMin, dataMax, {}}; // Requested range outside data
             }
 
-            // Binary search for range bounds
-            auto itBegin = std::lower_bound(xSpan.begin(), xSpan.end(), effectiveMin);
-            auto itEnd   = std::upper_bound(xSpan.begin(), xSpan.end(), effectiveMax);
-            if (itBegin >= itEnd) {
-                return {{}, dataMin, dataMax};
+            const auto [startIdx, count] = getXRange(effectiveMin, effectiveMax);
+            if (count == 0UZ) {
+                return {{}, dataMin, dataMax, {}};
             }
 
-            std::size_t startIdx = static_cast<std::size_t>(std::distance(xSpan.begin(), itBegin));
-            std::size_t count    = static_cast<std::size_t>(std::distance(itBegin, itEnd));
-            return {xSpan.subspan(startIdx, count), *itBegin, *(itEnd - 1)};
+            // X is implicit, materialise the requested range into owned storage so the span is self-contained
+            auto storage = std::make_shared<std::vector<double>>(count);
+            _xValues.fill(startIdx, *storage);
+            return {std::span<const double>(*storage), storage->front(), storage->back(), std::move(storage)};
         }
-        return {{}, 0.0, 0.0};
+        return {{}, 0.0, 0.0, {}};
     }
 
     [[nodiscard]] SignalSink::YRangeResult getY(double tMin = -std::numeric_limits<double>::infinity(), double tMax = +std::numeric_limits<double>::infinity()) const {
@@ -453,20 +565,17 @@ struct ImPlotSink : gr::Block<ImPlotSink<T>, gr::Drawable<gr::UICategory::Conten
                 return {.data = {}, .actual_t_min = 0.0, .actual_t_max = 0.0, ._storage = {}};
             }
 
-            // Get the X range first to determine indices
-            auto xResult = getX(tMin, tMax);
-            if (xResult.data.empty()) {
-                return {.data = {}, .actual_t_min = xResult.actual_t_min, .actual_t_max = xResult.actual_t_max, ._storage = {}};
+            // Get the X index range first (without materialising X)
+            const auto [startIdx, count] = getXRange(tMin, tMax);
+            if (count == 0UZ) {
+                return {.data = {}, .actual_t_min = _xValues.front(), .actual_t_max = _xValues.back(), ._storage = {}};
             }
-
-            // Calculate indices from X range
-            auto        xSpan    = _xValues.get_span(0);
-            std::size_t startIdx = static_cast<std::size_t>(xResult.data.data() - xSpan.data());
-            std::size_t count    = xResult.data.size();
+            const double tFirst = _xValues[startIdx];
+            const double tLast  = _xValues[startIdx + count - 1UZ];
 
             if constexpr (std::is_same_v<ValueType, float>) {
                 auto ySpan = _yValues.get_span(0);
-                return {.data = ySpan.subspan(startIdx, count), .actual_t_min = xResult.actual_t_min, .actual_t_max = xResult.actual_t_max, ._storage = {}};
+                return {.data = ySpan.subspan(startIdx, count), .actual_t_min = tFirst, .actual_t_max = tLast, ._storage = {}};
             } else {
                 // non-float: convert to owned float storage so the span is self-contained
                 auto storage = std::make_shared<std::vector<float>>(count);
@@ -474,7 +583,7 @@ struct ImPlotSink : gr::Block<ImPlotSink<T>, gr::Drawable<gr::UICategory::Conten
                 for (std::size_t i = 0; i < count; ++i) {
                     (*storage)[i] = static_cast<float>(ySpan[startIdx + i]);
                 }
-                return {.data = std::span<const float>(*storage), .actual_t_min = xResult.actual_t_min, .actual_t_max = xResult.actual_t_max, ._storage = std::move(storage)};
+                return {.data = std::span<const float>(*storage), .actual_t_min = tFirst, .actual_t_max = tLast, ._storage = std::move(storage)};
             }
         }
         return {.data = {}, .actual_t_min = 0.0, .actual_t_max = 0.0, ._storage = {}};
@@ -493,10 +602,8 @@ struct ImPlotSink : gr::Block<ImPlotSink<T>, gr::Drawable<gr::UICategory::Conten
             double effectiveMax = std::min(tMax, dataMax);
 
             std::vector<SignalSink::TagEntry> result;
-            for (const auto& tag : _tagValues) {
-                if (tag.timestamp >= effectiveMin && tag.timestamp <= effectiveMax) {
-                    result.push_back({tag.timestamp, tag.map});
-                }
+            for (const auto& tag : _tagValues.range(effectiveMin, effectiveMax)) {
+                result.push_back({tag.timestamp, tag.map});
             }
 
             if (result.empty()) {
@@ -514,13 +621,66 @@ struct ImPlotSink : gr::Block<ImPlotSink<T>, gr::Drawable<gr::UICategory::Conten
 
     void pruneTags(double minX) {
         if constexpr (IsStreaming) {
-            std::erase_if(_tagValues, [minX](const auto& tag) { return tag.timestamp < minX; });
+            const std::size_t nTags = _tagValues.size();
+            _tagValues.eraseBefore(minX);
+            if (_tagValues.size() != nTags) {
+                ++_dataGeneration;
+            }
         }
     }
 
-    gr::work::Status processBulk(gr::InputSpanLike auto& input) noexcept {
+    /// appends X runs, values and tags to the history buffers (caller must hold _dataMutex); DataSets passed as an rvalue
+    /// container are moved, an input span is copied once, streaming samples go into the ring as at most two contiguous copies
+    template<typename Values>
+    void publishSegment(std::span<const charts::ImplicitTimeAxis::Run> runs, Values&& values, std::span<TagData> tags) {
+        ++_dataGeneration;
+        for (const auto& run : runs) {
+            _xValues.append(run);
+        }
+        if constexpr (IsStreaming) {
+            const std::span<const T> samples(values);
+            const std::size_t        overwritten = samples.size() > _yValues.capacity() ? samples.size() - _yValues.capacity() : 0UZ;
+            _yPyramid.pushRange(samples); // updated per bucket
+            _yValues.push_back(samples.begin() + static_cast<std::ptrdiff_t>(overwritten), samples.end());
+        } else {
+            for (auto& value : values) {
+                if constexpr (IsDataSet) {
+                    const auto [minIt, maxIt] = std::ranges::minmax_element(value.signal_values);
+                    _dataSetYRanges.push_back(value.signal_values.empty() ? std::pair<ValueType, ValueType>{} : std::pair{*minIt, *maxIt});
+                }
+                if constexpr (std::is_rvalue_reference_v<Values&&>) {
+                    _yValues.push_back(std::move(value));
+                } else {
+                    _yValues.push_back(value);
+                }
+            }
+        }
+        for (TagData& tag : tags) {
+            _tagValues.insert(std::move(tag));
+        }
+        _publishedSampleCount += std::ranges::size(values);
+    }
+
+    /// moves the pending segment into the history buffers (caller must hold _dataMutex); called by processBulk() and by every
+    /// reader taking the lock, so a segment left pending is visible with the next frame even if no more input arrives
+    void publishPending() {
+        std::lock_guard pendingLock(_pendingMutex);
+        if (_pending.empty()) {
+            return;
+        }
+        publishSegment(_pending.x, std::move(_pending.y), _pending.tags);
+        _pending.x.clear();
+        _pending.y.clear();
+        _pending.tags.clear();
+    }
+
+    void stop() {
         std::lock_guard lock(*_dataMutex);
+        publishPending(); // nothing may stay behind once the producer stopped
+    }
 
+    gr::work::Status processBulk(gr::InputSpanLike auto& input) noexcept {
+        _inputTags.clear();
         for (const auto& [relIndex, tagMapRef] : input.tags()) {
             if (relIndex < 0) {
                 continue; // skip unconsumed pre-span tags
@@ -544,46 +704,92 @@ struct ImPlotSink : gr::Block<ImPlotSink<T>, gr::Drawable<gr::UICategory::Conten
                 }
 
                 if (plot_tags) {
-                    _tagValues.push_back({.timestamp = _xUtcOffset, .map = tagMap});
+                    _inputTags.push_back({.timestamp = _xUtcOffset, .map = tagMap});
                     if (!tagOK) {
-                        _tagValues.back().map[std::pmr::string(kFishyTagKey)] = true;
+                        _inputTags.back().map[std::pmr::string(kFishyTagKey)] = true;
                     }
                 }
             }
 
             // surface dropped-sample tags at the current position so the gap is visible in the plot
             if (plot_tags && IsStreaming && tagMap.contains("droppedSamples")) {
-                _tagValues.push_back({.timestamp = _xUtcOffset + static_cast<double>(_sample_count) * _sample_period, .map = tagMap});
+                _inputTags.push_back({.timestamp = _xUtcOffset + static_cast<double>(_sample_count) * _sample_period, .map = tagMap});
             }
         }
 
-        // Process all samples in the span
-        for (const auto& sample : input) {
-            if constexpr (std::is_arithmetic_v<T>) {
-                _xValues.push_back(_xUtcOffset + static_cast<double>(_sample_count) * _sample_period);
+        // Process all samples in the span, X is uniform between tags (which only occur at the start of the span)
+        const charts::ImplicitTimeAxis::Run                  run{.origin = _xUtcOffset, .period = _sample_period, .originCount = _sample_count, .count = input.size()};
+        const std::span<const charts::ImplicitTimeAxis::Run> runs = IsStreaming ? std::span(&run, 1UZ) : std::span<const charts::ImplicitTimeAxis::Run>{};
+        if constexpr (IsDataSet) {
+            // block settings are only touched on the block's own thread, publishPending() may run on any reader's
+            for (const T& dataSet : input) {
+                updateAxisMetadataFromDataSet(dataSet);
             }
-            _yValues.push_back(sample);
-            _sample_count++;
+        }
+        _sample_count += input.size();
+
+        // publish straight from the input span unless a renderer currently holds the lock, the span is then staged in _pending
+        // and goes out with the renderer's next lock or the next call
+        std::unique_lock lock(*_dataMutex, std::try_to_lock);
+        if (lock.owns_lock()) {
+            publishPending(); // older segments first
+            publishSegment(runs, input, _inputTags);
+            return gr::work::Status::OK;
+        }
 
-            if constexpr (IsDataSet) {
-                updateAxisMetadataFromDataSet(sample);
-            }
+        std::size_t pendingSize = 0UZ;
+        {
+            std::lock_guard pendingLock(_pendingMutex);
+            _pending.x.insert(_pending.x.end(), runs.begin(), runs.end());
+            _pending.y.insert(_pending.y.end(), input.begin(), input.end());
+            _pending.tags.insert(_pending.tags.end(), std::make_move_iterator(_inputTags.begin()), std::make_move_iterator(_inputTags.end()));
+            pendingSize = _pending.y.size();
         }
+        if (pendingSize < kMaxPendingBuffers * std::max(_capacitySnapshot.load(std::memory_order_relaxed), 1UZ)) {
+            return gr::work::Status::OK;
+        }
+        lock.lock();
+        publishPending();
 
         return gr::work::Status::OK;
     }
 
-    gr::work::Status draw(const gr::property_map& config = {}) noexcept {
-        using enum AxisScale;
+    /// rebuilds the streaming trace of `snap` for its axis scale and column width: M4-decimated when more than 4 samples fall on a
+    /// pixel column, read through the min/max pyramid, i.e. O(columns * log(required_size)) instead of a copy of the whole history
+    /// (caller must hold _dataMutex, _yValues not empty)
+    void snapshotStreaming(DrawSnapshot& snap, double plotXMin) const
+    requires IsStreaming
+    {
+        const std::size_t count = _xValues.size();
+        const auto        ySpan = _yValues.get_span(0UZ);
+        snap.xFirst             = _xValues.front();
+        snap.xLast              = _xValues.back();
+        snap.x.clear();
+        snap.y.clear();
+
+        const double xShift   = charts::tags::transformX(0.0, snap.axisScale, snap.xFirst, snap.xLast); // the axis transform is a pure offset
+        const double dataSpan = std::abs(snap.xLast - snap.xFirst);
+        if (count >= 2UZ && dataSpan > 0.0 && snap.columnWidth > 0.0 && std::isfinite(snap.columnWidth) && 4.0 * (dataSpan / snap.columnWidth + 1.0) < static_cast<double>(count)) {
+            auto xAtFn     = [this, xShift](std::size_t i) { return _xValues[i] + xShift; };
+            auto yAtFn     = [&ySpan](std::size_t i) { return static_cast<double>(ySpan[i]); };
+            auto extremaFn = [this](std::size_t first, std::size_t n) {
+                const auto minMax = yExtrema(first, n);
+                return std::pair{minMax.min_index, minMax.max_index};
+            };
+            charts::decimation::m4(count, xAtFn, yAtFn, extremaFn, plotXMin, snap.columnWidth, snap.x, snap.y); // columns aligned with the pixel grid
+            return;
+        }
+        snap.x.resize(count);
+        _xValues.fill(0UZ, snap.x);
+        std::ranges::for_each(snap.x, [xShift](double& x) { x += xShift; });
+        snap.y.assign(ySpan.begin(), ySpan.end());
+    }
 
+    gr::work::Status draw(const gr::property_map& config = {}) noexcept {
         if (!isTabVisible()) {
             return gr::work::Status::OK;
         }
 
-        // Acquire lock for thread-safe data access during rendering.
-        // Data is copied to GPU buffers by ImPlot API calls below.
-        std::lock_guard lock(*_dataMutex);
-
         // Set axes from config
         {
             static constexpr ImAxis xAxes[] = {ImAxis_X1, ImAxis_X2, ImAxis_X3};
@@ -599,81 +805,101 @@ struct ImPlotSink : gr::Block<ImPlotSink<T>, gr::Drawable<gr::UICategory::Conten
         };
         const AxisScale axisScale = magic_enum::enum_cast<AxisScale>(trim(scaleStr)).value_or(AxisScale::Linear);
         const char*     label     = signal_name.value.empty() ? this->name.value.c_str() : signal_name.value.c_str();
-        if (_yValues.empty()) {
+        const bool      tagsShown = getValueOrDefault<bool>(config, "draw_tag", false);
+
+        // copy what is plotted under the lock and render from the copy, processBulk() must never wait for ImPlot; the copy is
+        // only refreshed when something was published since the last frame or the plot was zoomed/resized
+        const ImPlotRect limits      = ImPlot::GetPlotLimits(IMPLOT_AUTO, IMPLOT_AUTO);
+        const double     columnWidth = std::abs(limits.X.Max - limits.X.Min) / std::max(static_cast<double>(ImPlot::GetPlotSize().x), 1.0);
+        DrawSnapshot&    snap        = _drawSnapshot;
+        bool             empty       = false;
+        {
+            std::lock_guard lock(*_dataMutex);
+            publishPending(); // segments the producer had to leave pending while a reader held the lock
+            empty = _yValues.empty();
+            if constexpr (std::is_arithmetic_v<T>) {
+                if (tagsShown && !empty) {
+                    pruneTags(_xValues.front());
+                }
+            }
+            if (!empty && (snap.generation != _dataGeneration || snap.withTags != tagsShown || (IsStreaming && snap.viewDiffers(axisScale, columnWidth)))) {
+                snap.generation  = _dataGeneration;
+                snap.withTags    = tagsShown;
+                snap.axisScale   = axisScale;
+                snap.columnWidth = columnWidth;
+                if constexpr (std::is_arithmetic_v<T>) {
+                    snapshotStreaming(snap, limits.X.Min);
+                    snap.tags.clear();
+                    if (tagsShown) {
+                        for (const auto& tag : _tagValues.range(snap.xFirst, snap.xLast)) {
+                            snap.tags.push_back(tag);
+                        }
+                    }
+                } else if constexpr (gr::DataSetLike<T>) {
+                    // the retained DataSets are kept, i.e. the cost per frame is independent of n_history
+                    const std::size_t nMax  = std::min(_yValues.size(), static_cast<std::size_t>(n_history));
+                    std::size_t       fresh = std::min(_publishedSampleCount - snap.publishedCount, nMax);
+                    if (snap.dataSets.size() + fresh < nMax) { // cannot be continued, e.g. n_history was raised
+                        snap.dataSets.clear();
+                        snap.dataSetYRanges.clear();
+                        fresh = nMax;
+                    }
+                    for (std::size_t i = fresh; i-- > 0UZ;) { // oldest new one first, the newest ends up in front
+                        snap.dataSets.push_front(_yValues.at(i));
+                        snap.dataSetYRanges.push_front(_dataSetYRanges.at(i));
+                    }
+                    snap.dataSets.resize(nMax); // drops the oldest
+                    snap.dataSetYRanges.resize(nMax);
+                    snap.publishedCount = _publishedSampleCount;
+                }
+            }
+        }
+
+        if (empty) {
             // plot one single dummy value so that the sink shows up in the plot legend
             double v = {};
             ImPlot::PlotLine(label, &v, 1);
             return gr::work::Status::OK;
         }
 
+        // DataSet axes are plotted straight from their native storage, their X values are absolute (e.g. frequency) for every axis scale
         struct PlotLineContext {
-            std::span<const double>    x_values;
+            std::span<const ValueType> x_values;
             std::span<const ValueType> y_values;
-            AxisScale                  axis_scale;
             ValueType                  y_offset{0};
         };
 
         constexpr auto pointGetter = +[](int signedIndex, void* user_data) -> ImPlotPoint {
             std::size_t idx = static_cast<std::size_t>(signedIndex);
             auto*       ctx = static_cast<PlotLineContext*>(user_data);
-
-            double xVal = ctx->x_values[idx];
-            double yVal = static_cast<double>(ctx->y_values[idx] + ctx->y_offset);
-
-            switch (ctx->axis_scale) {
-            case Time: return {xVal, yVal};
-
-            case LinearReverse: {
-                if constexpr (gr::DataSetLike<T>) {
-                    return {xVal, yVal};
-                } else {
-                    // fundamental types
-                    double xMax = ctx->x_values.back();
-                    return {xVal - xMax, yVal};
-                }
-            }
-
-            case Linear:
-            case Log10:
-            case SymLog:
-            default: {
-                if constexpr (gr::DataSetLike<T>) {
-                    return {xVal, yVal};
-                } else {
-                    // fundamental types
-                    double xMin = ctx->x_values.front();
-                    return {xVal - xMin, yVal};
-                }
-            }
-            }
+            return {static_cast<double>(ctx->x_values[idx]), static_cast<double>(ctx->y_values[idx] + ctx->y_offset)};
         };
 
         auto lineColor = ImGui::ColorConvertU32ToFloat4(rgbToImGuiABGR(_colour.colour()));
         if constexpr (std::is_arithmetic_v<T>) {
             ImPlot::SetNextLineStyle(lineColor);
 
-            auto [minX, maxX] = std::ranges::minmax(_xValues);
+            const double minX = snap.xFirst;
+            const double maxX = snap.xLast;
             // draw tags before data (data is drawn on top)
-            if (getValueOrDefault<bool>(config, "draw_tag", false)) {
+            if (tagsShown) {
                 ImVec4 tagColor = lineColor;
                 tagColor.w *= 0.35f; // semi-transparent tags
-                std::erase_if(_tagValues, [minX](const auto& tag) { return tag.timestamp < minX; });
                 drawTags(
-                    [&](auto&& fn) {
-                        for (const auto& t : _tagValues) {
-                            fn(t.timestamp, t.map);
+                    [&snap](auto&& fn) {
+                        for (const auto& tag : snap.tags) {
+                            fn(tag.timestamp, tag.map);
                         }
                     },
                     axisScale, minX, maxX, tagColor);
             }
 
-            PlotLineContext ctx{_xValues.get_span(0UZ), _yValues.get_span(0UZ), axisScale, ValueType{0}};
-            ImPlot::PlotLineG(label, pointGetter, &ctx, static_cast<int>(_xValues.size())); // limited to int, even if x_values can have long values
+            ImPlot::PlotLine(label, snap.x.data(), snap.y.data(), static_cast<int>(snap.x.size())); // limited to int, the decimated trace is far below
         } else if constexpr (gr::DataSetLike<T>) {
-            const std::size_t nMax = std::min(_yValues.size(), static_cast<std::size_t>(n_history));
+            const std::size_t nMax = snap.dataSets.size();
             for (std::size_t historyIdx = nMax; historyIdx-- > 0;) {
                 // draw newest DataSet last -> on top
-                const gr::DataSet<ValueType>& dataSet = _yValues.at(historyIdx);
+                const gr::DataSet<ValueType>& dataSet = snap.dataSets[historyIdx];
                 // dimension checks
                 const std::size_t nsignals = dataSet.size();
                 if (dataSet.extents.size() != 1UZ && nsignals < 1UZ) {
@@ -683,14 +909,7 @@ struct ImPlotSink : gr::Block<ImPlotSink<T>, gr::Drawable<gr::UICategory::Conten
                 lineColor.w = std::max(0.f, 1.0f - static_cast<float>(historyIdx) * 1.f / static_cast<float>(nMax));
                 ImPlot::SetNextLineStyle(lineColor);
 
-                std::vector<double> xAxisDouble;
-                if constexpr (!std::is_same_v<ValueType, double>) {
-                    // TODO: find a smarter zero-copy solution
-                    if (!dataSet.axis_values.empty()) {
-                        auto xSpan = dataSet.axisValues(0UZ);
-                        xAxisDouble.assign(xSpan.begin(), xSpan.end());
-                    }
-                }
+                const std::span<const ValueType> xValues = dataSet.axis_values.empty() ? std::span<const ValueType>{} : dataSet.axisValues(0UZ);
 
                 // draw tags before data (data is drawn on top)
                 if (historyIdx == 0UZ && getValueOrDefault<bool>(config, "draw_tag", false)) {
@@ -700,14 +919,14 @@ struct ImPlotSink : gr::Block<ImPlotSink<T>, gr::Drawable<gr::UICategory::Conten
                 }
 
                 // NOTE: npoints is long int, while ImPlot lines are limited to int
-                const auto npoints = cast_to_signed(dataSet.axisValues(0UZ).size());
+                const auto npoints = cast_to_signed(xValues.size());
                 if (dataset_index == std::numeric_limits<gr::Size_t>::max()) {
                     // draw all signals
-                    auto [minVal, maxVal] = std::ranges::minmax(dataSet.signal_values);
+                    auto [minVal, maxVal] = snap.dataSetYRanges[historyIdx];
                     ValueType baseOffset  = static_cast<ValueType>(history_offset) * (maxVal - minVal);
                     for (std::size_t sigIdx = 0UZ; sigIdx < nsignals; ++sigIdx) {
                         ImPlot::SetNextLineStyle(lineColor);
-                        PlotLineContext ctx{xAxisDouble, dataSet.signalValues(sigIdx), axisScale, static_cast<ValueType>(sigIdx + historyIdx) * baseOffset};
+                        PlotLineContext ctx{xValues, dataSet.signalValues(sigIdx), static_cast<ValueType>(sigIdx + historyIdx) * baseOffset};
                         ImPlot::PlotLineG(historyIdx == 0UZ ? dataSet.signal_names[sigIdx].c_str() : "", pointGetter, &ctx, static_cast<int>(npoints));
                     }
                 } else {
@@ -717,7 +936,7 @@ struct ImPlotSink : gr::Block<ImPlotSink<T>, gr::Drawable<gr::UICategory::Conten
                     }
                     const auto sigIdx = static_cast<std::size_t>(dataset_index);
                     ImPlot::SetNextLineStyle(lineColor);
-                    PlotLineContext ctx{xAxisDouble, dataSet.signalValues(sigIdx), axisScale};
+                    PlotLineContext ctx{xValues, dataSet.signalValues(sigIdx)};
                     ImPlot::PlotLineG(dataSet.signal_names[sigIdx].c_str(), pointGetter, &ctx, static_cast<int>(npoints));
                 }
             }
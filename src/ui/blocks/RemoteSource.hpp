@@ -10,6 +10,7 @@
 #include <gnuradio-4.0/Block.hpp>
 #include <gnuradio-4.0/DataSet.hpp>
 
+#include <TagEncoding.hpp>
 #include <daq_api.hpp>
 
 #include <opencmw.hpp>
@@ -39,6 +40,14 @@ inline opencmw::URI<> resolveRelativeTopic(const std::string& remote, const std:
     return pathUrl;
 }
 
+/// adds the tag encoding to the topic unless it selects one, "yaml" is the default and left out so older services accept the topic
+inline opencmw::URI<> withTagEncoding(const opencmw::URI<>& topic, std::string_view encoding) {
+    if (encoding.empty() || encoding == "yaml" || topic.queryParamMap().contains("tagEncoding")) {
+        return topic;
+    }
+    return opencmw::URI<>::UriFactory(topic).addQueryParameter("tagEncoding", std::string(encoding)).build();
+}
+
 struct RemoteSourceModel {
     virtual ~RemoteSourceModel() {}
     virtual std::string uniqueName() const = 0;
@@ -49,7 +58,8 @@ struct RemoteSourceModel {
 
 struct RemoteSourceBase {
     std::string remote_uri;
-    std::string host = "ADDA";
+    std::string host         = "ADDA";
+    std::string tag_encoding = "yaml"; // "binary" (TagEncoding.hpp) needs a service that knows it, decodeTriggerPropertyMaps() handles both
 };
 
 class RemoteSubscriptionManager;
@@ -165,7 +175,7 @@ class RemoteSubscriptionManager {
 public:
     [[nodiscard]] static RemoteSubscriptionHandle subscribe(const RemoteSourceBase& source, Subscription::Callback&& callback) {
         auto&      instance = RemoteSubscriptionManager::instance();
-        auto       uri      = resolveRelativeTopic(source.remote_uri, source.host).str();
+        auto       uri      = withTagEncoding(resolveRelativeTopic(source.remote_uri, source.host), source.tag_encoding).str();
         const auto guard    = std::unique_lock{instance._mutex}; // reading + potentially writing operation
 
         auto       subscriptionIter                   = instance._subscriptions.find(uri);
@@ -343,7 +353,7 @@ void RemoteSourceCommon<Derived, QueueContents>::settingsChanged(const gr::prope
     //     return; // early return, only apply settings for the running flowgraph
     // }
     auto* self = static_cast<RemoteSourceBase*>(static_cast<Derived*>(this));
-    if ((new_settings.contains("host") || new_settings.contains("remote_uri")) && !self->host.empty() && !self->remote_uri.empty()) {
+    if ((new_settings.contains("host") || new_settings.contains("remote_uri") || new_settings.contains("tag_encoding")) && !self->host.empty() && !self->remote_uri.empty()) {
         RemoteSourceManager::instance().notifyOfRemoteSource(self->remote_uri, this);
         stopSubscription();
         startSubscription();
@@ -361,6 +371,7 @@ void RemoteSourceCommon<Derived, QueueContents>::start() {
 struct RemoteStreamSourceData {
     opendigitizer::acq::Acquisition acq;
     std::size_t                     read = 0;
+    std::vector<gr::property_map>   triggerPropertyMaps; // decoded on reception, one per acq.triggerIndices entry
 };
 
 template<typename T>
@@ -377,7 +388,7 @@ struct RemoteStreamSource : RemoteSourceBase, RemoteSourceCommon<RemoteStreamSou
     gr::Annotated<bool, "verbose console", gr::Doc<"For debugging">>                                                                                                          verbose_console   = false;
     gr::Annotated<float, "reconnect timeout", gr::Doc<"reconnect timeout in sec">>                                                                                            reconnect_timeout = 5.f;
 
-    GR_MAKE_REFLECTABLE(RemoteStreamSource, out, remote_uri, signal_name, signal_unit, signal_quantity, signal_min, signal_max, host, verbose_console, reconnect_timeout);
+    GR_MAKE_REFLECTABLE(RemoteStreamSource, out, remote_uri, signal_name, signal_unit, signal_quantity, signal_min, signal_max, host, tag_encoding, verbose_console, reconnect_timeout);
 
     using Queue = RemoteSourceCommon<RemoteStreamSource, RemoteStreamSourceData>::Queue;
 
@@ -444,7 +455,9 @@ struct RemoteStreamSource : RemoteSourceBase, RemoteSourceCommon<RemoteStreamSou
             if constexpr (std::is_same_v<T, float>) {
                 std::ranges::copy(inValues, outIt);
             } else if constexpr (gr::UncertainValueLike<T>) { // TODO: still needs to be tested when we get full support of gr::UncertainValue
-                if (d.acq.channelValues.elements().size() != d.acq.channelErrors.elements().size()) {
+                if (d.acq.channelErrors.elements().empty()) { // sent without errors (noErrors)
+                    std::ranges::transform(inValues, outIt, [](const auto& v) { return gr::UncertainValue{v, typename T::value_type(0)}; });
+                } else if (d.acq.channelValues.elements().size() != d.acq.channelErrors.elements().size()) {
                     this->emitErrorMessage("subscriptionCallback(..)",                                                                                       //
                         gr::Error(std::format("Inconsistent data from '{}': Sample type is UncertainValue but channelValues size ({}) != signalErrors ({})", //
                             remote_uri, d.acq.channelValues.elements().size(), d.acq.channelErrors.elements().size())));                                     //
@@ -461,7 +474,7 @@ struct RemoteStreamSource : RemoteSourceBase, RemoteSourceCommon<RemoteStreamSou
             }
 
             // publish trigger info
-            for (const auto& [idx, trigger, timestamp, offset, yaml] : std::views::zip(d.acq.triggerIndices.value(), d.acq.triggerEventNames.value(), d.acq.triggerTimestamps.value(), d.acq.triggerOffsets.value(), d.acq.triggerYamlPropertyMaps.value())) {
+            for (const auto& [idx, trigger, timestamp, offset, tagMap] : std::views::zip(d.acq.triggerIndices.value(), d.acq.triggerEventNames.value(), d.acq.triggerTimestamps.value(), d.acq.triggerOffsets.value(), d.triggerPropertyMaps)) {
                 // this tag was already handled in a previous call OR it will be published in the next call
                 if (idx < cast_to_signed(d.read) || static_cast<std::size_t>(idx - cast_to_signed(d.read)) >= nSamplesToCopy) {
                     continue;
@@ -476,13 +489,7 @@ struct RemoteStreamSource : RemoteSourceBase, RemoteSourceCommon<RemoteStreamSou
                     auto       latency = now - std::chrono::nanoseconds(timestamp);
                     map.insert({"REMOTE_SOURCE_LATENCY", static_cast<int64_t>(latency.count())}); // compares the current system time with the time inside the tag
                 }
-                const auto yamlMap = gr::pmt::yaml::deserialize(yaml);
-                if (yamlMap) {
-                    const gr::property_map& rootMap = yamlMap.value();
-                    map.insert(rootMap.begin(), rootMap.end()); // Ignore duplicates (do not overwrite)
-                } else {
-                    // throw gr::exception(std::format("Could not parse yaml for Tag property_map: {}:{}\n{}", yamlMap.error().message, yamlMap.error().line, yaml));
-                }
+                map.insert(tagMap.begin(), tagMap.end()); // Ignore duplicates (do not overwrite)
                 if (verbose_console) {
                     const auto tag_time = std::chrono::system_clock::time_point() + std::chrono::nanoseconds(timestamp);
                     std::print("RemoteStreamSource: {} publish tag (tag-time: {}, systemtime: {}): {}\n", this->name.value, gr::time::getIsoTime(tag_time), gr::time::getIsoTime(), gr::join(map));
@@ -529,7 +536,7 @@ struct RemoteStreamSource : RemoteSourceBase, RemoteSourceCommon<RemoteStreamSou
             const gr::property_map yamlPropertyMap = {{"subscription-error", rep.error}};
             acq.triggerYamlPropertyMaps            = {gr::pmt::yaml::serialize(yamlPropertyMap)};
             std::lock_guard lock(queue->mutex);
-            queue->data.push_back({std::move(acq), 0});
+            queue->data.push_back({std::move(acq), 0, {yamlPropertyMap}});
             return std::move(this->_subscription); // release/unsubscribe
         }
         if (rep.data.empty()) {
@@ -543,14 +550,16 @@ struct RemoteStreamSource : RemoteSourceBase, RemoteSourceCommon<RemoteStreamSou
             opendigitizer::acq::Acquisition acq;
             auto                            buf = rep.data;
             opencmw::deserialise<opencmw::YaS, opencmw::ProtocolCheck::IGNORE>(buf, acq);
+            auto triggerPropertyMaps = opendigitizer::acq::decodeTriggerPropertyMaps(acq);
             if (skipped_updates != 0) {
                 acq.triggerIndices.insert(acq.triggerIndices.begin(), 0L);
                 acq.triggerTimestamps.insert(acq.triggerTimestamps.begin(), 0);
                 acq.triggerEventNames.insert(acq.triggerEventNames.begin(), "WARNING_SAMPLES_DROPPED");
                 acq.triggerOffsets.insert(acq.triggerOffsets.begin(), 0.0f);
+                triggerPropertyMaps.insert(triggerPropertyMaps.begin(), gr::property_map{});
             }
             std::lock_guard lock(queue->mutex);
-            queue->data.push_back({std::move(acq), 0});
+            queue->data.push_back({std::move(acq), 0, std::move(triggerPropertyMaps)});
         } catch (opencmw::ProtocolException& e) {
             gr::sendMessage<gr::message::Command::Notify>(this->msgOut, this->unique_name /* serviceName */, "subscription", //
                 gr::Error(std::format("failed to deserialise update from {}: {}\n", remote_uri, e.what())));
@@ -571,7 +580,7 @@ struct RemoteDataSetSource : RemoteSourceBase, RemoteSourceCommon<RemoteDataSetS
     gr::Annotated<bool, "verbose console", gr::Doc<"For debugging">>               verbose_console   = false;
     gr::Annotated<float, "reconnect timeout", gr::Doc<"reconnect timeout in sec">> reconnect_timeout = 5.f;
 
-    GR_MAKE_REFLECTABLE(RemoteDataSetSource, out, remote_uri, host, verbose_console, reconnect_timeout);
+    GR_MAKE_REFLECTABLE(RemoteDataSetSource, out, remote_uri, host, tag_encoding, verbose_console, reconnect_timeout);
 
     using Queue = RemoteSourceCommon<RemoteDataSetSource, gr::DataSet<T>>::Queue;
 
@@ -683,14 +692,8 @@ struct RemoteDataSetSource : RemoteSourceBase, RemoteSourceCommon<RemoteDataSetS
             ds.meta_information.push_back({{"subscription-updates-skipped", static_cast<uint64_t>(skipped_samples)}});
             ds.timing_events.resize(1UZ);
 
-            for (const auto& [idx, yaml] : std::views::zip(acq.triggerIndices.value(), acq.triggerYamlPropertyMaps.value())) {
-                const auto yamlMap = gr::pmt::yaml::deserialize(yaml);
-                if (yamlMap) {
-                    const gr::property_map& rootMap = yamlMap.value();
-                    ds.timing_events[0].emplace_back(static_cast<std::ptrdiff_t>(idx), rootMap);
-                } else {
-                    // throw gr::exception(std::format("Could not parse yaml for Tag property_map: {}:{}\n{}", yamlMap.error().message, yamlMap.error().line, yaml));
-                }
+            for (auto&& [idx, tagMap] : std::views::zip(acq.triggerIndices.value(), opendigitizer::acq::decodeTriggerPropertyMaps(acq))) {
+                ds.timing_events[0].emplace_back(static_cast<std::ptrdiff_t>(idx), std::move(tagMap));
             }
 
             std::lock_guard lock(queue->mutex);
@@ -710,11 +713,14 @@ private:
     void copySignalValues(gr::DataSet<T>& ds, const opendigitizer::acq::Acquisition& acq, std::size_t nSignals, std::size_t nSamples) {
         ds.signal_values.resize(nSignals * nSamples);
         if constexpr (gr::UncertainValueLike<T>) {
-            const bool dataOk = acq.channelValues.elements().size() == acq.channelErrors.elements().size();
-            if (!dataOk) {
-                this->emitErrorMessage("subscriptionCallback(..)",                                                                                       //
-                    gr::Error(std::format("Inconsistent data from '{}': Sample type is UncertainValue but channelValues size ({}) != signalErrors ({})", //
-                        remote_uri, acq.channelValues.elements().size(), acq.channelErrors.elements().size())));                                         //
+            const bool noErrors = acq.channelErrors.elements().empty(); // sent without errors (noErrors)
+            const bool dataOk   = noErrors || acq.channelValues.elements().size() == acq.channelErrors.elements().size();
+            if (!dataOk || noErrors) {
+                if (!dataOk) {
+                    this->emitErrorMessage("subscriptionCallback(..)",                                                                                       //
+                        gr::Error(std::format("Inconsistent data from '{}': Sample type is UncertainValue but channelValues size ({}) != signalErrors ({})", //
+                            remote_uri, acq.channelValues.elements().size(), acq.channelErrors.elements().size())));                                         //
+                }
 
                 for (std::size_t i = 0; i < nSignals; i++) {
                     auto outValues = ds.signalValues(i);
@@ -91,7 +91,7 @@ struct LogFreqRange {
 };
 
 /// The [min, max] display range when `xCfg` is a Log10 axis with a finite, strictly-positive range, else nullopt.
-/// Texture/surface spectrum charts re-bin a linear FFT onto log-spaced columns drawn over this range (buildLogBinnedRow).
+/// Texture/surface spectrum charts re-bin a linear FFT onto log-spaced columns drawn over this range (LogBinningPlan).
 [[nodiscard]] inline std::optional<LogFreqRange> logFreqRange(const std::optional<AxisConfig>& xCfg) {
     if (xCfg && xCfg->scale == AxisScale::Log10 && std::isfinite(xCfg->min) && std::isfinite(xCfg->max) && xCfg->min > 0.f) {
         return LogFreqRange{static_cast<double>(xCfg->min), static_cast<double>(xCfg->max)};
@@ -641,6 +641,97 @@ inline void drawDataSetTimingEvents(const gr::DataSet<T>& dataSet, AxisScale axi
 
 } // namespace tags
 
+namespace decimation {
+
+/// min/max (M4) decimation of a polyline with monotonic X: for each of the equally wide X columns (typically one per pixel)
+/// only the first, min, max and last sample are kept (in sample order, duplicates removed), which rasterises to the same
+/// pixels as the full line while the number of vertices scales with the plot width rather than the number of samples
+/// `xAt(i)`/`yAt(i)` return the (already transformed) coordinates of sample i in [0, count), column k covers [xOrigin + k * columnWidth, xOrigin + (k + 1) * columnWidth),
+/// the result is appended to outX/outY
+template<typename XAt, typename YAt>
+inline void m4(std::size_t count, XAt&& xAt, YAt&& yAt, double xOrigin, double columnWidth, std::vector<double>& outX, std::vector<double>& outY) {
+    if (count == 0UZ) {
+        return;
+    }
+    auto columnOf = [xOrigin, columnWidth](double x) { return static_cast<std::int64_t>(std::floor((x - xOrigin) / columnWidth)); };
+
+    std::size_t  first  = 0UZ;
+    std::size_t  minIdx = 0UZ;
+    std::size_t  maxIdx = 0UZ;
+    double       minY   = static_cast<double>(yAt(0UZ));
+    double       maxY   = minY;
+    std::int64_t column = columnOf(static_cast<double>(xAt(0UZ)));
+
+    auto flush = [&](std::size_t last) {
+        std::array<std::size_t, 4UZ> indices{first, std::min(minIdx, maxIdx), std::max(minIdx, maxIdx), last};
+        std::size_t                  previous = std::numeric_limits<std::size_t>::max();
+        for (std::size_t idx : indices) {
+            if (idx != previous) {
+                outX.push_back(static_cast<double>(xAt(idx)));
+                outY.push_back(static_cast<double>(yAt(idx)));
+                previous = idx;
+            }
+        }
+    };
+
+    for (std::size_t i = 1UZ; i < count; ++i) {
+        const double       y         = static_cast<double>(yAt(i));
+        const std::int64_t newColumn = columnOf(static_cast<double>(xAt(i)));
+        if (newColumn != column) {
+            flush(i - 1UZ);
+            first = minIdx = maxIdx = i;
+            minY = maxY = y;
+            column      = newColumn;
+            continue;
+        }
+        if (y < minY) {
+            minY   = y;
+            minIdx = i;
+        } else if (y > maxY) {
+            maxY   = y;
+            maxIdx = i;
+        }
+    }
+    flush(count - 1UZ);
+}
+
+/// same as above, but the columns are located by binary search on X and their min/max indices are provided by
+/// `extremaOf(first, n) -> {minIndex, maxIndex}` (e.g. SignalSink::yExtrema() backed by a min/max pyramid), i.e. the cost is
+/// O(columns * log(count)) sample accesses instead of O(count)
+template<typename XAt, typename YAt, typename ExtremaOf>
+inline void m4(std::size_t count, XAt&& xAt, YAt&& yAt, ExtremaOf&& extremaOf, double xOrigin, double columnWidth, std::vector<double>& outX, std::vector<double>& outY) {
+    auto columnOf = [xOrigin, columnWidth](double x) { return static_cast<std::int64_t>(std::floor((x - xOrigin) / columnWidth)); };
+
+    for (std::size_t first = 0UZ; first < count;) {
+        // same column assignment as the linear overload, a recomputed column end may round differently at the column edges
+        const std::int64_t column = columnOf(static_cast<double>(xAt(first)));
+        std::size_t        next   = first + 1UZ; // first sample of the next column
+        for (std::size_t hi = count; next < hi;) {
+            const std::size_t mid = next + (hi - next) / 2UZ;
+            if (columnOf(static_cast<double>(xAt(mid))) == column) {
+                next = mid + 1UZ;
+            } else {
+                hi = mid;
+            }
+        }
+        const std::size_t last      = next - 1UZ;
+        const auto [minIdx, maxIdx] = extremaOf(first, next - first);
+
+        std::array<std::size_t, 4UZ> indices{first, std::min(minIdx, maxIdx), std::max(minIdx, maxIdx), last};
+        std::size_t                  previous = std::numeric_limits<std::size_t>::max();
+        for (std::size_t idx : indices) {
+            if (idx != previous) {
+                outX.push_back(static_cast<double>(xAt(idx)));
+                outY.push_back(static_cast<double>(yAt(idx)));
+                previous = idx;
+            }
+        }
+        first = next;
+    }
+}
+
+} // namespace decimation
+
 namespace tooltip {
 
 inline void showPlotMouseTooltip(double onDelay = 1.0, double offDelay = 30.0) {
@@ -4,11 +4,15 @@
 /// Convenience header that includes all chart-related headers.
 
 #include "Chart.hpp"
+#include "ImplicitTimeAxis.hpp"
+#include "MinMaxPyramid.hpp"
+#include "RenderPrep.hpp"
 #include "SignalSink.hpp"
 #include "SpectrumDensity.hpp"
 #include "SpectrumPlot.hpp"
 #include "SpectrumView.hpp"
 #include "SurfacePlot.hpp"
+#include "TagIndex.hpp"
 #include "WaterfallPlot.hpp"
 #include "XYChart.hpp"
 #include "YYChart.hpp"
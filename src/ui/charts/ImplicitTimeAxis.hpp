@@ -0,0 +1,152 @@
+#ifndef OPENDIGITIZER_CHARTS_IMPLICITTIMEAXIS_HPP
+#define OPENDIGITIZER_CHARTS_IMPLICITTIMEAXIS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <ranges>
+#include <span>
+
+namespace opendigitizer::charts {
+
+/**
+ * @brief Time stamps of a uniformly sampled stream, stored as one anchor per segment instead of one double per sample.
+ *
+ * Between timing tags the X value of a sample is `origin + n * period`, with n counting the samples since the segment's time
+ * origin (e.g. the last trigger). Only the anchors of the segments overlapping the last `capacity` samples are retained, and
+ * values are regenerated with the same expression the producer would have used, i.e. bit-identical to storing them.
+ *
+ * Indices follow gr::HistoryBuffer::get_span(0): 0 is the oldest retained sample, size() - 1 the newest.
+ */
+class ImplicitTimeAxis {
+public:
+    struct Run {
+        double      origin      = 0.0; // time origin of the segment, e.g. UTC of the last trigger
+        double      period      = 1.0; // sample period
+        std::size_t originCount = 0UZ; // n of the first sample of the run
+        std::size_t count       = 0UZ; // number of samples
+    };
+
+private:
+    struct Segment {
+        std::size_t firstIndex; // absolute index (number of samples appended before it) of the first sample
+        double      origin;
+        double      period;
+        std::size_t originCount;
+    };
+
+    std::deque<Segment> _segments;
+    std::size_t         _count    = 0UZ; // samples ever appended
+    std::size_t         _size     = 0UZ; // samples retained
+    std::size_t         _capacity = 0UZ;
+
+    [[nodiscard]] std::size_t firstRetained() const noexcept { return _count - _size; }
+
+    [[nodiscard]] static double valueOf(const Segment& segment, std::size_t absIndex) noexcept { return segment.origin + static_cast<double>(segment.originCount + (absIndex - segment.firstIndex)) * segment.period; }
+
+    void prune() {
+        while (_segments.size() > 1UZ && _segments[1UZ].firstIndex <= firstRetained()) {
+            _segments.pop_front();
+        }
+    }
+
+    [[nodiscard]] std::deque<Segment>::const_iterator segmentOf(std::size_t absIndex) const {
+        return std::prev(std::ranges::upper_bound(_segments, absIndex, {}, &Segment::firstIndex));
+    }
+
+public:
+    explicit ImplicitTimeAxis(std::size_t capacity = 0UZ) : _capacity(capacity) {}
+
+    [[nodiscard]] std::size_t size() const noexcept { return _size; }
+    [[nodiscard]] std::size_t capacity() const noexcept { return _capacity; }
+    [[nodiscard]] bool        empty() const noexcept { return _size == 0UZ; }
+    [[nodiscard]] std::size_t segments() const noexcept { return _segments.size(); }
+
+    /// keeps the newest min(size(), capacity) samples, like gr::HistoryBuffer::resize()
+    void resize(std::size_t capacity) {
+        _capacity = capacity;
+        _size     = std::min(_size, _capacity);
+        prune();
+    }
+
+    void append(const Run& run) {
+        if (run.count == 0UZ || _capacity == 0UZ) {
+            return;
+        }
+        const bool continuesLast = !_segments.empty() && _segments.back().origin == run.origin && _segments.back().period == run.period //
+                                   && _segments.back().originCount + (_count - _segments.back().firstIndex) == run.originCount;
+        if (!continuesLast) {
+            _segments.push_back(Segment{.firstIndex = _count, .origin = run.origin, .period = run.period, .originCount = run.originCount});
+        }
+        _count += run.count;
+        _size = std::min(_size + run.count, _capacity);
+        prune();
+    }
+
+    [[nodiscard]] double operator[](std::size_t index) const {
+        const std::size_t absIndex = firstRetained() + index;
+        return valueOf(*segmentOf(absIndex), absIndex);
+    }
+
+    [[nodiscard]] double front() const { return (*this)[0UZ]; }
+    [[nodiscard]] double back() const { return (*this)[_size - 1UZ]; }
+
+    /// per-sample access for callbacks walking the samples in order (e.g. ImPlot getters): remembers the current segment, so
+    /// only indices leaving it cost a search; must not be used after the axis was modified
+    class Reader {
+        const ImplicitTimeAxis*             _axis;
+        std::deque<Segment>::const_iterator _segment;
+        std::size_t                         _segmentBegin = 0UZ; // absolute index range [_segmentBegin, _segmentEnd) of _segment
+        std::size_t                         _segmentEnd   = 0UZ;
+
+    public:
+        explicit Reader(const ImplicitTimeAxis& axis) : _axis(&axis), _segment(axis._segments.cend()) {}
+
+        [[nodiscard]] double operator[](std::size_t index) {
+            const std::size_t absIndex = _axis->firstRetained() + index;
+            if (absIndex < _segmentBegin || absIndex >= _segmentEnd) {
+                _segment      = _axis->segmentOf(absIndex);
+                _segmentBegin = _segment->firstIndex;
+                _segmentEnd   = std::next(_segment) == _axis->_segments.cend() ? _axis->_count : std::next(_segment)->firstIndex;
+            }
+            return valueOf(*_segment, absIndex);
+        }
+    };
+
+    [[nodiscard]] Reader reader() const { return Reader(*this); }
+
+    /// writes the values [startIndex, startIndex + out.size()) to `out`, one multiply-add per sample within each segment
+    void fill(std::size_t startIndex, std::span<double> out) const {
+        std::size_t absIndex = firstRetained() + startIndex;
+        std::size_t written  = 0UZ;
+        for (auto segment = out.empty() ? _segments.cend() : segmentOf(absIndex); written < out.size(); ++segment) {
+            const std::size_t segmentEnd = std::next(segment) == _segments.cend() ? _count : std::next(segment)->firstIndex;
+            const std::size_t n          = std::min(segmentEnd - absIndex, out.size() - written);
+            const double      origin     = segment->origin;
+            const double      period     = segment->period;
+            const std::size_t firstN     = segment->originCount + (absIndex - segment->firstIndex);
+            for (std::size_t i = 0UZ; i < n; ++i) {
+                out[written + i] = origin + static_cast<double>(firstN + i) * period;
+            }
+            written += n;
+            absIndex += n;
+        }
+    }
+
+    /// index of the first sample with a value >= x (size() if none), assumes non-decreasing values
+    [[nodiscard]] std::size_t lowerBound(double x) const {
+        const auto indices = std::views::iota(0UZ, _size);
+        return static_cast<std::size_t>(std::ranges::partition_point(indices, [this, x](std::size_t i) { return (*this)[i] < x; }) - indices.begin());
+    }
+
+    /// index of the first sample with a value > x (size() if none), assumes non-decreasing values
+    [[nodiscard]] std::size_t upperBound(double x) const {
+        const auto indices = std::views::iota(0UZ, _size);
+        return static_cast<std::size_t>(std::ranges::partition_point(indices, [this, x](std::size_t i) { return !(x < (*this)[i]); }) - indices.begin());
+    }
+};
+
+} // namespace opendigitizer::charts
+
+#endif // OPENDIGITIZER_CHARTS_IMPLICITTIMEAXIS_HPP
@@ -0,0 +1,212 @@
+#ifndef OPENDIGITIZER_CHARTS_MINMAXPYRAMID_HPP
+#define OPENDIGITIZER_CHARTS_MINMAXPYRAMID_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <deque>
+#include <ranges>
+#include <type_traits>
+#include <vector>
+
+namespace opendigitizer::charts {
+
+/**
+ * @brief Incrementally maintained multi-resolution min/max summaries of a sample stream.
+ *
+ * Level l holds the extrema (and their sample indices) of consecutive buckets of kFanOut^(l+1) samples. Samples are addressed
+ * by their absolute index (number of samples pushed before them), so evicting old samples from the owner's ring buffer does
+ * not shift the summaries. Only the buckets overlapping the last `capacity` samples are retained.
+ *
+ * extrema() covers an arbitrary range with the coarsest aligned buckets plus raw samples at its unaligned edges, i.e. in
+ * O(kFanOut * levels) instead of O(range length), which makes envelope queries independent of the zoom level.
+ */
+template<typename T>
+class MinMaxPyramid {
+public:
+    static constexpr std::size_t kFanOut = 8UZ;
+
+    struct Extrema {
+        std::size_t minIndex = 0UZ; // absolute sample index
+        std::size_t maxIndex = 0UZ;
+        T           min{};
+        T           max{};
+
+        void merge(const Extrema& other) noexcept {
+            if (isLess(other.min, min)) {
+                min      = other.min;
+                minIndex = other.minIndex;
+            }
+            if (isLess(max, other.max)) {
+                max      = other.max;
+                maxIndex = other.maxIndex;
+            }
+        }
+    };
+
+private:
+    struct Level {
+        std::size_t         bucketSize  = 0UZ;
+        std::size_t         firstBucket = 0UZ; // absolute bucket index of buckets.front()
+        std::deque<Extrema> buckets;
+    };
+
+    std::vector<Level> _levels;
+    std::size_t        _count    = 0UZ;
+    std::size_t        _capacity = 0UZ;
+
+    /// NaN-tolerant '<': a NaN extremum is replaced by any number, a NaN sample never replaces a number
+    static bool isLess(const T& a, const T& b) noexcept {
+        if constexpr (std::is_floating_point_v<T>) {
+            return a < b || (std::isnan(b) && !std::isnan(a));
+        } else {
+            return a < b;
+        }
+    }
+
+    /// merges `extrema` into `bucket`, which is either the newest bucket of `level` or the one after it
+    static void mergeInto(Level& level, std::size_t bucket, const Extrema& extrema) {
+        if (level.buckets.empty()) {
+            level.firstBucket = bucket;
+        }
+        if (level.firstBucket + level.buckets.size() <= bucket) {
+            level.buckets.push_back(extrema);
+        } else {
+            level.buckets.back().merge(extrema);
+        }
+    }
+
+    static void replaceIn(Level& level, std::size_t bucket, const Extrema& extrema) {
+        if (level.buckets.empty()) {
+            level.firstBucket = bucket;
+        }
+        if (bucket < level.firstBucket) {
+            return;
+        }
+        if (level.firstBucket + level.buckets.size() <= bucket) {
+            level.buckets.push_back(extrema);
+        } else {
+            level.buckets[bucket - level.firstBucket] = extrema;
+        }
+    }
+
+    static void evictBefore(Level& level, std::size_t firstValid) {
+        while (!level.buckets.empty() && (level.firstBucket + 1UZ) * level.bucketSize <= firstValid) {
+            level.buckets.pop_front();
+            ++level.firstBucket;
+        }
+    }
+
+public:
+    explicit MinMaxPyramid(std::size_t capacity = 0UZ) { reset(capacity); }
+
+    /// drops all summaries, the next pushed sample has absolute index 0
+    void reset(std::size_t capacity) {
+        _capacity = capacity;
+        _count    = 0UZ;
+        _levels.clear();
+        for (std::size_t bucketSize = kFanOut; bucketSize <= std::max(capacity, kFanOut); bucketSize *= kFanOut) {
+            _levels.push_back(Level{.bucketSize = bucketSize, .firstBucket = 0UZ, .buckets = {}});
+        }
+    }
+
+    [[nodiscard]] std::size_t count() const noexcept { return _count; }
+    [[nodiscard]] std::size_t capacity() const noexcept { return _capacity; }
+    [[nodiscard]] std::size_t levels() const noexcept { return _levels.size(); }
+
+    void push(const T& value) {
+        const std::size_t index      = _count++;
+        const std::size_t firstValid = _count > _capacity ? _count - _capacity : 0UZ;
+        for (Level& level : _levels) {
+            mergeInto(level, index / level.bucketSize, Extrema{.minIndex = index, .maxIndex = index, .min = value, .max = value});
+            evictBefore(level, firstValid);
+        }
+    }
+
+    /// bulk version of push(): level 0 is built from the raw samples, each higher level only re-derives the buckets touched by
+    /// this batch from its kFanOut children, i.e. O(n) in total instead of O(n * levels)
+    template<std::ranges::random_access_range Range>
+    requires std::ranges::sized_range<Range>
+    void pushRange(const Range& values) {
+        const std::size_t n = std::ranges::size(values);
+        if (n == 0UZ) {
+            return;
+        }
+        const std::size_t first = _count;
+        _count += n;
+
+        Level& level0 = _levels.front();
+        for (std::size_t i = 0UZ; i < n;) {
+            const std::size_t bucket   = (first + i) / level0.bucketSize;
+            const std::size_t chunkEnd = std::min(n, (bucket + 1UZ) * level0.bucketSize - first);
+            const T           value0   = static_cast<T>(values[i]);
+            Extrema           extrema{.minIndex = first + i, .maxIndex = first + i, .min = value0, .max = value0};
+            for (std::size_t j = i + 1UZ; j < chunkEnd; ++j) {
+                const T value = static_cast<T>(values[j]);
+                extrema.merge(Extrema{.minIndex = first + j, .maxIndex = first + j, .min = value, .max = value});
+            }
+            mergeInto(level0, bucket, extrema);
+            i = chunkEnd;
+        }
+
+        for (std::size_t l = 1UZ; l < _levels.size(); ++l) {
+            Level&       level    = _levels[l];
+            const Level& children = _levels[l - 1UZ];
+            const auto   childEnd = children.firstBucket + children.buckets.size();
+            for (std::size_t bucket = first / level.bucketSize; bucket <= (_count - 1UZ) / level.bucketSize; ++bucket) {
+                // children of evicted samples may be gone already, queries never cover those samples
+                const std::size_t childFirst = std::max(bucket * kFanOut, children.firstBucket);
+                const std::size_t childLast  = std::min((bucket + 1UZ) * kFanOut, childEnd);
+                if (childFirst >= childLast) {
+                    continue;
+                }
+                Extrema extrema = children.buckets[childFirst - children.firstBucket];
+                for (std::size_t child = childFirst + 1UZ; child < childLast; ++child) {
+                    extrema.merge(children.buckets[child - children.firstBucket]);
+                }
+                replaceIn(level, bucket, extrema);
+            }
+        }
+
+        const std::size_t firstValid = _count > _capacity ? _count - _capacity : 0UZ;
+        for (Level& level : _levels) {
+            evictBefore(level, firstValid);
+        }
+    }
+
+    /// extrema of the absolute sample range [first, first + n), n > 0; `sampleAt(absoluteIndex)` returns the raw sample for the
+    /// unaligned edges and must be valid for every index of the range
+    template<typename SampleAt>
+    [[nodiscard]] Extrema extrema(std::size_t first, std::size_t n, SampleAt&& sampleAt) const {
+        const std::size_t end    = first + n;
+        const T           value0 = static_cast<T>(sampleAt(first));
+        Extrema           result{.minIndex = first, .maxIndex = first, .min = value0, .max = value0};
+        for (std::size_t i = first; i < end;) {
+            const Extrema* bucket = nullptr;
+            std::size_t    step   = 1UZ;
+            for (auto level = _levels.rbegin(); level != _levels.rend(); ++level) {
+                if (i % level->bucketSize != 0UZ || i + level->bucketSize > end || i + level->bucketSize > _count) {
+                    continue;
+                }
+                const std::size_t bucketIndex = i / level->bucketSize;
+                if (bucketIndex >= level->firstBucket && bucketIndex < level->firstBucket + level->buckets.size()) {
+                    bucket = &level->buckets[bucketIndex - level->firstBucket];
+                    step   = level->bucketSize;
+                    break;
+                }
+            }
+            if (bucket != nullptr) {
+                result.merge(*bucket);
+            } else {
+                const T value = static_cast<T>(sampleAt(i));
+                result.merge(Extrema{.minIndex = i, .maxIndex = i, .min = value, .max = value});
+            }
+            i += step;
+        }
+        return result;
+    }
+};
+
+} // namespace opendigitizer::charts
+
+#endif // OPENDIGITIZER_CHARTS_MINMAXPYRAMID_HPP
@@ -0,0 +1,84 @@
+#ifndef OPENDIGITIZER_CHARTS_RENDERPREP_HPP
+#define OPENDIGITIZER_CHARTS_RENDERPREP_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <gnuradio-4.0/thread/thread_pool.hpp>
+
+#include "../common/FramePacer.hpp"
+
+namespace opendigitizer::charts {
+
+/// worker pool shared by all charts for turning sink data into plot-ready buffers off the UI thread
+inline gr::thread_pool::BasicThreadPool& renderPrepPool() {
+    static gr::thread_pool::BasicThreadPool pool("ui-render-prep", gr::thread_pool::TaskType::CPU_BOUND, 1U, std::max(1U, std::thread::hardware_concurrency() / 2U));
+    return pool;
+}
+
+/**
+ * @brief Hand-off of one chart item's plot-ready buffers, prepared on renderPrepPool() and consumed by the UI thread.
+ *
+ * The UI thread reads latest() every frame and calls submit() whenever it wants a fresher result. At most one job per slot is
+ * in flight: submit() is a no-op while the previous job still runs, so a slow job skips intermediate requests rather than
+ * queueing them. A finished job publishes its result as an immutable shared_ptr and requests a UI frame to present it.
+ *
+ * Jobs own everything they touch (e.g. a shared_ptr to the sink) and must take the sink's data lock themselves. The slot
+ * may be destroyed while a job is running, the job then finishes into the detached state.
+ */
+template<typename TResult>
+class RenderPrepSlot {
+    struct State {
+        mutable std::mutex             mutex;
+        std::shared_ptr<const TResult> ready;
+        std::atomic<bool>              busy{false};
+    };
+    std::shared_ptr<State> _state = std::make_shared<State>();
+
+public:
+    /// newest published result, nullptr until the first job finished
+    [[nodiscard]] std::shared_ptr<const TResult> latest() const {
+        std::lock_guard lock(_state->mutex);
+        return _state->ready;
+    }
+
+    [[nodiscard]] bool busy() const noexcept { return _state->busy.load(std::memory_order_acquire); }
+
+    /// runs `job` on renderPrepPool() unless a job is already in flight; `job` returns std::nullopt to keep the previous result
+    template<std::invocable Job>
+    requires std::same_as<std::invoke_result_t<Job>, std::optional<TResult>>
+    bool submit(Job&& job) {
+        if (_state->busy.exchange(true, std::memory_order_acq_rel)) {
+            return false;
+        }
+        renderPrepPool().execute([state = _state, job = std::forward<Job>(job)]() mutable {
+            struct ClearBusy {
+                State& state;
+                ~ClearBusy() { state.busy.store(false, std::memory_order_release); }
+            } clearBusy{*state};
+
+            std::optional<TResult> result = job();
+            if (!result) {
+                return;
+            }
+            auto published = std::make_shared<const TResult>(std::move(*result));
+            {
+                std::lock_guard lock(state->mutex);
+                state->ready = std::move(published);
+            }
+            DigitizerUi::globalFramePacer().requestFrame(); // present the new buffers
+        });
+        return true;
+    }
+};
+
+} // namespace opendigitizer::charts
+
+#endif // OPENDIGITIZER_CHARTS_RENDERPREP_HPP
@@ -6,8 +6,10 @@
 #include <gnuradio-4.0/Block.hpp>
 #include <gnuradio-4.0/DataSet.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cmath>
 #include <cstdint>
 #include <functional>
 #include <limits>
@@ -17,6 +19,8 @@
 #include <string_view>
 #include <vector>
 
+#include "ImplicitTimeAxis.hpp"
+
 namespace opendigitizer {
 
 // ImPlot-compatible point struct (mirrors ImPlotPoint but library-independent)
@@ -131,6 +135,67 @@ struct SignalSink {
     [[nodiscard]] virtual double      xAt(std::size_t index) const = 0;
     [[nodiscard]] virtual float       yAt(std::size_t index) const = 0;
 
+    struct SampleSpans {
+        std::span<const double>                    x;                    // X values of the requested range, empty if generated from xAxis
+        std::span<const float>                     y;                    // Y values of the requested range
+        std::shared_ptr<const std::vector<double>> _xStorage;            // keeps copied data alive for sinks without contiguous X storage
+        std::shared_ptr<const std::vector<float>>  _yStorage;            // keeps converted data alive when T != float
+        const charts::ImplicitTimeAxis*            xAxis      = nullptr; // sinks storing X as segment anchors (e.g. ImPlotSink), valid under dataGuard()
+        std::size_t                                xAxisStart = 0UZ;     // axis index of the first sample of the range
+
+        [[nodiscard]] std::size_t size() const noexcept { return y.size(); }
+        [[nodiscard]] bool        empty() const noexcept { return y.empty(); }
+
+        [[nodiscard]] double xAt(std::size_t i) const { return xAxis != nullptr ? (*xAxis)[xAxisStart + i] : x[i]; }
+
+        /// writes the X values [startIndex, startIndex + out.size()) of the range to `out`
+        void fillX(std::size_t startIndex, std::span<double> out) const {
+            if (xAxis != nullptr) {
+                xAxis->fill(xAxisStart + startIndex, out);
+            } else {
+                std::ranges::copy(x.subspan(startIndex, out.size()), out.begin());
+            }
+        }
+    };
+
+    /// bulk access to the samples [startIndex, startIndex + count) as contiguous spans, to be fetched once per frame instead of
+    /// calling xAt()/yAt() per sample (caller must hold dataGuard()); default: copy via xAt()/yAt(), sinks with contiguous
+    /// buffers (e.g. ImPlotSink's HistoryBuffer) return views without copying, read X through SampleSpans::xAt()/fillX()
+    [[nodiscard]] virtual SampleSpans samples(std::size_t startIndex, std::size_t count) const {
+        auto xStorage = std::make_shared<std::vector<double>>(count);
+        auto yStorage = std::make_shared<std::vector<float>>(count);
+        for (std::size_t i = 0UZ; i < count; ++i) {
+            (*xStorage)[i] = xAt(startIndex + i);
+            (*yStorage)[i] = yAt(startIndex + i);
+        }
+        return {.x = std::span<const double>(*xStorage), .y = std::span<const float>(*yStorage), ._xStorage = std::move(xStorage), ._yStorage = std::move(yStorage)};
+    }
+
+    struct YExtrema {
+        std::size_t min_index; // index of the (first) minimum within the whole buffer
+        std::size_t max_index; // index of the (first) maximum within the whole buffer
+        float       min;
+        float       max;
+    };
+
+    /// min/max of the Y values in [startIndex, startIndex + count), count > 0 (caller must hold dataGuard())
+    /// default: linear scan, sinks keeping min/max summaries (e.g. ImPlotSink) answer in O(log(count))
+    [[nodiscard]] virtual YExtrema yExtrema(std::size_t startIndex, std::size_t count) const {
+        YExtrema result{.min_index = startIndex, .max_index = startIndex, .min = yAt(startIndex), .max = yAt(startIndex)};
+        for (std::size_t i = startIndex + 1UZ; i < startIndex + count; ++i) {
+            const float y = yAt(i);
+            if (y < result.min || std::isnan(result.min)) {
+                result.min       = y;
+                result.min_index = i;
+            }
+            if (y > result.max || std::isnan(result.max)) {
+                result.max       = y;
+                result.max_index = i;
+            }
+        }
+        return result;
+    }
+
     [[nodiscard]] virtual PlotData plotData() const = 0;
 
     [[nodiscard]] virtual bool                                hasDataSets() const noexcept  = 0;
@@ -142,6 +207,16 @@ struct SignalSink {
     [[nodiscard]] virtual std::pair<double, double> tagTimeRange() const noexcept                                                                        = 0;
     virtual void                                    forEachTag(std::function<void(double timestamp, const gr::property_map& properties)> callback) const = 0;
 
+    /// visits the tags with tMin <= timestamp <= tMax; default: filters forEachTag(), sinks with a time-sorted tag index
+    /// (e.g. ImPlotSink) only visit the matching tags
+    virtual void forEachTagInRange(double tMin, double tMax, std::function<void(double timestamp, const gr::property_map& properties)> callback) const {
+        forEachTag([tMin, tMax, &callback](double timestamp, const gr::property_map& properties) {
+            if (timestamp >= tMin && timestamp <= tMax) {
+                callback(timestamp, properties);
+            }
+        });
+    }
+
     [[nodiscard]] virtual double timeFirst() const noexcept = 0;
     [[nodiscard]] virtual double timeLast() const noexcept  = 0;
 
@@ -168,9 +243,10 @@ struct SignalSink {
     [[nodiscard]] virtual DataRange getTagRange(double tMin, double tMax) const = 0;
 
     struct XRangeResult {
-        std::span<const double> data;         // X values in the requested range
-        double                  actual_t_min; // actual start time of returned data
-        double                  actual_t_max; // actual end time of returned data
+        std::span<const double>                    data;         // X values in the requested range
+        double                                     actual_t_min; // actual start time of returned data
+        double                                     actual_t_max; // actual end time of returned data
+        std::shared_ptr<const std::vector<double>> _storage;     // keeps generated data alive for sinks without stored X values
 
         [[nodiscard]] bool empty() const noexcept { return data.empty(); }
     };
@@ -238,9 +314,9 @@ struct SignalSink {
             // Get the X value at current index to find matching tags
             double xVal = _sink->xAt(_index);
 
-            // Use forEachTag to find tags near this X value (within tolerance)
+            // look up only the tags near this X value (within tolerance) instead of visiting all tags
             constexpr double kTagTolerance = 1e-9; // nanosecond precision
-            _sink->forEachTag([this, xVal](double timestamp, const gr::property_map& props) {
+            _sink->forEachTagInRange(xVal - kTagTolerance, xVal + kTagTolerance, [this, xVal](double timestamp, const gr::property_map& props) {
                 if (std::abs(timestamp - xVal) < kTagTolerance) {
                     _tagCache.push_back(props);
                 }
@@ -354,7 +430,8 @@ struct SinkAdapter : public SignalSink {
     SinkAdapter(SinkAdapter&&)                 = delete;
     SinkAdapter& operator=(SinkAdapter&&)      = delete;
 
-    /// called by the owning block's destructor to prevent dangling access
+    /// called by the owning block's destructor to prevent dangling access; blocks with a shared data mutex call it with that
+    /// mutex held, so a blockPtr() re-checked under dataGuard() stays valid until the guard is released
     void invalidate() noexcept { _block.store(nullptr, std::memory_order_release); }
 
     [[nodiscard]] T* blockPtr() const noexcept { return _block.load(std::memory_order_acquire); }
@@ -536,6 +613,28 @@ struct SinkAdapter : public SignalSink {
         return 0.0f;
     }
 
+    [[nodiscard]] SampleSpans samples(std::size_t startIndex, std::size_t count) const override {
+        auto* b = blockPtr();
+        if (!b) {
+            return {};
+        }
+        if constexpr (requires { b->samples(startIndex, count); }) {
+            return b->samples(startIndex, count);
+        }
+        return SignalSink::samples(startIndex, count);
+    }
+
+    [[nodiscard]] YExtrema yExtrema(std::size_t startIndex, std::size_t count) const override {
+        auto* b = blockPtr();
+        if (!b) {
+            return {.min_index = startIndex, .max_index = startIndex, .min = 0.0f, .max = 0.0f};
+        }
+        if constexpr (requires { b->yExtrema(startIndex, count); }) {
+            return b->yExtrema(startIndex, count);
+        }
+        return SignalSink::yExtrema(startIndex, count);
+    }
+
     [[nodiscard]] PlotData plotData() const override {
         auto* b = blockPtr();
         if (!b) {
@@ -623,6 +722,18 @@ struct SinkAdapter : public SignalSink {
         }
     }
 
+    void forEachTagInRange(double tMin, double tMax, std::function<void(double, const gr::property_map&)> callback) const override {
+        auto* b = blockPtr();
+        if (!b) {
+            return;
+        }
+        if constexpr (requires { b->forEachTagInRange(tMin, tMax, callback); }) {
+            b->forEachTagInRange(tMin, tMax, std::move(callback));
+        } else {
+            SignalSink::forEachTagInRange(tMin, tMax, std::move(callback));
+        }
+    }
+
     [[nodiscard]] double timeFirst() const noexcept override {
         auto* b = blockPtr();
         if (!b) {
@@ -670,22 +781,38 @@ struct SinkAdapter : public SignalSink {
     }
 
     void requestCapacity(std::string_view source, std::size_t capacity, std::chrono::seconds timeout = std::chrono::seconds{60}) override {
-        auto* b = blockPtr();
-        if (!b) {
-            return;
-        }
-        if constexpr (requires { b->requestCapacity(source, capacity, timeout); }) {
-            b->requestCapacity(source, capacity, timeout);
+        if constexpr (requires(T& block) { block.requestCapacityLocked(source, capacity, timeout); }) {
+            auto  guard = dataGuard();
+            auto* b     = blockPtr(); // re-checked under the lock, the block invalidates the adapter under it before it is destroyed
+            if (b) {
+                b->requestCapacityLocked(source, capacity, timeout);
+            }
+        } else {
+            auto* b = blockPtr();
+            if (!b) {
+                return;
+            }
+            if constexpr (requires { b->requestCapacity(source, capacity, timeout); }) {
+                b->requestCapacity(source, capacity, timeout);
+            }
         }
     }
 
     void expireCapacityRequests() override {
-        auto* b = blockPtr();
-        if (!b) {
-            return;
-        }
-        if constexpr (requires { b->expireCapacityRequests(); }) {
-            b->expireCapacityRequests();
+        if constexpr (requires(T& block) { block.expireCapacityRequestsLocked(); }) {
+            auto  guard = dataGuard();
+            auto* b     = blockPtr(); // see requestCapacity()
+            if (b) {
+                b->expireCapacityRequestsLocked();
+            }
+        } else {
+            auto* b = blockPtr();
+            if (!b) {
+                return;
+            }
+            if constexpr (requires { b->expireCapacityRequests(); }) {
+                b->expireCapacityRequests();
+            }
         }
     }
 
@@ -764,7 +891,13 @@ struct SinkAdapter : public SignalSink {
 
     [[nodiscard]] DataGuard dataGuard() const override {
         if (_sharedMutex) {
-            return DataGuard(*_sharedMutex);
+            DataGuard guard(*_sharedMutex);
+            if constexpr (requires(T& block) { block.publishPending(); }) {
+                if (auto* b = blockPtr()) {
+                    b->publishPending(); // data the producer left pending because the lock was taken, see ImPlotSink::processBulk()
+                }
+            }
+            return guard;
         }
         return DataGuard(_fallbackMutex);
     }
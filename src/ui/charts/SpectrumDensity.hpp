@@ -48,6 +48,9 @@ struct SpectrumDensity : gr::Block<SpectrumDensity, gr::Drawable<gr::UICategory:
     A<bool, "GPU acceleration", gr::Doc<"use GPU shaders for histogram (falls back to CPU if unavailable)">> gpu_acceleration = true;
     A<bool, "adaptive Y range", gr::Visible, gr::Doc<"rebin histogram to visible Y-axis range on zoom">>     adaptive_y_range = true;
 
+    // log-frequency mode
+    LogBinningSetting log_binning = LogBinning::Max;
+
     // axis limits
     A<bool, "X auto-scale"> x_auto_scale = true;
     A<bool, "Y auto-scale"> y_auto_scale = false;
@@ -58,11 +61,12 @@ struct SpectrumDensity : gr::Block<SpectrumDensity, gr::Drawable<gr::UICategory:
 
     static constexpr SignalKind supportedSignals = SignalKind::Dataset1D;
 
-    GR_MAKE_REFLECTABLE(SpectrumDensity, chart_name, chart_title, data_sinks, show_legend, show_grid, amplitude_bins, colormap, histogram_decay_tau_frames, gpu_acceleration, adaptive_y_range, show_current_overlay, show_max_hold, show_min_hold, show_average, trace_color, trace_decay_tau_frames, x_auto_scale, y_auto_scale, x_min, x_max, y_min, y_max);
+    GR_MAKE_REFLECTABLE(SpectrumDensity, chart_name, chart_title, data_sinks, show_legend, show_grid, amplitude_bins, colormap, histogram_decay_tau_frames, gpu_acceleration, log_binning, adaptive_y_range, show_current_overlay, show_max_hold, show_min_hold, show_average, trace_color, trace_decay_tau_frames, x_auto_scale, y_auto_scale, x_min, x_max, y_min, y_max);
 
     DensityHistogram             _density;
     TraceAccumulator             _traces;
     std::vector<float>           _logRow; // scratch: linear spectrum re-binned onto log-spaced columns
+    LogBinningPlan               _logPlan;
     std::size_t                  _lastSampleCount = std::numeric_limits<std::size_t>::max();
     std::array<std::string, 6UZ> _unitStore{};
     double                       _lastSetYMin         = std::numeric_limits<double>::quiet_NaN();
@@ -212,7 +216,7 @@ struct SpectrumDensity : gr::Block<SpectrumDensity, gr::Drawable<gr::UICategory:
             if (logRange) {
                 if (newData) {
                     _logRow.resize(kLogSpectrumColumns);
-                    buildLogBinnedRow(f.xValues, f.yValues, f.nBins, logRange->min, logRange->max, _logRow);
+                    _logPlan.apply(f.xValues, f.yValues, f.nBins, logRange->min, logRange->max, _logRow, log_binning.value);
                     _density.update(_logRow, kLogSpectrumColumns, ampBins, static_cast<double>(histogram_decay_tau_frames), effYMin, effYMax, colormap.value, gpu_acceleration);
                 }
                 _density.plot(logRange->min, logRange->max, effYMin, effYMax);
@@ -7,13 +7,19 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <latch>
 #include <limits>
+#include <numeric>
 #include <ranges>
 #include <span>
+#include <thread>
 #include <utility>
 #include <vector>
 
+#include <gnuradio-4.0/annotated.hpp>
+
 #include "../utils/ShaderHelper.hpp"
+#include "RenderPrep.hpp"
 #include <implot.h>
 
 namespace opendigitizer::charts {
@@ -51,6 +57,56 @@ inline uint32_t colormapLookup(double value, double scaleMin, double scaleMax, s
     return lut[idx];
 }
 
+/// value -> LUT index mapping of colourise(), computed once per batch: index = value * scale + offset (of log10(value) if `log`)
+struct ColormapScale {
+    float scale  = 0.f; // 0: degenerate range, everything maps to lut[0]
+    float offset = 0.f;
+    bool  log    = false;
+
+    [[nodiscard]] static ColormapScale linear(double scaleMin, double scaleMax) noexcept {
+        if (!(scaleMax > scaleMin)) {
+            return {};
+        }
+        const double scale = static_cast<double>(kColormapSize - 1) / (scaleMax - scaleMin);
+        return {.scale = static_cast<float>(scale), .offset = static_cast<float>(-scaleMin * scale)};
+    }
+
+    /// log-scale mapping of [scaleMin, scaleMax], scaleMin > 0; values <= 0 map to lut[0]
+    [[nodiscard]] static ColormapScale logarithmic(double scaleMin, double scaleMax) noexcept {
+        if (!(scaleMin > 0.0) || !(scaleMax > scaleMin)) {
+            return {.log = true};
+        }
+        ColormapScale result = linear(std::log10(scaleMin), std::log10(scaleMax));
+        result.log           = true;
+        return result;
+    }
+
+    /// LUT index of `x` (the value, or its log10), 0 if the value `v` is not finite
+    [[nodiscard]] std::size_t index(float x, float v) const noexcept {
+        constexpr float kMaxIndex = static_cast<float>(kColormapSize - 1);
+        float           t         = x * scale + offset;
+        t                         = t > 0.f ? t : 0.f; // also maps NaN to 0
+        t                         = t < kMaxIndex ? t : kMaxIndex;
+        return static_cast<std::size_t>((v - v) == 0.f ? static_cast<int32_t>(t) : int32_t{0}); // v - v is NaN for +-inf and NaN
+    }
+};
+
+/// Batched colormapLookup(): maps `values` through `lut` into `out` (same size) in float with a precomputed scale.
+/// Non-finite values map to lut[0]; the index loop is branch-free so that only the LUT gather is scalar.
+inline void colourise(std::span<const float> values, std::span<uint32_t> out, const ColormapScale& mapping, std::span<const uint32_t, kColormapSize> lut) {
+    const std::size_t n = std::min(values.size(), out.size());
+    if (mapping.log) {
+        for (std::size_t i = 0; i < n; ++i) {
+            const float v = values[i];
+            out[i]        = v > 0.f ? lut[mapping.index(std::log10(v), v)] : lut[0];
+        }
+        return;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = lut[mapping.index(values[i], values[i])];
+    }
+}
+
 struct SpectrumFrame {
     std::span<const float> xValues;
     std::span<const float> yValues;
@@ -190,8 +246,51 @@ inline void plotTrace(const char* label, std::span<const float> xValues, std::sp
 /// fixed number of log-spaced display columns for a log-frequency spectrum (waterfall/density/surface).
 inline constexpr std::size_t kLogSpectrumColumns = 2048;
 
+/// upper bound on display columns of a linear spectrum; wider spectra are decimated with decimateRow() before upload.
+inline constexpr std::size_t kMaxSpectrumColumns = 4096;
+
+enum class Decimation {
+    MaxHold, ///< largest bin of each column, keeps narrow lines visible at any ratio
+    Rms      ///< root-mean-square of each column, keeps the integrated level of noise-like spectra
+};
+
+/// first input bin of display column `col` when `nIn` bins are aggregated onto `nOut` columns by decimateRow().
+[[nodiscard]] constexpr std::size_t decimatedColumnBegin(std::size_t col, std::size_t nIn, std::size_t nOut) noexcept { return col * nIn / nOut; }
+
+/// Aggregates `in` onto `out.size()` columns in a single pass. Column c covers the bins [c*n/w, (c+1)*n/w), so every bin lands
+/// in exactly one column for any (also non-integer) ratio and peaks do not flicker as the ratio changes. Columns finer than
+/// the bin spacing (w > n) repeat their bin.
+inline void decimateRow(std::span<const float> in, std::span<float> out, Decimation mode = Decimation::MaxHold) {
+    const std::size_t nIn  = in.size();
+    const std::size_t nOut = out.size();
+    if (nIn == 0 || nOut == 0) {
+        std::ranges::fill(out, 0.0f);
+        return;
+    }
+    for (std::size_t col = 0; col < nOut; ++col) {
+        const std::size_t first = decimatedColumnBegin(col, nIn, nOut);
+        const std::size_t last  = std::max(decimatedColumnBegin(col + 1, nIn, nOut), first + 1);
+        if (mode == Decimation::MaxHold) {
+            float peak = in[first];
+            for (std::size_t k = first + 1; k < last; ++k) {
+                if (in[k] > peak || std::isnan(peak)) { // a NaN bin never hides a number
+                    peak = in[k];
+                }
+            }
+            out[col] = peak;
+        } else {
+            double sumSq = 0.0;
+            for (std::size_t k = first; k < last; ++k) {
+                sumSq += static_cast<double>(in[k]) * static_cast<double>(in[k]);
+            }
+            out[col] = static_cast<float>(std::sqrt(sumSq / static_cast<double>(last - first)));
+        }
+    }
+}
+
 /// Re-sample a linear spectrum (`freqs`/`mags`, `nBins`) onto `out.size()` log-spaced columns over [fMin, fMax]:
 /// peak-preserving max-aggregate, then fill columns finer than the bin spacing. Keeps low-frequency detail on a log axis.
+/// Reference implementation; charts re-bin every row with a cached LogBinningPlan instead.
 inline void buildLogBinnedRow(std::span<const float> freqs, std::span<const float> mags, std::size_t nBins, double fMin, double fMax, std::span<float> out) {
     std::ranges::fill(out, -std::numeric_limits<float>::infinity());
     const std::size_t nCols  = out.size();
@@ -229,6 +328,144 @@ inline void buildLogBinnedRow(std::span<const float> freqs, std::span<const floa
     }
 }
 
+enum class LogBinning : int { Max = 0, Mean = 1, PowerSum = 2 }; // aggregation of the dB bins that fall into one log-frequency column
+
+/// `log_binning` setting of the charts that re-bin a spectrum onto log-frequency columns
+using LogBinningSetting = gr::Annotated<LogBinning, "log binning", gr::Doc<"aggregation of the FFT bins per log-frequency column: Max keeps peaks, Mean averages dB, PowerSum keeps the band power">>;
+
+/**
+ * @brief Cached bin-to-column mapping of buildLogBinnedRow(), so that re-binning a spectrum needs no log() per bin.
+ *
+ * The plan is rebuilt only when the bin count, the column count, the display range or the end points of the frequency axis
+ * change. Bins are stored grouped by column (a contiguous slice for the usual ascending axis), hence each column is one
+ * streaming reduction: Max keeps narrow peaks, Mean averages the dB values and PowerSum adds the bin powers
+ * (10 log10 sum 10^(x/10)), i.e. keeps the band power. As in buildLogBinnedRow(), columns without bins or with a non-finite
+ * aggregate repeat their left neighbour, leading ones the first occupied column.
+ */
+class LogBinningPlan {
+    struct Key {
+        std::size_t nBins  = 0UZ;
+        std::size_t nCols  = 0UZ;
+        double      fMin   = 0.0;
+        double      fMax   = 0.0;
+        float       fFirst = 0.f;
+        float       fLast  = 0.f;
+
+        bool operator==(const Key&) const = default;
+    };
+
+    Key                   _key{};
+    bool                  _valid      = false;
+    std::size_t           _builds     = 0UZ;
+    bool                  _contiguous = true; // _bins[j] == _bins[0] + j
+    std::vector<uint32_t> _colBegin;          // nCols + 1 offsets into _bins
+    std::vector<uint32_t> _bins;              // source bins grouped by column
+
+    /// non-finite bins (-inf dB of a zero-power bin, NaN) are skipped, -inf if the column has no finite bin
+    template<typename Values>
+    [[nodiscard]] static float reduce(const Values& values, LogBinning mode) {
+        switch (mode) {
+        case LogBinning::Mean: {
+            float       sum     = 0.f;
+            std::size_t nFinite = 0UZ;
+            for (float v : values) {
+                if (std::isfinite(v)) {
+                    sum += v;
+                    ++nFinite;
+                }
+            }
+            return nFinite > 0UZ ? sum / static_cast<float>(nFinite) : -std::numeric_limits<float>::infinity();
+        }
+        case LogBinning::PowerSum: {
+            constexpr float kDbToLn = 0.2302585093f; // ln(10) / 10
+            float           power   = 0.f;
+            bool            anyBin  = false;
+            for (float v : values) {
+                if (std::isfinite(v)) {
+                    power += std::exp(v * kDbToLn);
+                    anyBin = true;
+                }
+            }
+            return anyBin ? 10.f * std::log10(power) : -std::numeric_limits<float>::infinity();
+        }
+        case LogBinning::Max:
+        default: {
+            float peak = -std::numeric_limits<float>::infinity();
+            for (float v : values) {
+                peak = v > peak ? v : peak; // NaN bins never win
+            }
+            return peak;
+        }
+        }
+    }
+
+public:
+    /// number of (re-)builds of the mapping so far
+    [[nodiscard]] std::size_t builds() const noexcept { return _builds; }
+
+    /// makes the plan match (`freqs`, `nBins`, [fMin, fMax], `nCols`); returns true if it had to be rebuilt
+    bool prepare(std::span<const float> freqs, std::size_t nBins, double fMin, double fMax, std::size_t nCols) {
+        const Key key{.nBins = nBins, .nCols = nCols, .fMin = fMin, .fMax = fMax, .fFirst = nBins > 0 ? freqs[0] : 0.f, .fLast = nBins > 0 ? freqs[nBins - 1] : 0.f};
+        if (_valid && key == _key) {
+            return false;
+        }
+        _key   = key;
+        _valid = true;
+        ++_builds;
+
+        const double          logMin = std::log(fMin);
+        const double          span   = std::log(fMax) - logMin;
+        std::vector<uint32_t> colOf(nBins, static_cast<uint32_t>(nCols)); // nCols: outside [fMin, fMax]
+        _colBegin.assign(nCols + 1UZ, 0U);
+        for (std::size_t k = 0; k < nBins && nCols > 0; ++k) {
+            const double freq = static_cast<double>(freqs[k]);
+            if (freq < fMin || freq > fMax) {
+                continue;
+            }
+            colOf[k] = static_cast<uint32_t>(std::min(static_cast<std::size_t>((std::log(freq) - logMin) / span * static_cast<double>(nCols)), nCols - 1));
+            ++_colBegin[colOf[k] + 1UZ];
+        }
+        std::partial_sum(_colBegin.begin(), _colBegin.end(), _colBegin.begin());
+
+        _bins.resize(_colBegin.back());
+        std::vector<uint32_t> cursor(_colBegin.begin(), _colBegin.end() - 1);
+        for (std::size_t k = 0; k < nBins; ++k) {
+            if (colOf[k] < nCols) {
+                _bins[cursor[colOf[k]]++] = static_cast<uint32_t>(k);
+            }
+        }
+        _contiguous = std::ranges::adjacent_find(_bins, [](uint32_t a, uint32_t b) { return b != a + 1U; }) == _bins.end();
+        return true;
+    }
+
+    /// re-bins `mags` onto `out.size()` columns, see buildLogBinnedRow(); returns true if the plan had to be rebuilt
+    bool apply(std::span<const float> freqs, std::span<const float> mags, std::size_t nBins, double fMin, double fMax, std::span<float> out, LogBinning mode = LogBinning::Max) {
+        const bool rebuilt = prepare(freqs, nBins, fMin, fMax, out.size());
+
+        float       carry         = 0.f;
+        std::size_t firstOccupied = out.size();
+        for (std::size_t col = 0; col < out.size(); ++col) {
+            const std::size_t begin = _colBegin[col];
+            const std::size_t n     = _colBegin[col + 1UZ] - begin;
+            float             value = std::numeric_limits<float>::quiet_NaN();
+            if (n > 0 && _contiguous) {
+                value = reduce(mags.subspan(_bins[begin], n), mode);
+            } else if (n > 0) {
+                value = reduce(std::span(_bins).subspan(begin, n) | std::views::transform([&](uint32_t k) { return mags[k]; }), mode);
+            }
+            if (std::isfinite(value)) { // forward-fill: propagate the last occupied column into the gaps above it
+                carry         = value;
+                firstOccupied = std::min(firstOccupied, col);
+            }
+            out[col] = firstOccupied <= col ? carry : 0.f;
+        }
+        if (firstOccupied < out.size()) { // back-fill leading columns (below the first occupied bin) with the first value
+            std::fill_n(out.begin(), firstOccupied, out[firstOccupied]);
+        }
+        return rebuilt;
+    }
+};
+
 inline void drawTraceOverlays(TraceAccumulator& traces, bool newData, std::span<const float> xValues, std::span<const float> yValues, std::size_t nBins, double decayTau, const ImVec4& baseColor, bool showMaxHold, bool showMinHold, bool showAverage) {
     const bool anyEnabled = showMaxHold || showMinHold || showAverage;
     if (newData) {
@@ -250,6 +487,152 @@ inline void drawTraceOverlays(TraceAccumulator& traces, bool newData, std::span<
     }
 }
 
+/**
+ * @brief CPU kernel of DensityHistogram: decay, accumulation, peak normalisation and colormap lookup in float.
+ *
+ * Decay scales all cells uniformly, hence the peak density is known without scanning the grid: it is the decayed previous
+ * peak merged with the cells hit by the new spectrum. Hits are pre-divided by the decay factor, so one pass per row decays
+ * the cells and maps them through colourise() while they are in cache. Both loops are branch-free for auto-vectorisation.
+ * Rows without any density (typically most amplitude bins away from the signal) are skipped, only the rows between
+ * dirtyBegin() and dirtyEnd() change per update. Large grids are split across renderPrepPool().
+ */
+struct DensityCpuKernel {
+    static constexpr float       kDensityFloor  = 1.f / 1024.f; // below one LUT step for any peak >= 1, flushed to zero
+    static constexpr float       kMinDecay      = 1e-6f;        // smaller decay factors clear the grid instead of scaling it
+    static constexpr std::size_t kParallelCells = 1UZ << 18;    // rows to colourise above this cell count are split across threads
+
+    static constexpr uint8_t kLive    = 1U; // row holds density
+    static constexpr uint8_t kPending = 2U; // row is decayed/colourised in the current update
+
+    std::size_t           _width      = 0; // spectrum bins
+    std::size_t           _height     = 0; // amplitude bins
+    float                 _peak       = 0.f;
+    float                 _scale      = 0.f; // LUT index per density unit of the last colourisation
+    std::size_t           _dirtyBegin = 0;
+    std::size_t           _dirtyEnd   = 0;
+    bool                  _allRows    = true; // colourise every row once after (re-)allocation
+    std::vector<float>    _cells;
+    std::vector<uint32_t> _pixels;
+    std::vector<uint8_t>  _rowState;
+    std::vector<uint32_t> _pendingRows; // scratch
+
+    void resize(std::size_t width, std::size_t height) {
+        _width  = width;
+        _height = height;
+        _cells.assign(width * height, 0.f);
+        _pixels.assign(width * height, 0U);
+        _rowState.assign(height, 0U);
+        _peak       = 0.f;
+        _scale      = 0.f;
+        _dirtyBegin = 0;
+        _dirtyEnd   = 0;
+        _allRows    = true;
+    }
+
+    void reset() { resize(_width, _height); }
+
+    [[nodiscard]] std::size_t               dirtyBegin() const noexcept { return _dirtyBegin; }
+    [[nodiscard]] std::size_t               dirtyEnd() const noexcept { return _dirtyEnd; }
+    [[nodiscard]] float                     peak() const noexcept { return _peak; }
+    [[nodiscard]] std::span<const float>    cells() const noexcept { return _cells; }
+    [[nodiscard]] std::span<const uint32_t> pixels() const noexcept { return _pixels; }
+    [[nodiscard]] std::span<const uint32_t> dirtyPixels() const noexcept { return std::span(_pixels).subspan(_dirtyBegin * _width, (_dirtyEnd - _dirtyBegin) * _width); }
+
+    /// `decayFactor` in [0, 1] scales the previous density, `lutChanged` forces re-colourising unchanged rows
+    void update(std::span<const float> yValues, std::size_t nBins, float decayFactor, double yMin, double yMax, std::span<const uint32_t, kColormapSize> lut, bool lutChanged = false) {
+        _dirtyBegin = _height;
+        _dirtyEnd   = _height;
+        if (_width == 0 || _height == 0) {
+            return;
+        }
+
+        float decay    = std::clamp(decayFactor, 0.f, 1.f);
+        float hitValue = 1.f / decay;
+        if (decay < kMinDecay) { // no memory: start from an empty grid, the colour pass then leaves the hits as they are
+            for (std::size_t row = 0; row < _height; ++row) {
+                if (_rowState[row] & kLive) {
+                    std::fill_n(_cells.begin() + static_cast<std::ptrdiff_t>(row * _width), _width, 0.f);
+                    _rowState[row] = kPending;
+                }
+            }
+            _peak    = 0.f;
+            decay    = 1.f;
+            hitValue = 1.f;
+        }
+
+        float        hitPeak  = 0.f;
+        const auto   nHits    = std::min(nBins, _width);
+        const double ampRange = yMax - yMin;
+        if (ampRange > 0.0) {
+            const double invRange = static_cast<double>(_height) / ampRange;
+            for (std::size_t i = 0; i < nHits; ++i) {
+                const auto val = static_cast<double>(yValues[i]);
+                if (!std::isfinite(val)) {
+                    continue;
+                }
+                const auto bin  = static_cast<std::size_t>(std::clamp((yMax - val) * invRange, 0.0, static_cast<double>(_height - 1)));
+                float&     cell = _cells[bin * _width + i];
+                cell += hitValue;
+                hitPeak        = std::max(hitPeak, cell * decay);
+                _rowState[bin] = kLive | kPending;
+            }
+        }
+
+        _peak                  = std::max(_peak * decay, hitPeak);
+        const float scale      = static_cast<float>(kColormapSize - 1) / std::max(_peak, 1.f);
+        const bool  liveRows   = decay < 1.f || scale != _scale; // every non-empty row changes
+        const bool  allRows    = lutChanged || _allRows;         // also the empty rows, they show lut[0]
+        _scale                 = scale;
+        _allRows               = false;
+
+        _pendingRows.clear();
+        for (std::size_t row = 0; row < _height; ++row) {
+            if (allRows || (_rowState[row] & kPending) || (liveRows && (_rowState[row] & kLive))) {
+                _pendingRows.push_back(static_cast<uint32_t>(row));
+            }
+        }
+        if (_pendingRows.empty()) {
+            return;
+        }
+        _dirtyBegin = _pendingRows.front();
+        _dirtyEnd   = _pendingRows.back() + 1UZ;
+
+        const auto colouriseRows = [&](std::size_t first, std::size_t last) {
+            for (std::size_t k = first; k < last; ++k) {
+                updateRow(_pendingRows[k], decay, scale, lut);
+            }
+        };
+        const std::size_t nRows   = _pendingRows.size();
+        const std::size_t nChunks = nRows * _width < kParallelCells ? 1UZ : std::min<std::size_t>(nRows, std::max(1U, std::thread::hardware_concurrency() / 2U));
+        if (nChunks == 1UZ) {
+            colouriseRows(0UZ, nRows);
+            return;
+        }
+        std::latch done(static_cast<std::ptrdiff_t>(nChunks - 1UZ));
+        for (std::size_t chunk = 1UZ; chunk < nChunks; ++chunk) {
+            renderPrepPool().execute([&, chunk] {
+                colouriseRows(chunk * nRows / nChunks, (chunk + 1UZ) * nRows / nChunks);
+                done.count_down();
+            });
+        }
+        colouriseRows(0UZ, nRows / nChunks);
+        done.wait();
+    }
+
+private:
+    void updateRow(std::size_t row, float decay, float scale, std::span<const uint32_t, kColormapSize> lut) {
+        const std::span<float> cells  = std::span(_cells).subspan(row * _width, _width);
+        float                  rowMax = 0.f;
+        for (float& cell : cells) {
+            const float v = cell * decay;
+            cell          = v < kDensityFloor ? 0.f : v;
+            rowMax        = std::max(rowMax, cell);
+        }
+        colourise(cells, std::span(_pixels).subspan(row * _width, _width), ColormapScale{.scale = scale}, lut);
+        _rowState[row] = rowMax > 0.f ? kLive : uint8_t{0};
+    }
+};
+
 namespace gl = opendigitizer::shader;
 
 /**
@@ -299,9 +682,8 @@ struct DensityHistogram {
     // reusable scratch buffers (avoid per-frame heap allocations)
     std::vector<float> _scratchBuffer;
 
-    // CPU fallback — full histogram in system memory, RGBA8 texture upload per frame
-    std::vector<float>                  _cpuHistogram;
-    std::vector<uint32_t>               _cpuPixels;
+    // CPU fallback — full histogram in system memory, RGBA8 upload of the changed rows per frame
+    DensityCpuKernel                    _cpuKernel;
     GLuint                              _cpuTexture        = 0;
     ImPlotColormap                      _cpuActiveColormap = -1;
     std::array<uint32_t, kColormapSize> _cpuColormapLut{};
@@ -349,8 +731,7 @@ struct DensityHistogram {
         swap(_locCmMaxDensity, o._locCmMaxDensity);
         swap(_peakDensity, o._peakDensity);
         swap(_scratchBuffer, o._scratchBuffer);
-        swap(_cpuHistogram, o._cpuHistogram);
-        swap(_cpuPixels, o._cpuPixels);
+        swap(_cpuKernel, o._cpuKernel);
         swap(_cpuTexture, o._cpuTexture);
         swap(_cpuActiveColormap, o._cpuActiveColormap);
         swap(_cpuColormapLut, o._cpuColormapLut);
@@ -497,8 +878,7 @@ void main() {
     }
 
     void destroyCpuResources() {
-        _cpuHistogram.clear();
-        _cpuPixels.clear();
+        _cpuKernel = DensityCpuKernel{};
         _cpuActiveColormap = -1;
         if (_cpuTexture) {
             glDeleteTextures(1, &_cpuTexture);
@@ -682,11 +1062,9 @@ void main() {
     }
 
     void cpuResize(std::size_t specBins, std::size_t ampBins) {
-        _specBins         = specBins;
-        _ampBins          = ampBins;
-        const auto nCells = _ampBins * _specBins;
-        _cpuHistogram.assign(nCells, 0.f);
-        _cpuPixels.assign(nCells, 0U);
+        _specBins = specBins;
+        _ampBins  = ampBins;
+        _cpuKernel.resize(_specBins, _ampBins);
 
         if (_cpuTexture) {
             glDeleteTextures(1, &_cpuTexture);
@@ -697,15 +1075,14 @@ void main() {
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, static_cast<GLsizei>(_specBins), static_cast<GLsizei>(_ampBins), 0, GL_RGBA, GL_UNSIGNED_BYTE, _cpuPixels.data());
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, static_cast<GLsizei>(_specBins), static_cast<GLsizei>(_ampBins), 0, GL_RGBA, GL_UNSIGNED_BYTE, _cpuKernel.pixels().data());
     }
 
     void cpuReset() {
-        std::ranges::fill(_cpuHistogram, 0.f);
-        std::ranges::fill(_cpuPixels, uint32_t(0));
+        _cpuKernel.reset();
         if (_cpuTexture && _specBins > 0 && _ampBins > 0) {
             glBindTexture(GL_TEXTURE_2D, _cpuTexture);
-            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, static_cast<GLsizei>(_specBins), static_cast<GLsizei>(_ampBins), GL_RGBA, GL_UNSIGNED_BYTE, _cpuPixels.data());
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, static_cast<GLsizei>(_specBins), static_cast<GLsizei>(_ampBins), GL_RGBA, GL_UNSIGNED_BYTE, _cpuKernel.pixels().data());
         }
     }
 
@@ -722,31 +1099,21 @@ void main() {
             _binningYMax = yMax;
         }
 
-        const double decayFactor = (decayTau > 0.0) ? (1.0 - 1.0 / decayTau) : 1.0;
-        for (auto& cell : _cpuHistogram) {
-            cell *= static_cast<float>(decayFactor);
-        }
-
-        const double ampRange = yMax - yMin;
-        if (ampRange > 0.0) {
-            const double invRange = static_cast<double>(_ampBins) / ampRange;
-            for (std::size_t i = 0; i < nBins; ++i) {
-                const auto val = static_cast<double>(yValues[i]);
-                const auto bin = static_cast<std::size_t>(std::clamp((yMax - val) * invRange, 0.0, static_cast<double>(_ampBins - 1)));
-                _cpuHistogram[bin * _specBins + i] += 1.f;
-            }
-        }
-
-        if (_cpuActiveColormap != colormap) {
+        const bool lutChanged = _cpuActiveColormap != colormap;
+        if (lutChanged) {
             _cpuActiveColormap = colormap;
             _cpuColormapLut    = buildColormapLut(colormap);
         }
 
-        const float maxDensity = std::max(*std::ranges::max_element(_cpuHistogram), 1.f);
-        std::ranges::transform(_cpuHistogram, _cpuPixels.begin(), [&](float density) { return colormapLookup(static_cast<double>(density), 0.0, static_cast<double>(maxDensity), _cpuColormapLut); });
+        const double decayFactor = (decayTau > 0.0) ? (1.0 - 1.0 / decayTau) : 1.0;
+        _cpuKernel.update(yValues, nBins, static_cast<float>(decayFactor), yMin, yMax, _cpuColormapLut, lutChanged);
 
+        const std::size_t dirtyRows = _cpuKernel.dirtyEnd() - _cpuKernel.dirtyBegin();
+        if (dirtyRows == 0) {
+            return;
+        }
         glBindTexture(GL_TEXTURE_2D, _cpuTexture);
-        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, static_cast<GLsizei>(_specBins), static_cast<GLsizei>(_ampBins), GL_RGBA, GL_UNSIGNED_BYTE, _cpuPixels.data());
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, static_cast<GLint>(_cpuKernel.dirtyBegin()), static_cast<GLsizei>(_specBins), static_cast<GLsizei>(dirtyRows), GL_RGBA, GL_UNSIGNED_BYTE, _cpuKernel.dirtyPixels().data());
     }
 
     void resize(std::size_t specBins, std::size_t ampBins) {
@@ -919,9 +1286,7 @@ struct WaterfallBuffer {
             }
 
             uint32_t* row = _pixels.data() + _writeRow * _width;
-            for (std::size_t i = 0; i < n; ++i) {
-                row[i] = colormapLookup(static_cast<double>(magnitudes[i]), scaleMin, scaleMax, _colormapLut);
-            }
+            colourise(magnitudes.first(n), std::span(row, n), ColormapScale::linear(scaleMin, scaleMax), _colormapLut);
             std::fill_n(row + n, _width - n, uint32_t(0));
 
             GLint prevTexture = 0;
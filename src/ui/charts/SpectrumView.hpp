@@ -57,6 +57,9 @@ struct SpectrumView : gr::Block<SpectrumView, gr::Drawable<gr::UICategory::Conte
     A<ImPlotColormap_, "colormap", gr::Visible>                                                              colormap         = ImPlotColormap_Viridis;
     A<bool, "GPU acceleration", gr::Doc<"use GPU texture for rendering (falls back to CPU if unavailable)">> gpu_acceleration = true;
 
+    // log-frequency mode
+    LogBinningSetting log_binning = LogBinning::Max;
+
     // pane layout
     A<float, "top pane ratio", gr::Limits<0.2f, 0.8f>, gr::Doc<"fraction of height for top pane">> top_pane_ratio = 0.4f;
 
@@ -70,13 +73,14 @@ struct SpectrumView : gr::Block<SpectrumView, gr::Drawable<gr::UICategory::Conte
 
     static constexpr SignalKind supportedSignals = SignalKind::Dataset1D;
 
-    GR_MAKE_REFLECTABLE(SpectrumView, chart_name, data_sinks, show_legend, show_grid, top_pane_mode, show_max_hold, show_min_hold, show_average, trace_color, decay_tau_frames, amplitude_bins, histogram_decay_tau_frames, show_current_overlay, n_history, colormap, gpu_acceleration, top_pane_ratio, x_auto_scale, y_auto_scale, x_min, x_max, y_min, y_max);
+    GR_MAKE_REFLECTABLE(SpectrumView, chart_name, data_sinks, show_legend, show_grid, top_pane_mode, show_max_hold, show_min_hold, show_average, trace_color, decay_tau_frames, amplitude_bins, histogram_decay_tau_frames, show_current_overlay, n_history, colormap, gpu_acceleration, log_binning, top_pane_ratio, x_auto_scale, y_auto_scale, x_min, x_max, y_min, y_max);
 
     std::unordered_map<std::string, TraceAccumulator> _tracesPerSink;
     std::unordered_map<std::string, std::size_t>      _topPaneSampleCountPerSink;
     DensityHistogram                                  _density;
     WaterfallBuffer                                   _waterfall;
-    std::vector<float>                                _logRow; // scratch: linear spectrum re-binned onto log-spaced columns
+    std::vector<float>                                _logRow; // scratch: linear spectrum re-binned onto log-spaced or decimated columns
+    LogBinningPlan                                    _logPlan;
     std::size_t                                       _lastSpectrumSize         = 0;
     std::size_t                                       _lastWaterfallSampleCount = std::numeric_limits<std::size_t>::max();
     std::array<float, 2UZ>                            _rowRatios                = {0.4f, 0.6f};
@@ -219,7 +223,7 @@ struct SpectrumView : gr::Block<SpectrumView, gr::Drawable<gr::UICategory::Conte
             if (logRange) {
                 if (newData) {
                     _logRow.resize(kLogSpectrumColumns);
-                    buildLogBinnedRow(f.xValues, f.yValues, f.nBins, logRange->min, logRange->max, _logRow);
+                    _logPlan.apply(f.xValues, f.yValues, f.nBins, logRange->min, logRange->max, _logRow, log_binning.value);
                     _density.update(_logRow, kLogSpectrumColumns, ampBins, static_cast<double>(histogram_decay_tau_frames), effYMin, effYMax, colormap.value, gpu_acceleration);
                 }
                 _density.plot(logRange->min, logRange->max, effYMin, effYMax);
@@ -304,7 +308,7 @@ struct SpectrumView : gr::Block<SpectrumView, gr::Drawable<gr::UICategory::Conte
                 return false;
             }
 
-            const std::size_t width = logRange ? kLogSpectrumColumns : f.nBins;
+            const std::size_t width = logRange ? kLogSpectrumColumns : std::min(f.nBins, kMaxSpectrumColumns);
             if (_lastSpectrumSize != width) {
                 _waterfall.init(width, static_cast<std::size_t>(n_history), gpu_acceleration);
                 _lastSpectrumSize = width;
@@ -313,9 +317,14 @@ struct SpectrumView : gr::Block<SpectrumView, gr::Drawable<gr::UICategory::Conte
             _waterfall.updateAutoScale(f.yValues, f.nBins);
             if (logRange) {
                 _logRow.resize(kLogSpectrumColumns);
-                buildLogBinnedRow(f.xValues, f.yValues, f.nBins, logRange->min, logRange->max, _logRow);
+                _logPlan.apply(f.xValues, f.yValues, f.nBins, logRange->min, logRange->max, _logRow, log_binning.value);
                 _waterfall.pushRow(_logRow, kLogSpectrumColumns, _topPaneYMin, _topPaneYMax, timestampFromNanos(f.timestamp), colormap.value);
                 _lastRenderInfo = RenderInfo{.freqMin = logRange->min, .freqMax = logRange->max};
+            } else if (f.nBins > width) {
+                _logRow.resize(width);
+                decimateRow(f.yValues.first(f.nBins), _logRow);
+                _waterfall.pushRow(_logRow, width, _topPaneYMin, _topPaneYMax, timestampFromNanos(f.timestamp), colormap.value);
+                _lastRenderInfo = RenderInfo{.freqMin = static_cast<double>(f.xValues.front()), .freqMax = static_cast<double>(f.xValues.back())};
             } else {
                 _waterfall.pushRow(f.yValues, f.nBins, _topPaneYMin, _topPaneYMax, timestampFromNanos(f.timestamp), colormap.value);
                 _lastRenderInfo = RenderInfo{.freqMin = static_cast<double>(f.xValues.front()), .freqMax = static_cast<double>(f.xValues.back())};
@@ -6,9 +6,11 @@
 #include "SpectrumHelper.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <limits>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <gnuradio-4.0/Block.hpp>
@@ -26,6 +28,8 @@ struct SurfaceBuffer {
     std::size_t _historyDepth  = 0;
     std::size_t _writeRow      = 0;
     std::size_t _filledRows    = 0;
+    std::size_t _rowsPushed    = 0; // rows pushed since the last init()/clear(), i.e. absolute index of the next row
+    std::size_t _layoutVersion = 0; // bumped whenever rows are re-arranged or the frequency axis changes (meshes must be rebuilt)
     bool        _dirty         = false;
 
     std::vector<float>  _magnitudes; // ring buffer: _historyDepth rows of _spectrumWidth values
@@ -35,10 +39,12 @@ struct SurfaceBuffer {
     double _scaleMin = 0.0;
     double _scaleMax = 0.0;
 
-    // linearised arrays for PlotSurface CPU fallback (rebuilt each frame from ring buffer)
+    // linearised arrays for PlotSurface CPU fallback (rebuilt from the ring buffer when rows were pushed)
     mutable std::vector<double> _xCoords;
     mutable std::vector<double> _yCoords;
     mutable std::vector<double> _zCoords;
+    mutable std::size_t         _arraysRows    = std::numeric_limits<std::size_t>::max(); // _rowsPushed/_layoutVersion the arrays were built for
+    mutable std::size_t         _arraysVersion = std::numeric_limits<std::size_t>::max();
 
     void init(std::size_t width, std::size_t depth) {
         _spectrumWidth = width;
@@ -47,7 +53,9 @@ struct SurfaceBuffer {
         _filledRows    = 0;
         _scaleMin      = 0.0;
         _scaleMax      = 0.0;
+        _rowsPushed    = 0;
         _dirty         = true;
+        ++_layoutVersion;
         _magnitudes.assign(width * depth, 0.0f);
         _timestamps.assign(depth, 0.0);
         _freqAxis.clear();
@@ -66,12 +74,14 @@ struct SurfaceBuffer {
 
         _timestamps[_writeRow] = timestampSec;
         _writeRow              = (_writeRow + 1) % _historyDepth;
+        ++_rowsPushed;
         if (_filledRows < _historyDepth) {
             ++_filledRows;
         }
 
         if (_freqAxis.size() != n) {
             _freqAxis.assign(xValues.begin(), xValues.begin() + static_cast<std::ptrdiff_t>(n));
+            ++_layoutVersion;
         }
 
         _dirty = true;
@@ -92,9 +102,11 @@ struct SurfaceBuffer {
     }
 
     void buildSurfaceArrays() const {
-        if (_filledRows == 0 || _freqAxis.empty()) {
+        if (_filledRows == 0 || _freqAxis.empty() || (_arraysRows == _rowsPushed && _arraysVersion == _layoutVersion)) {
             return;
         }
+        _arraysRows    = _rowsPushed;
+        _arraysVersion = _layoutVersion;
 
         const auto nX     = _freqAxis.size();
         const auto nY     = _filledRows;
@@ -140,6 +152,7 @@ struct SurfaceBuffer {
         _filledRows   = rowsToCopy;
         _writeRow     = 0;
         _dirty        = true;
+        ++_layoutVersion;
     }
 
     void clear() {
@@ -147,9 +160,11 @@ struct SurfaceBuffer {
         std::ranges::fill(_timestamps, 0.0);
         _writeRow   = 0;
         _filledRows = 0;
+        _rowsPushed = 0;
         _scaleMin   = 0.0;
         _scaleMax   = 0.0;
         _dirty      = true;
+        ++_layoutVersion;
     }
 
     [[nodiscard]] std::size_t width() const noexcept { return _spectrumWidth; }
@@ -168,6 +183,11 @@ struct SurfaceBuffer {
         return {tOldest - tNewest, 0.0}; // relative: negative offset for oldest, 0 for newest
     }
 
+    /// ring row holding the row with absolute index `rowIndex` (must be one of the last filledRows() pushed rows)
+    [[nodiscard]] std::size_t ringRowOf(std::size_t rowIndex) const noexcept { return (_writeRow + _historyDepth - (_rowsPushed - rowIndex)) % _historyDepth; }
+
+    [[nodiscard]] double newestTimestamp() const noexcept { return _filledRows == 0 ? 0.0 : _timestamps[(_writeRow + _historyDepth - 1) % _historyDepth]; }
+
     [[nodiscard]] float relativeTime(std::size_t ringRow) const {
         if (_filledRows < 2) {
             return 0.0f;
@@ -180,8 +200,18 @@ struct SurfaceBuffer {
 
 namespace gl = opendigitizer::shader;
 
+/**
+ * @brief GPU mesh of a SurfaceBuffer, kept as a ring of vertex rows so that a new spectrum only rewrites one row.
+ *
+ * Rows are grouped by their absolute index (strideY rows per mesh row, max-held with the newest row's time), mesh row slots are
+ * reused ring-wise and the index buffer, which connects every slot with the next one, only depends on the mesh size. Vertex Y
+ * holds the row time relative to a fixed epoch; the shift to "newest row = 0" is a uniform, hence older rows stay untouched
+ * when the newest time advances. Each frame draws the strips between the valid slots in at most two ranges, skipping the
+ * seam between the newest and the oldest slot.
+ */
 struct SurfaceGpuRenderer {
     static constexpr std::size_t kMaxDisplayDim = 512UZ;
+    static constexpr double      kMaxEpochAge   = 1e4; // [s] re-base vertex times before float precision degrades
 
     GLuint         _program            = 0;
     GLuint         _vao                = 0;
@@ -205,8 +235,25 @@ struct SurfaceGpuRenderer {
     GLint _locGridMinorSpacing = -1;
     GLint _locGridEnabled      = -1;
     GLint _locGridColor        = -1;
-
-    std::size_t _indexCount = 0;
+    GLint _locTimeShift        = -1;
+
+    std::size_t _indexCount = 0; // indices of the drawn ranges
+
+    // ring mesh layout, rebuilt when the buffer's layout version changes
+    std::size_t                                          _meshVersion = std::numeric_limits<std::size_t>::max();
+    std::size_t                                          _meshRows    = 0UZ; // SurfaceBuffer::_rowsPushed at the last upload
+    std::size_t                                          _meshFirst   = 0UZ; // oldest retained row at the last upload
+    std::size_t                                          _meshNX      = 0UZ;
+    std::size_t                                          _meshSlots   = 0UZ;
+    std::size_t                                          _strideY     = 1UZ;
+    double                                               _meshEpoch   = 0.0; // vertex Y = row time - _meshEpoch
+    std::array<std::pair<std::size_t, std::size_t>, 2UZ> _drawRanges{};      // (first index, index count)
+
+    // row scratch of fillRowVertices()
+    std::vector<float> _rowVertices;
+    std::vector<float> _rowPeaks;
+    std::vector<float> _heldVertices;                                             // _rowVertices of the newest group while refillGroup() runs
+    std::size_t        _rowVerticesRow = std::numeric_limits<std::size_t>::max(); // absolute row held in _rowVertices
 
     bool _initAttempted = false;
     bool _gpuAvailable  = false;
@@ -229,6 +276,7 @@ struct SurfaceGpuRenderer {
         float gridMinorSpacing[2]{}; // X,Y minor tick interval
         int   gridEnabled = 0;       // 0=off, 1=major only, 2=major+minor
         float gridColor[4]{1.f, 1.f, 1.f, 0.3f};
+        float timeShift = 0.f; // mesh epoch - newest row time
     };
     FrameState _frame{};
 
@@ -269,8 +317,23 @@ struct SurfaceGpuRenderer {
         swap(_locColormapLut, o._locColormapLut);
         swap(_locGridOrigin, o._locGridOrigin);
         swap(_locGridSpacing, o._locGridSpacing);
+        swap(_locGridMinorSpacing, o._locGridMinorSpacing);
         swap(_locGridEnabled, o._locGridEnabled);
+        swap(_locGridColor, o._locGridColor);
+        swap(_locTimeShift, o._locTimeShift);
         swap(_indexCount, o._indexCount);
+        swap(_meshVersion, o._meshVersion);
+        swap(_meshRows, o._meshRows);
+        swap(_meshFirst, o._meshFirst);
+        swap(_meshNX, o._meshNX);
+        swap(_meshSlots, o._meshSlots);
+        swap(_strideY, o._strideY);
+        swap(_meshEpoch, o._meshEpoch);
+        swap(_drawRanges, o._drawRanges);
+        swap(_rowVertices, o._rowVertices);
+        swap(_rowPeaks, o._rowPeaks);
+        swap(_heldVertices, o._heldVertices);
+        swap(_rowVerticesRow, o._rowVerticesRow);
         swap(_initAttempted, o._initAttempted);
         swap(_gpuAvailable, o._gpuAvailable);
         swap(_frame, o._frame);
@@ -303,6 +366,7 @@ uniform float u_viewScale;
 uniform vec2  u_screenCenter;
 uniform vec2  u_invScreenSize;
 uniform vec2  u_colormapRange;
+uniform float u_timeShift;
 
 vec3 quatRotate(vec4 q, vec3 v) {
     vec3 t = 2.0 * cross(q.xyz, v);
@@ -310,7 +374,8 @@ vec3 quatRotate(vec4 q, vec3 v) {
 }
 
 void main() {
-    vec3 t   = (a_position - u_axisMin) * u_axisInvRange;
+    vec3 position = a_position + vec3(0.0, u_timeShift, 0.0); // epoch-relative -> newest-relative row time
+    vec3 t        = (position - u_axisMin) * u_axisInvRange;
     vec3 ndc = (t - 0.5) * u_ndcScale;
 
     vec3 rotated = quatRotate(u_rotation, ndc);
@@ -325,8 +390,8 @@ void main() {
                        depth, 1.0);
 
     float r = u_colormapRange.y - u_colormapRange.x;
-    v_zNorm    = r > 0.0 ? clamp((a_position.z - u_colormapRange.x) / r, 0.0, 1.0) : 0.5;
-    v_worldPos = a_position;
+    v_zNorm    = r > 0.0 ? clamp((position.z - u_colormapRange.x) / r, 0.0, 1.0) : 0.5;
+    v_worldPos = position;
 }
 )glsl";
 
@@ -404,6 +469,7 @@ void main() {
         _locGridMinorSpacing = glGetUniformLocation(_program, "u_gridMinorSpacing");
         _locGridEnabled      = glGetUniformLocation(_program, "u_gridEnabled");
         _locGridColor        = glGetUniformLocation(_program, "u_gridColor");
+        _locTimeShift        = glGetUniformLocation(_program, "u_timeShift");
 
         glGenVertexArrays(1, &_vao);
         glGenBuffers(1, &_vbo);
@@ -419,47 +485,97 @@ void main() {
         return true;
     }
 
+    /// brings the mesh up to date with `buf`: O(width) per row pushed since the last call, full rebuild only on layout changes
     void uploadMesh(const SurfaceBuffer& buf) {
-        if (!_gpuAvailable || buf._filledRows < 2 || buf._freqAxis.empty()) {
+        if (!_gpuAvailable) {
+            return;
+        }
+        if (buf._filledRows < 2 || buf._freqAxis.empty()) {
+            _drawRanges = {};
+            _indexCount = 0;
             return;
         }
 
-        const auto srcNX = buf._freqAxis.size();
-        const auto srcNY = buf._filledRows;
+        const double tNewest = buf.newestTimestamp();
+        if (_meshVersion != buf._layoutVersion || _meshRows > buf._rowsPushed || !(std::abs(tNewest - _meshEpoch) < kMaxEpochAge)) {
+            rebuildMesh(buf, tNewest);
+        } else {
+            glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+            for (std::size_t row = std::max(_meshRows, buf._rowsPushed - buf._filledRows); row < buf._rowsPushed; ++row) {
+                const std::size_t slot = (row / _strideY) % _meshSlots;
+                fillRowVertices(buf, row);
+                glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(slot * _meshNX * 3UZ * sizeof(float)), static_cast<GLsizeiptr>(_rowVertices.size() * sizeof(float)), _rowVertices.data());
+            }
+            // the older rows of the oldest group left the ring: drop them from its max-hold, unless its slot is already reused by the newest group
+            const std::size_t firstRow = buf._rowsPushed - buf._filledRows;
+            if (firstRow != _meshFirst && firstRow % _strideY != 0UZ && firstRow / _strideY + _meshSlots > (buf._rowsPushed - 1UZ) / _strideY) {
+                refillGroup(buf, firstRow / _strideY);
+            }
+        }
+        _meshRows        = buf._rowsPushed;
+        _meshFirst       = buf._rowsPushed - buf._filledRows;
+        _frame.timeShift = static_cast<float>(_meshEpoch - tNewest);
+        updateDrawRanges(buf);
+    }
 
-        const auto strideX   = std::max(std::size_t{1}, srcNX / kMaxDisplayDim);
-        const auto strideY   = std::max(std::size_t{1}, srcNY / kMaxDisplayDim);
-        const auto displayNX = (srcNX + strideX - 1) / strideX;
-        const auto displayNY = (srcNY + strideY - 1) / strideY;
+    /// mesh row of absolute `row`: columns are max-hold decimated over frequency and, when strideY > 1, max-held over the rows
+    /// of the group pushed so far, so narrow lines and short bursts survive decimation; vertex X is the centre frequency of the
+    /// column's bins, vertex Y is the group's newest row time
+    void fillRowVertices(const SurfaceBuffer& buf, std::size_t row) {
+        const std::size_t ringRow = buf.ringRowOf(row);
+        const float       rowTime = static_cast<float>(buf._timestamps[ringRow] - _meshEpoch);
+        const std::size_t srcNX   = buf._freqAxis.size();
+        const bool        holdRow = _rowVerticesRow + 1UZ == row && row / _strideY == _rowVerticesRow / _strideY;
+        _rowPeaks.resize(_meshNX);
+        decimateRow(std::span(buf._magnitudes).subspan(ringRow * buf._spectrumWidth, srcNX), _rowPeaks);
+        _rowVertices.resize(_meshNX * 3UZ);
+        for (std::size_t dx = 0; dx < _meshNX; ++dx) {
+            const std::size_t first  = decimatedColumnBegin(dx, srcNX, _meshNX); // same bins decimateRow() took Z from
+            const std::size_t last   = std::max(decimatedColumnBegin(dx + 1UZ, srcNX, _meshNX), first + 1UZ);
+            _rowVertices[dx * 3 + 0] = buf._freqAxis[(first + last - 1UZ) / 2UZ]; // centre bin of the column
+            _rowVertices[dx * 3 + 1] = rowTime;
+            _rowVertices[dx * 3 + 2] = holdRow ? std::max(_rowVertices[dx * 3 + 2], _rowPeaks[dx]) : _rowPeaks[dx];
+        }
+        _rowVerticesRow = row;
+    }
 
-        std::vector<float> vertices(displayNX * displayNY * 3);
+    /// rewrites the mesh row of `group` from its retained rows only, keeps the running max-hold of the newest group
+    void refillGroup(const SurfaceBuffer& buf, std::size_t group) {
+        std::swap(_rowVertices, _heldVertices);
+        const std::size_t heldRow = std::exchange(_rowVerticesRow, std::numeric_limits<std::size_t>::max());
+        for (std::size_t row = std::max(group * _strideY, buf._rowsPushed - buf._filledRows); row < std::min((group + 1UZ) * _strideY, buf._rowsPushed); ++row) {
+            fillRowVertices(buf, row);
+        }
+        glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>((group % _meshSlots) * _meshNX * 3UZ * sizeof(float)), static_cast<GLsizeiptr>(_rowVertices.size() * sizeof(float)), _rowVertices.data());
+        std::swap(_rowVertices, _heldVertices);
+        _rowVerticesRow = heldRow;
+    }
 
-        for (std::size_t dy = 0; dy < displayNY; ++dy) {
-            const auto   srcY    = std::min(dy * strideY, srcNY - 1);
-            const auto   ringRow = (buf._writeRow + buf._historyDepth - srcNY + srcY) % buf._historyDepth;
-            const float  rowTime = buf.relativeTime(ringRow);
-            const float* mag     = buf._magnitudes.data() + ringRow * buf._spectrumWidth;
+    void rebuildMesh(const SurfaceBuffer& buf, double tNewest) {
+        _strideY        = std::max(std::size_t{1}, buf._historyDepth / kMaxDisplayDim);
+        _meshNX         = std::min(buf._freqAxis.size(), kMaxDisplayDim);
+        _meshSlots      = std::max((buf._historyDepth + _strideY - 1) / _strideY, std::size_t{2});
+        _meshEpoch      = tNewest;
+        _meshVersion    = buf._layoutVersion;
+        _rowVerticesRow = std::numeric_limits<std::size_t>::max();
 
-            for (std::size_t dx = 0; dx < displayNX; ++dx) {
-                const auto srcX  = std::min(dx * strideX, srcNX - 1);
-                const auto vi    = (dy * displayNX + dx) * 3;
-                vertices[vi + 0] = buf._freqAxis[srcX];
-                vertices[vi + 1] = rowTime;
-                vertices[vi + 2] = mag[srcX];
-            }
+        std::vector<float> vertices(_meshSlots * _meshNX * 3UZ, 0.f);
+        for (std::size_t row = buf._rowsPushed - buf._filledRows; row < buf._rowsPushed; ++row) { // oldest first: each group accumulates its rows
+            fillRowVertices(buf, row);
+            std::ranges::copy(_rowVertices, vertices.begin() + static_cast<std::ptrdiff_t>(((row / _strideY) % _meshSlots) * _meshNX * 3UZ));
         }
-
         glBindBuffer(GL_ARRAY_BUFFER, _vbo);
         glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertices.size() * sizeof(float)), vertices.data(), GL_DYNAMIC_DRAW);
 
-        _indexCount = (displayNX - 1) * (displayNY - 1) * 6;
-        std::vector<uint32_t> indices(_indexCount);
+        // strip k connects slot k with slot (k + 1) % slots, independent of which slots are currently valid
+        std::vector<uint32_t> indices(_meshSlots * (_meshNX - 1) * 6);
         std::size_t           ii = 0;
-        for (std::size_t row = 0; row < displayNY - 1; ++row) {
-            for (std::size_t col = 0; col < displayNX - 1; ++col) {
-                auto v00      = static_cast<uint32_t>(row * displayNX + col);
+        for (std::size_t slot = 0; slot < _meshSlots; ++slot) {
+            const std::size_t nextSlot = (slot + 1) % _meshSlots;
+            for (std::size_t col = 0; col + 1 < _meshNX; ++col) {
+                auto v00      = static_cast<uint32_t>(slot * _meshNX + col);
                 auto v10      = v00 + 1;
-                auto v01      = static_cast<uint32_t>((row + 1) * displayNX + col);
+                auto v01      = static_cast<uint32_t>(nextSlot * _meshNX + col);
                 auto v11      = v01 + 1;
                 indices[ii++] = v00;
                 indices[ii++] = v10;
@@ -474,6 +590,19 @@ void main() {
         glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indices.size() * sizeof(uint32_t)), indices.data(), GL_STATIC_DRAW);
     }
 
+    /// strips between consecutive valid groups, from the oldest retained one to the newest, split where they wrap around the ring
+    void updateDrawRanges(const SurfaceBuffer& buf) {
+        const std::size_t newestGroup      = (buf._rowsPushed - 1UZ) / _strideY;
+        const std::size_t oldestGroup      = std::max((buf._rowsPushed - buf._filledRows) / _strideY, newestGroup + 1UZ - std::min(newestGroup + 1UZ, _meshSlots));
+        const std::size_t strips           = newestGroup - oldestGroup;
+        const std::size_t firstStrip       = oldestGroup % _meshSlots;
+        const std::size_t stripIndices     = (_meshNX - 1) * 6;
+        const std::size_t stripsBeforeWrap = std::min(strips, _meshSlots - firstStrip);
+        _drawRanges[0]                     = {firstStrip * stripIndices, stripsBeforeWrap * stripIndices};
+        _drawRanges[1]                     = {0UZ, (strips - stripsBeforeWrap) * stripIndices};
+        _indexCount                        = strips * stripIndices;
+    }
+
     void updateColormapLut(ImPlotColormap colormap) {
         if (_activeColormap == colormap && _colormapLutTexture != 0) {
             return;
@@ -628,6 +757,7 @@ void main() {
         glUniform2fv(self->_locScreenCenter, 1, f.screenCenter);
         glUniform2fv(self->_locInvScreenSize, 1, f.invScreenSize);
         glUniform2fv(self->_locColormapRange, 1, f.colormapRange);
+        glUniform1f(self->_locTimeShift, f.timeShift);
 
         glActiveTexture(GL_TEXTURE0);
         glBindTexture(GL_TEXTURE_2D, self->_colormapLutTexture);
@@ -639,7 +769,11 @@ void main() {
         glUniform1i(self->_locGridEnabled, f.gridEnabled);
         glUniform4fv(self->_locGridColor, 1, f.gridColor);
 
-        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(self->_indexCount), GL_UNSIGNED_INT, nullptr);
+        for (const auto& [first, count] : self->_drawRanges) {
+            if (count > 0UZ) {
+                glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(count), GL_UNSIGNED_INT, reinterpret_cast<const void*>(first * sizeof(uint32_t)));
+            }
+        }
 
         // restore GL state
         if (!prevDepthTest) {
@@ -676,6 +810,9 @@ void main() {
             _colormapLutTexture = 0;
         }
         _indexCount     = 0;
+        _drawRanges     = {};
+        _meshVersion    = std::numeric_limits<std::size_t>::max();
+        _meshRows       = 0UZ;
         _initAttempted  = false;
         _gpuAvailable   = false;
         _activeColormap = -1;
@@ -705,6 +842,9 @@ struct SurfacePlot : gr::Block<SurfacePlot, gr::Drawable<gr::UICategory::Content
     A<ImPlotColormap_, "colormap", gr::Visible>                                                       colormap         = ImPlotColormap_Viridis;
     A<bool, "GPU acceleration", gr::Doc<"use GPU mesh rendering (falls back to CPU if unavailable)">> gpu_acceleration = true;
 
+    // log-frequency mode
+    LogBinningSetting log_binning = LogBinning::Max;
+
     // axis limits
     A<bool, "X auto-scale"> x_auto_scale = true;
     A<bool, "Y auto-scale"> y_auto_scale = true;
@@ -718,11 +858,12 @@ struct SurfacePlot : gr::Block<SurfacePlot, gr::Drawable<gr::UICategory::Content
 
     static constexpr SignalKind supportedSignals = SignalKind::Dataset1D;
 
-    GR_MAKE_REFLECTABLE(SurfacePlot, chart_name, chart_title, data_sinks, show_legend, show_grid, show_minor_grid, grid_color, grid_opacity, n_history, colormap, gpu_acceleration, x_auto_scale, y_auto_scale, z_auto_scale, x_min, x_max, y_min, y_max, z_min, z_max);
+    GR_MAKE_REFLECTABLE(SurfacePlot, chart_name, chart_title, data_sinks, show_legend, show_grid, show_minor_grid, grid_color, grid_opacity, n_history, colormap, gpu_acceleration, log_binning, x_auto_scale, y_auto_scale, z_auto_scale, x_min, x_max, y_min, y_max, z_min, z_max);
 
     SurfaceBuffer              _surface;
     SurfaceGpuRenderer         _gpuRenderer;
     std::vector<float>         _logRow;      // scratch: linear spectrum re-binned onto log-spaced columns
+    LogBinningPlan             _logPlan;
     std::vector<float>         _logFreqAxis; // log10(centre frequency) per log column — the X coordinate in log mode
     bool                       _logModeActive         = false;
     std::size_t                _lastSpectrumSize      = 0;
@@ -1199,7 +1340,7 @@ struct SurfacePlot : gr::Block<SurfacePlot, gr::Drawable<gr::UICategory::Content
     }
 
     // log10(centre frequency) of each log-spaced column — the linear X coordinate used in log mode (matches the
-    // column mapping of buildLogBinnedRow). A linear axis over [log10(fMin), log10(fMax)] then renders correctly on
+    // column mapping of LogBinningPlan). A linear axis over [log10(fMin), log10(fMax)] then renders correctly on
     // both the CPU and the GPU mesh path (which projects vertices linearly), with decade-uniform grid spacing.
     void buildLog10FreqAxis(double fMin, double fMax) {
         _logFreqAxis.resize(kLogSpectrumColumns);
@@ -1232,8 +1373,9 @@ struct SurfacePlot : gr::Block<SurfacePlot, gr::Drawable<gr::UICategory::Content
             _surface.updateAutoScale(f.yValues, f.nBins);
             if (logRange) {
                 _logRow.resize(kLogSpectrumColumns);
-                buildLogBinnedRow(f.xValues, f.yValues, f.nBins, logRange->min, logRange->max, _logRow);
-                buildLog10FreqAxis(logRange->min, logRange->max);
+                if (_logPlan.apply(f.xValues, f.yValues, f.nBins, logRange->min, logRange->max, _logRow, log_binning.value) || _logFreqAxis.empty()) {
+                    buildLog10FreqAxis(logRange->min, logRange->max); // the column layout changed with the plan
+                }
                 _surface.pushRow(_logFreqAxis, _logRow, kLogSpectrumColumns, timestampFromNanos(f.timestamp));
             } else {
                 _surface.pushRow(f.xValues, f.yValues, f.nBins, timestampFromNanos(f.timestamp));
@@ -0,0 +1,69 @@
+#ifndef OPENDIGITIZER_CHARTS_TAGINDEX_HPP
+#define OPENDIGITIZER_CHARTS_TAGINDEX_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <deque>
+#include <ranges>
+
+namespace opendigitizer::charts {
+
+template<typename TTag>
+concept TimestampedTag = requires(const TTag& tag) {
+    { tag.timestamp } -> std::convertible_to<double>;
+};
+
+/**
+ * @brief Tags of a stream kept sorted by timestamp, so that range queries and per-sample lookups are binary searches
+ * (O(log T + k)) instead of scans over all T stored tags.
+ *
+ * Tags practically always arrive in time order and are appended at the back in O(1); late (out-of-order, e.g. fishy) tags are
+ * inserted at their sorted position. Old tags are dropped from the front via eraseBefore().
+ */
+template<TimestampedTag TTag>
+class TagIndex {
+    std::deque<TTag> _tags;
+
+    static constexpr auto kTimestamp = [](const TTag& tag) { return static_cast<double>(tag.timestamp); };
+
+public:
+    using const_iterator = typename std::deque<TTag>::const_iterator;
+
+    [[nodiscard]] std::size_t    size() const noexcept { return _tags.size(); }
+    [[nodiscard]] bool           empty() const noexcept { return _tags.empty(); }
+    [[nodiscard]] const TTag&    front() const { return _tags.front(); }
+    [[nodiscard]] const TTag&    back() const { return _tags.back(); }
+    [[nodiscard]] const TTag&    operator[](std::size_t index) const { return _tags[index]; }
+    [[nodiscard]] const_iterator begin() const noexcept { return _tags.cbegin(); }
+    [[nodiscard]] const_iterator end() const noexcept { return _tags.cend(); }
+
+    void clear() noexcept { _tags.clear(); }
+
+    TTag& insert(TTag tag) {
+        if (_tags.empty() || !(static_cast<double>(tag.timestamp) < kTimestamp(_tags.back()))) {
+            return _tags.emplace_back(std::move(tag));
+        }
+        return *_tags.insert(std::ranges::upper_bound(_tags, static_cast<double>(tag.timestamp), {}, kTimestamp), std::move(tag));
+    }
+
+    /// index of the first tag with timestamp >= t (size() if none)
+    [[nodiscard]] std::size_t lowerIndex(double t) const { return static_cast<std::size_t>(std::ranges::lower_bound(_tags, t, {}, kTimestamp) - _tags.cbegin()); }
+
+    /// index of the first tag with timestamp > t (size() if none)
+    [[nodiscard]] std::size_t upperIndex(double t) const { return static_cast<std::size_t>(std::ranges::upper_bound(_tags, t, {}, kTimestamp) - _tags.cbegin()); }
+
+    /// tags with tMin <= timestamp <= tMax
+    [[nodiscard]] std::ranges::subrange<const_iterator> range(double tMin, double tMax) const {
+        const auto first = std::ranges::lower_bound(_tags, tMin, {}, kTimestamp);
+        const auto last  = std::ranges::upper_bound(first, _tags.cend(), tMax, {}, kTimestamp);
+        return {first, std::max(first, last)};
+    }
+
+    /// drops all tags with timestamp < tMin
+    void eraseBefore(double tMin) { _tags.erase(_tags.begin(), std::ranges::lower_bound(_tags, tMin, {}, kTimestamp)); }
+};
+
+} // namespace opendigitizer::charts
+
+#endif // OPENDIGITIZER_CHARTS_TAGINDEX_HPP
@@ -49,9 +49,12 @@ struct WaterfallPlot : gr::Block<WaterfallPlot, gr::Drawable<gr::UICategory::Con
     A<double, "Y-axis min"> y_min        = std::numeric_limits<double>::lowest();
     A<double, "Y-axis max"> y_max        = std::numeric_limits<double>::max();
 
+    // log-frequency mode
+    LogBinningSetting log_binning = LogBinning::Max;
+
     static constexpr SignalKind supportedSignals = SignalKind::Dataset1D;
 
-    GR_MAKE_REFLECTABLE(WaterfallPlot, chart_name, chart_title, data_sinks, show_legend, show_grid, n_history, colormap, gpu_acceleration, orientation, x_auto_scale, y_auto_scale, x_min, x_max, y_min, y_max);
+    GR_MAKE_REFLECTABLE(WaterfallPlot, chart_name, chart_title, data_sinks, show_legend, show_grid, n_history, colormap, gpu_acceleration, orientation, log_binning, x_auto_scale, y_auto_scale, x_min, x_max, y_min, y_max);
 
     struct RenderInfo {
         double freqMin;
@@ -59,11 +62,12 @@ struct WaterfallPlot : gr::Block<WaterfallPlot, gr::Drawable<gr::UICategory::Con
     };
 
     WaterfallBuffer            _waterfall;
-    std::size_t                _lastInitWidth = 0; // allocated texture width (nBins, or kLogSpectrumColumns in log mode)
+    std::size_t                _lastInitWidth = 0; // allocated texture width (nBins capped at kMaxSpectrumColumns, or kLogSpectrumColumns in log mode)
     std::array<std::string, 6> _unitStore{};
     std::size_t                _lastPushedSampleCount = std::numeric_limits<std::size_t>::max();
     std::optional<RenderInfo>  _lastRenderInfo;
-    std::vector<float>         _logRow; // scratch: linear spectrum re-binned onto log-spaced columns
+    std::vector<float>         _logRow; // scratch: linear spectrum re-binned onto log-spaced or decimated columns
+    LogBinningPlan             _logPlan;
 
     static constexpr std::string_view kChartTypeName = "WaterfallPlot";
 
@@ -227,7 +231,7 @@ struct WaterfallPlot : gr::Block<WaterfallPlot, gr::Drawable<gr::UICategory::Con
                 return false;
             }
 
-            const std::size_t width = logRange ? kLogSpectrumColumns : f.nBins;
+            const std::size_t width = logRange ? kLogSpectrumColumns : std::min(f.nBins, kMaxSpectrumColumns);
             if (_lastInitWidth != width) {
                 _waterfall.init(width, static_cast<std::size_t>(n_history), gpu_acceleration);
                 _lastInitWidth = width;
@@ -238,9 +242,14 @@ struct WaterfallPlot : gr::Block<WaterfallPlot, gr::Drawable<gr::UICategory::Con
 
             if (logRange) {
                 _logRow.resize(kLogSpectrumColumns);
-                buildLogBinnedRow(f.xValues, f.yValues, f.nBins, logRange->min, logRange->max, _logRow);
+                _logPlan.apply(f.xValues, f.yValues, f.nBins, logRange->min, logRange->max, _logRow, log_binning.value);
                 _waterfall.pushRow(_logRow, kLogSpectrumColumns, cMin, cMax, timestampFromNanos(f.timestamp), colormap.value);
                 _lastRenderInfo = RenderInfo{.freqMin = logRange->min, .freqMax = logRange->max};
+            } else if (f.nBins > width) {
+                _logRow.resize(width);
+                decimateRow(f.yValues.first(f.nBins), _logRow);
+                _waterfall.pushRow(_logRow, width, cMin, cMax, timestampFromNanos(f.timestamp), colormap.value);
+                _lastRenderInfo = RenderInfo{.freqMin = static_cast<double>(f.xValues.front()), .freqMax = static_cast<double>(f.xValues.back())};
             } else {
                 _waterfall.pushRow(f.yValues, f.nBins, cMin, cMax, timestampFromNanos(f.timestamp), colormap.value);
                 _lastRenderInfo = RenderInfo{.freqMin = static_cast<double>(f.xValues.front()), .freqMax = static_cast<double>(f.xValues.back())};
@@ -2,13 +2,16 @@
 #define OPENDIGITIZER_CHARTS_XYCHART_HPP
 
 #include "Chart.hpp"
+#include "RenderPrep.hpp"
 #include "SignalSink.hpp"
 
 #include <algorithm>
 #include <array>
 #include <atomic>
 #include <cmath>
+#include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -69,9 +72,43 @@ struct XYChart : gr::Block<XYChart, gr::Drawable<gr::UICategory::Content, "ImGui
     struct StreamSnapshot {
         std::vector<double> x; // window X, pre-transformed for the active axis scale (double: absolute timestamps lose precision as float)
         std::vector<double> y;
-        double              lastRefresh = 0.0;
+        std::size_t         sourceCount = 0UZ; // number of sink samples the snapshot was built from
+        double              columnWidth = 0.0; // X extent of one pixel column used for the M4 decimation, 0: not decimated
     };
-    std::unordered_map<std::string, StreamSnapshot> _streamSnapshots;
+
+    /// view of the plot a snapshot is prepared for, captured on the UI thread
+    struct StreamView {
+        std::size_t historyLimit = 0UZ; // n_history
+        AxisScale   xAxisScale   = AxisScale::Linear;
+        double      plotXMin     = 0.0;
+        double      plotXMax     = 0.0;
+        double      plotWidth    = 0.0; // [px]
+
+        [[nodiscard]] double columnWidth() const noexcept { return std::abs(plotXMax - plotXMin) / std::max(plotWidth, 1.0); }
+
+        /// whether a snapshot prepared for `other` no longer matches this view (zoom, size, axis scale or history changed),
+        /// panning alone is caught up with at the update_rate cadence
+        [[nodiscard]] bool differsFrom(const StreamView& other) const noexcept {
+            const double width      = columnWidth();
+            const double otherWidth = other.columnWidth();
+            return historyLimit != other.historyLimit || xAxisScale != other.xAxisScale || plotWidth != other.plotWidth || std::abs(width - otherWidth) > 0.01 * std::max(width, otherWidth);
+        }
+    };
+
+    struct StreamTrace {
+        RenderPrepSlot<StreamSnapshot> prep;
+        StreamView                     requestedView;
+        double                         lastRequest = -1.0;
+    };
+    std::unordered_map<std::string, StreamTrace> _streamTraces;
+
+    /// copy of the newest max_history_count DataSets of a sink, drawn without its lock; only DataSets published since the last
+    /// update are copied, i.e. the per-frame cost does not grow with the history depth
+    struct DataSetHistory {
+        std::vector<gr::DataSet<float>> dataSets;          // oldest first
+        std::size_t                     sourceCount = 0UZ; // sink's totalSampleCount() the copy is up to date with
+    };
+    std::unordered_map<std::string, DataSetHistory> _dataSetHistories; // UI thread only
 
     static constexpr std::string_view kChartTypeName = "XYChart";
 
@@ -193,23 +230,22 @@ struct XYChart : gr::Block<XYChart, gr::Drawable<gr::UICategory::Content, "ImGui
             if (sink->size() > 0) {
                 ImVec4 baseColor = sinkColor(sink->color());
 
-                if (sink->hasDataSets()) {
-                    drawDataSetSignal(*sink);
-
-                    // Draw timing events for DataSets (only for first sink to avoid clutter)
-                    if (show_tags.value && !tagsDrawnForFirstSink) {
-                        auto allDataSets = sink->dataSets();
-                        if (!allDataSets.empty()) {
-                            tags::drawDataSetTimingEvents(allDataSets.back(), _xCategories[xAxisIdx].has_value() ? _xCategories[xAxisIdx]->scale : AxisScale::Linear, baseColor);
-                        }
-                        tagsDrawnForFirstSink = true;
+                if (!sink->hasDataSets()) {
+                    // streaming traces are prepared on renderPrepPool(), the UI thread only submits the latest finished snapshot
+                    const std::size_t sinkSize = sink->size();
+                    dataLock                   = DataGuard{};
+                    if (const auto snap = requestStreamSnapshot(sink, sinkSize)) {
+                        ImPlot::SetNextLineStyle(baseColor);
+                        ImPlot::PlotLine(sink->signalName().data(), snap->x.data(), snap->y.data(), static_cast<int>(snap->x.size()));
                     }
-                } else {
-                    drawStreamingSignal(*sink);
 
                     // Draw streaming tags (only for first sink to avoid clutter)
                     if (show_tags.value && !tagsDrawnForFirstSink) {
+                        dataLock               = sink->dataGuard();
                         std::size_t totalCount = sink->size();
+                        if (totalCount == 0) {
+                            continue; // buffer was resized meanwhile
+                        }
                         std::size_t dataCount  = std::min(totalCount, static_cast<std::size_t>(n_history.value));
                         std::size_t offset     = totalCount - dataCount;
                         double      xMin       = sink->xAt(offset);
@@ -217,73 +253,150 @@ struct XYChart : gr::Block<XYChart, gr::Drawable<gr::UICategory::Content, "ImGui
                         AxisScale   xAxisScale = _xCategories[xAxisIdx].has_value() ? _xCategories[xAxisIdx]->scale : AxisScale::Linear;
                         ImVec4      tagColor   = baseColor;
                         tagColor.w *= 0.35f;
-                        tags::drawTags([&](auto&& fn) { sink->forEachTag(fn); }, xAxisScale, xMin, xMax, tagColor);
+                        tags::drawTags([&](auto&& fn) { sink->forEachTagInRange(std::min(xMin, xMax), std::max(xMin, xMax), fn); }, xAxisScale, xMin, xMax, tagColor);
                         sink->pruneTags(std::min(xMin, xMax));
                         tagsDrawnForFirstSink = true;
                     }
+                } else {
+                    // bring the copy of the displayed history up to date under the lock and render from it, the producer must not wait for ImPlot
+                    DataSetHistory& history = _dataSetHistories[std::string(sinkUniqueName)];
+                    updateDataSetHistory(*sink, history);
+                    dataLock = DataGuard{};
+                    drawDataSetSignal(*sink, history.dataSets);
+
+                    // Draw timing events for DataSets (only for first sink to avoid clutter)
+                    if (show_tags.value && !tagsDrawnForFirstSink) {
+                        if (!history.dataSets.empty()) {
+                            tags::drawDataSetTimingEvents(history.dataSets.back(), _xCategories[xAxisIdx].has_value() ? _xCategories[xAxisIdx]->scale : AxisScale::Linear, baseColor);
+                        }
+                        tagsDrawnForFirstSink = true;
+                    }
                 }
             }
         }
     }
 
-    void drawStreamingSignal(const SignalSink& sink) {
-        // Note: Caller must hold data lock via sink.dataGuard()
-        std::size_t totalCount = sink.size();
-        if (totalCount == 0) {
-            return;
+    /// returns the newest prepared snapshot of the sink's trace (nullptr until the first one is ready) and schedules a rebuild on
+    /// renderPrepPool() at most update_rate times/s, or right away when the view or the number of displayed samples changed
+    std::shared_ptr<const StreamSnapshot> requestStreamSnapshot(const std::shared_ptr<SignalSink>& sink, std::size_t sinkSize) {
+        StreamTrace&     trace  = _streamTraces[std::string(sink->uniqueName())];
+        auto             latest = trace.prep.latest();
+        const ImPlotRect limits = ImPlot::GetPlotLimits(IMPLOT_AUTO, IMPLOT_AUTO);
+        const StreamView view{
+            .historyLimit = static_cast<std::size_t>(n_history.value),
+            .xAxisScale   = _xCategories[0].has_value() ? _xCategories[0]->scale : AxisScale::Linear,
+            .plotXMin     = limits.X.Min,
+            .plotXMax     = limits.X.Max,
+            .plotWidth    = static_cast<double>(ImPlot::GetPlotSize().x),
+        };
+
+        // snapshot-gate: rebuild the displayed window at most update_rate times/s instead of re-reading the live
+        // ring buffer each redraw, so the trace advances at a steady cadence rather than with the mouse/redraw rate.
+        const double now             = ImGui::GetTime();
+        const double refreshInterval = update_rate.value > 0.f ? 1.0 / static_cast<double>(update_rate.value) : 0.0;
+        const bool   viewChanged     = view.differsFrom(trace.requestedView);
+        const bool   countChanged    = latest == nullptr || latest->sourceCount != std::min(sinkSize, view.historyLimit);
+        if ((viewChanged || countChanged || (now - trace.lastRequest) >= refreshInterval) && trace.prep.submit([sink, view] { return prepareStreamSnapshot(*sink, view); })) {
+            trace.requestedView = view;
+            trace.lastRequest   = now;
+        }
+        return latest;
+    }
+
+    /// builds the plot-ready (axis-transformed, M4-decimated when dense) trace of the newest samples; runs on a worker thread
+    /// and therefore only uses the sink (under its own data lock) and the captured view, no ImGui/ImPlot state
+    [[nodiscard]] static std::optional<StreamSnapshot> prepareStreamSnapshot(const SignalSink& sink, const StreamView& view) {
+        auto              dataLock   = sink.dataGuard();
+        const std::size_t totalCount = sink.size();
+        if (totalCount == 0UZ) {
+            return std::nullopt;
         }
 
         // clamp to n_history: show only the most recent samples
-        std::size_t dataCount = std::min(totalCount, static_cast<std::size_t>(n_history.value));
-        std::size_t offset    = totalCount - dataCount;
-
-        const AxisScale xAxisScale = _xCategories[0].has_value() ? _xCategories[0]->scale : AxisScale::Linear;
+        const std::size_t dataCount = std::min(totalCount, view.historyLimit);
+        const std::size_t offset    = totalCount - dataCount;
+        const auto        window    = sink.samples(offset, dataCount); // one bulk fetch instead of per-sample virtual xAt()/yAt()
+        if (window.size() != dataCount) {
+            return std::nullopt; // sink went away
+        }
 
-        // snapshot-gate: rebuild the displayed window at most update_rate times/s instead of re-reading the live
-        // ring buffer each redraw, so the trace advances at a steady cadence rather than with the mouse/redraw rate.
-        StreamSnapshot& snap            = _streamSnapshots[std::string(sink.uniqueName())];
-        const double    now             = ImGui::GetTime();
-        const double    refreshInterval = update_rate.value > 0.f ? 1.0 / static_cast<double>(update_rate.value) : 0.0;
-        if (snap.x.size() != dataCount || (now - snap.lastRefresh) >= refreshInterval) {
-            const double xMin = sink.xAt(offset);
-            const double xMax = sink.xAt(offset + dataCount - 1);
+        // X is read through the window (e.g. generated from ImPlotSink's segment anchors), the decimated path only touches O(columns * log(count)) of it
+        const double   xFirst = window.xAt(0UZ);
+        const double   xLast  = window.xAt(dataCount - 1UZ);
+        StreamSnapshot snap{.sourceCount = dataCount, .columnWidth = streamingColumnWidth(xFirst, xLast, dataCount, view)};
+        const double   xShift = tags::transformX(0.0, view.xAxisScale, xFirst, xLast); // the axis transform is a pure offset
+        if (snap.columnWidth > 0.0) {
+            auto xAtFn     = [&window, xShift](std::size_t i) { return window.xAt(i) + xShift; };
+            auto yAtFn     = [&window](std::size_t i) { return static_cast<double>(window.y[i]); };
+            auto extremaFn = [&](std::size_t first, std::size_t n) {
+                const auto extrema = sink.yExtrema(offset + first, n);
+                return std::pair{extrema.min_index - offset, extrema.max_index - offset};
+            };
+            decimation::m4(dataCount, xAtFn, yAtFn, extremaFn, view.plotXMin, snap.columnWidth, snap.x, snap.y); // columns aligned with the pixel grid
+        } else {
             snap.x.resize(dataCount);
             snap.y.resize(dataCount);
-            for (std::size_t i = 0; i < dataCount; ++i) {
-                double xVal = sink.xAt(offset + i);
-                switch (xAxisScale) {
-                case AxisScale::Time: break;
-                case AxisScale::LinearReverse: xVal -= xMax; break;
-                default: xVal -= xMin; break;
-                }
-                snap.x[i] = xVal;
-                snap.y[i] = static_cast<double>(sink.yAt(offset + i));
-            }
-            snap.lastRefresh = now;
+            window.fillX(0UZ, snap.x);
+            std::ranges::for_each(snap.x, [xShift](double& x) { x += xShift; });
+            std::ranges::copy(window.y, snap.y.begin());
         }
+        return snap;
+    }
+
+    /// X extent of one pixel column of the plot `view` if the window of `dataCount` samples spanning [xFirst, xLast] holds more
+    /// than 4 samples per column (i.e. worth M4-decimating), 0 otherwise
+    [[nodiscard]] static double streamingColumnWidth(double xFirst, double xLast, std::size_t dataCount, const StreamView& view) {
+        const double dataSpan = std::abs(xLast - xFirst);
+        if (view.plotWidth < 1.0 || dataCount < 2UZ || !(dataSpan > 0.0)) {
+            return 0.0;
+        }
+        const double columnWidth = view.columnWidth();
+        if (!(columnWidth > 0.0) || !std::isfinite(columnWidth) || 4.0 * (dataSpan / columnWidth + 1.0) >= static_cast<double>(dataCount)) {
+            return 0.0;
+        }
+        return columnWidth;
+    }
 
-        ImPlot::SetNextLineStyle(sinkColor(sink.color()));
-        ImPlot::PlotLine(sink.signalName().data(), snap.x.data(), snap.y.data(), static_cast<int>(snap.x.size()));
+    /// appends the DataSets `sink` published since the last update to `history` and drops those beyond max_history_count (caller
+    /// must hold the sink's data lock); re-copies the whole history only if it cannot be continued, e.g. max_history_count was raised
+    void updateDataSetHistory(const SignalSink& sink, DataSetHistory& history) const {
+        const std::size_t totalCount  = sink.totalSampleCount();
+        const std::size_t historySize = std::min(sink.dataSetCount(), static_cast<std::size_t>(max_history_count.value));
+        if (totalCount == history.sourceCount && history.dataSets.size() == historySize) {
+            return;
+        }
+
+        std::size_t fresh = totalCount >= history.sourceCount ? std::min(totalCount - history.sourceCount, historySize) : historySize;
+        if (totalCount < history.sourceCount || history.dataSets.size() + fresh < historySize) {
+            history.dataSets.clear();
+            fresh = historySize;
+        }
+        if (fresh > 0UZ) {
+            // DataSets are ordered oldest-first in the span (push_back appends newest at the end)
+            const auto allDataSets = sink.dataSets();
+            fresh                  = std::min(fresh, allDataSets.size());
+            history.dataSets.insert(history.dataSets.end(), allDataSets.end() - static_cast<std::ptrdiff_t>(fresh), allDataSets.end());
+        }
+        if (history.dataSets.size() > historySize) {
+            history.dataSets.erase(history.dataSets.begin(), history.dataSets.end() - static_cast<std::ptrdiff_t>(historySize));
+        }
+        history.sourceCount = totalCount;
     }
 
-    void drawDataSetSignal(const SignalSink& sink) {
+    void drawDataSetSignal(const SignalSink& sink, std::span<const gr::DataSet<float>> dataSets) {
         // DataSet signals: x values are absolute (e.g., frequency), no transformation needed
         // Supports history rendering with fading opacity for older DataSets
-        auto allDataSets = sink.dataSets();
-        if (allDataSets.empty()) {
+        if (dataSets.empty()) {
             return;
         }
 
         ImVec4      baseColor   = sinkColor(sink.color());
-        std::size_t historySize = std::min(allDataSets.size(), static_cast<std::size_t>(max_history_count.value));
+        std::size_t historySize = dataSets.size();
         std::string baseName    = std::string(sink.signalName());
 
         // Draw from oldest to newest (so newest renders on top)
-        // DataSets are ordered oldest-first in the span (push_back appends newest at the end)
-        const std::size_t spanSize = allDataSets.size();
-        const std::size_t offset   = spanSize - historySize; // skip older entries
         for (std::size_t i = 0; i < historySize; ++i) {
-            const auto&        ds = allDataSets[offset + i]; // i=0 is oldest of selected, i=historySize-1 is newest
+            const auto&        ds = dataSets[i]; // i=0 is oldest of selected, i=historySize-1 is newest
             DataSetPlotContext ctx{&ds, 0};
 
             const bool isNewest = (i == historySize - 1);
@@ -150,23 +150,17 @@ struct YYChart : gr::Block<YYChart, gr::Drawable<gr::UICategory::Content, "ImGui
             offset    = totalCount - dataCount;
         }
 
-        struct XYContext {
-            const SignalSink* sink;
-            std::size_t       offset;
-        };
-        XYContext   ctx{sinkPtr.get(), offset};
-        std::string signalLabel{sinkPtr->signalName()};
+        // x (double) and y (float) differ in type, so ImPlot reads them through a getter, but from spans instead of virtual calls
+        SignalSink::SampleSpans window = sinkPtr->samples(offset, dataCount);
+        std::string             signalLabel{sinkPtr->signalName()};
 
         ImPlot::PlotLineG(
             signalLabel.c_str(),
             [](int idx, void* user_data) -> ImPlotPoint {
-                auto*       c         = static_cast<XYContext*>(user_data);
-                std::size_t actualIdx = c->offset + static_cast<std::size_t>(idx);
-                double      x         = c->sink->xAt(actualIdx);
-                double      y         = static_cast<double>(c->sink->yAt(actualIdx));
-                return ImPlotPoint(x, y);
+                const auto* w = static_cast<const SignalSink::SampleSpans*>(user_data);
+                return ImPlotPoint(w->xAt(static_cast<std::size_t>(idx)), static_cast<double>(w->y[static_cast<std::size_t>(idx)]));
             },
-            &ctx, static_cast<int>(dataCount));
+            &window, static_cast<int>(window.size()));
 
         tooltip::showPlotMouseTooltip();
         handleCommonInteractions(chartMode);
@@ -241,24 +235,10 @@ struct YYChart : gr::Block<YYChart, gr::Drawable<gr::UICategory::Content, "ImGui
         ImVec4 lineColor = sinkColor(sinkYPtr->color());
         ImPlot::SetNextLineStyle(lineColor);
 
-        struct CorrelationContext {
-            const SignalSink* sink_x;
-            const SignalSink* sink_y;
-            std::size_t       offset;
-        };
-        CorrelationContext ctx{sinkXPtr.get(), sinkYPtr.get(), offset};
-        std::string        yLegendLabel{sinkYPtr->signalName()};
-
-        ImPlot::PlotLineG(
-            yLegendLabel.c_str(),
-            [](int idx, void* user_data) -> ImPlotPoint {
-                auto*       c         = static_cast<CorrelationContext*>(user_data);
-                std::size_t actualIdx = c->offset + static_cast<std::size_t>(idx);
-                double      x         = static_cast<double>(c->sink_x->yAt(actualIdx));
-                double      y         = static_cast<double>(c->sink_y->yAt(actualIdx));
-                return ImPlotPoint(x, y);
-            },
-            &ctx, static_cast<int>(count));
+        const SignalSink::SampleSpans xWindow = sinkXPtr->samples(offset, count);
+        const SignalSink::SampleSpans yWindow = sinkYPtr->samples(offset, count);
+        std::string                   yLegendLabel{sinkYPtr->signalName()};
+        ImPlot::PlotLine(yLegendLabel.c_str(), xWindow.y.data(), yWindow.y.data(), static_cast<int>(std::min(xWindow.size(), yWindow.size())));
 
         tooltip::showPlotMouseTooltip();
         handleCommonInteractions(chartMode);
@@ -359,12 +339,6 @@ struct YYChart : gr::Block<YYChart, gr::Drawable<gr::UICategory::Content, "ImGui
             ImPlot::PlotLine(xLegendLabel.c_str(), &dummyX, &dummyY, 1, ImPlotLineFlags_NoClip);
         }
 
-        struct PlotContext {
-            const SignalSink* sinkX;
-            const SignalSink* sinkY;
-            std::size_t       offset;
-        };
-
         for (std::size_t i = 1; i < _signalSinks.size(); ++i) {
             if (std::ranges::contains(overflowSinkIndices, i)) {
                 continue;
@@ -394,18 +368,10 @@ struct YYChart : gr::Block<YYChart, gr::Drawable<gr::UICategory::Content, "ImGui
             ImVec4 lineColor = sinkColor(sinkYPtr->color());
             ImPlot::SetNextLineStyle(lineColor);
 
-            PlotContext ctx{sinkXPtr.get(), sinkYPtr.get(), offset};
-            std::string yLabel{sinkYPtr->signalName()};
-            ImPlot::PlotLineG(
-                yLabel.c_str(),
-                [](int idx, void* user_data) -> ImPlotPoint {
-                    auto*       c         = static_cast<PlotContext*>(user_data);
-                    std::size_t actualIdx = c->offset + static_cast<std::size_t>(idx);
-                    double      x         = static_cast<double>(c->sinkX->yAt(actualIdx));
-                    double      y         = static_cast<double>(c->sinkY->yAt(actualIdx));
-                    return ImPlotPoint(x, y);
-                },
-                &ctx, static_cast<int>(count));
+            const SignalSink::SampleSpans xWindow = sinkXPtr->samples(offset, count);
+            const SignalSink::SampleSpans yWindow = sinkYPtr->samples(offset, count);
+            std::string                   yLabel{sinkYPtr->signalName()};
+            ImPlot::PlotLine(yLabel.c_str(), xWindow.y.data(), yWindow.y.data(), static_cast<int>(std::min(xWindow.size(), yWindow.size())));
         }
 
         tooltip::showPlotMouseTooltip();
@@ -0,0 +1,14 @@
+#ifndef OPENDIGITIZER_TEST_BENCHMARK_HPP
+#define OPENDIGITIZER_TEST_BENCHMARK_HPP
+
+#include <chrono>
+
+namespace opendigitizer::test {
+
+using Clock = std::chrono::steady_clock;
+
+[[nodiscard]] inline double elapsedMs(Clock::time_point start) { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); }
+
+} // namespace opendigitizer::test
+
+#endif // OPENDIGITIZER_TEST_BENCHMARK_HPP
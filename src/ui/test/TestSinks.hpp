@@ -15,6 +15,11 @@
 namespace opendigitizer::test {
 
 class TestStreamingSink : public opendigitizer::SignalSink {
+    struct Tag {
+        double           timestamp;
+        gr::property_map map;
+    };
+
     std::string         _uniqueName;
     std::string         _signalName;
     std::uint32_t       _color      = 0xFFFFFF;
@@ -35,6 +40,7 @@ class TestStreamingSink : public opendigitizer::SignalSink {
         std::chrono::time_point<std::chrono::steady_clock> expiry_time;
     };
     std::unordered_map<std::string, CapacityRequest> _capacityRequests;
+    opendigitizer::charts::TagIndex<Tag>             _tags;
 
 public:
     explicit TestStreamingSink(std::string name, std::size_t capacity = 2048) : _uniqueName(std::move(name)), _signalName(_uniqueName), _capacity(capacity) {
@@ -54,6 +60,8 @@ public:
     [[nodiscard]] double      xAt(std::size_t i) const override { return _xValues[i]; }
     [[nodiscard]] float       yAt(std::size_t i) const override { return _yValues[i]; }
 
+    [[nodiscard]] SampleSpans samples(std::size_t startIndex, std::size_t count) const override { return {.x = std::span(_xValues).subspan(startIndex, count), .y = std::span(_yValues).subspan(startIndex, count), ._xStorage = {}, ._yStorage = {}}; }
+
     [[nodiscard]] opendigitizer::PlotData plotData() const override {
         static auto getter = +[](int idx, void* userData) -> opendigitizer::PlotPoint {
             auto* self = static_cast<const TestStreamingSink*>(userData);
@@ -67,9 +75,18 @@ public:
     [[nodiscard]] std::span<const gr::DataSet<float>> dataSets() const override { return {}; }
     [[nodiscard]] SignalKind                          signalKind() const noexcept override { return SignalKind::Streaming; }
 
-    [[nodiscard]] bool                      hasStreamingTags() const noexcept override { return false; }
-    [[nodiscard]] std::pair<double, double> tagTimeRange() const noexcept override { return {0.0, 0.0}; }
-    void                                    forEachTag(std::function<void(double, const gr::property_map&)> /*callback*/) const override {}
+    [[nodiscard]] bool                      hasStreamingTags() const noexcept override { return !_tags.empty(); }
+    [[nodiscard]] std::pair<double, double> tagTimeRange() const noexcept override { return _tags.empty() ? std::pair{0.0, 0.0} : std::pair{_tags.front().timestamp, _tags.back().timestamp}; }
+    void                                    forEachTag(std::function<void(double, const gr::property_map&)> callback) const override {
+        for (const auto& tag : _tags) {
+            callback(tag.timestamp, tag.map);
+        }
+    }
+    void forEachTagInRange(double tMin, double tMax, std::function<void(double, const gr::property_map&)> callback) const override {
+        for (const auto& tag : _tags.range(tMin, tMax)) {
+            callback(tag.timestamp, tag.map);
+        }
+    }
 
     [[nodiscard]] double timeFirst() const noexcept override { return _xValues.empty() ? 0.0 : _xValues.front(); }
     [[nodiscard]] double timeLast() const noexcept override { return _xValues.empty() ? 0.0 : _xValues.back(); }
@@ -110,7 +127,11 @@ public:
         return {startIdx, count};
     }
 
-    [[nodiscard]] DataRange getTagRange(double /*tMin*/, double /*tMax*/) const override { return {0, 0}; }
+    [[nodiscard]] DataRange getTagRange(double tMin, double tMax) const override {
+        const std::size_t startIdx = _tags.lowerIndex(tMin);
+        const std::size_t endIdx   = _tags.upperIndex(tMax);
+        return startIdx < endIdx ? DataRange{startIdx, endIdx - startIdx} : DataRange{0, 0};
+    }
 
     [[nodiscard]] XRangeResult getX(double tMin, double tMax) const override {
         auto [startIdx, count] = getXRange(tMin, tMax);
@@ -134,7 +155,7 @@ public:
         }
         return XYTagRange{XYTagIterator{this, range.start_index, range.start_index + range.count}, XYTagIterator{this, range.start_index + range.count, range.start_index + range.count}};
     }
-    void pruneTags(double /*minX*/) override {}
+    void pruneTags(double minX) override { _tags.eraseBefore(minX); }
 
     [[nodiscard]] opendigitizer::DataGuard dataGuard() const override { return opendigitizer::DataGuard(_mutex); }
 
@@ -170,6 +191,8 @@ public:
         _yValues.push_back(y);
         ++_totalSampleCount;
     }
+
+    void pushTag(double timestamp, gr::property_map map = {}) { _tags.insert(Tag{.timestamp = timestamp, .map = std::move(map)}); }
 };
 
 class TestDataSetSink : public opendigitizer::SignalSink {
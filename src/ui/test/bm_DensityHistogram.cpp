@@ -0,0 +1,106 @@
+#include <boost/ut.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <print>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "charts/SpectrumHelper.hpp"
+
+/**
+ * Per-frame cost of the DensityHistogram CPU path (the real path on machines without usable GL): the previous scalar
+ * decay + max_element + double colormapLookup() vs. the fused DensityCpuKernel. Needs no GL context.
+ *
+ * Not registered with ctest, run manually: ./bm_DensityHistogram
+ */
+
+using namespace opendigitizer::charts;
+using namespace boost::ut;
+using opendigitizer::test::Clock;
+using opendigitizer::test::elapsedMs;
+
+namespace {
+/// noise floor around -80 dB with a few narrow lines, drifting from frame to frame
+void makeSpectrum(std::vector<float>& spectrum, std::size_t frame) {
+    for (std::size_t i = 0; i < spectrum.size(); ++i) {
+        spectrum[i] = -80.f + 6.f * std::sin(0.37f * static_cast<float>(i) + 0.11f * static_cast<float>(frame));
+    }
+    for (std::size_t line = 1; line <= 8UZ; ++line) {
+        spectrum[(line * spectrum.size()) / 9UZ] = -20.f - 3.f * static_cast<float>(line);
+    }
+}
+
+/// the CPU path before the fused kernel, kept for comparison
+struct ScalarReference {
+    std::size_t           width;
+    std::size_t           height;
+    std::vector<float>    cells  = std::vector<float>(width * height, 0.f);
+    std::vector<uint32_t> pixels = std::vector<uint32_t>(width * height, 0U);
+
+    void update(std::span<const float> yValues, double decayFactor, double yMin, double yMax, std::span<const uint32_t, kColormapSize> lut) {
+        for (auto& cell : cells) {
+            cell *= static_cast<float>(decayFactor);
+        }
+        const double invRange = static_cast<double>(height) / (yMax - yMin);
+        for (std::size_t i = 0; i < width; ++i) {
+            const auto bin = static_cast<std::size_t>(std::clamp((yMax - static_cast<double>(yValues[i])) * invRange, 0.0, static_cast<double>(height - 1)));
+            cells[bin * width + i] += 1.f;
+        }
+        const float maxDensity = std::max(*std::ranges::max_element(cells), 1.f);
+        std::ranges::transform(cells, pixels.begin(), [&](float density) { return colormapLookup(static_cast<double>(density), 0.0, static_cast<double>(maxDensity), lut); });
+    }
+};
+} // namespace
+
+const boost::ut::suite DensityHistogram_benchmarks = [] {
+    "density histogram CPU update"_test = [] {
+        constexpr std::size_t kFrames = 200;
+        constexpr double      kYMin   = -120.0;
+        constexpr double      kYMax   = 0.0;
+        constexpr double      kDecay  = 1.0 - 1.0 / 20.0;
+
+        std::array<uint32_t, kColormapSize> lut{};
+        std::iota(lut.begin(), lut.end(), 0U);
+
+        std::println("{:>6} x {:>6}  {:>12}  {:>12}  {:>8}  {:>10}", "width", "height", "scalar [ms]", "fused [ms]", "speed-up", "dirty rows");
+        for (std::size_t width : {kLogSpectrumColumns, kMaxSpectrumColumns}) {
+            for (std::size_t height : {128UZ, 512UZ}) {
+                std::vector<float> spectrum(width);
+                ScalarReference    reference{.width = width, .height = height};
+                DensityCpuKernel   kernel;
+                kernel.resize(width, height);
+
+                double      scalarMs  = 0.0;
+                double      fusedMs   = 0.0;
+                std::size_t dirtyRows = 0UZ;
+                for (std::size_t frame = 0; frame < kFrames; ++frame) {
+                    makeSpectrum(spectrum, frame);
+
+                    auto start = Clock::now();
+                    reference.update(spectrum, kDecay, kYMin, kYMax, lut);
+                    scalarMs += elapsedMs(start);
+
+                    start = Clock::now();
+                    kernel.update(spectrum, width, static_cast<float>(kDecay), kYMin, kYMax, lut);
+                    fusedMs += elapsedMs(start);
+                    dirtyRows += kernel.dirtyEnd() - kernel.dirtyBegin();
+                }
+
+                std::size_t mismatches = 0UZ; // LUT index may differ by one where float and double round differently
+                for (std::size_t cell = 0; cell < reference.pixels.size(); ++cell) {
+                    const auto a = reference.pixels[cell];
+                    const auto b = kernel.pixels()[cell];
+                    mismatches += std::max(a, b) - std::min(a, b) > 1U ? 1UZ : 0UZ;
+                }
+                expect(eq(mismatches, 0UZ)) << width << "x" << height;
+
+                std::println("{:>6} x {:>6}  {:12.3f}  {:12.3f}  {:7.1f}x  {:10}", width, height, scalarMs / kFrames, fusedMs / kFrames, scalarMs / fusedMs, dirtyRows / kFrames);
+            }
+        }
+    };
+};
+
+int main() { /* not needed for ut */ }
@@ -0,0 +1,140 @@
+#include <boost/ut.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <print>
+#include <utility>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "blocks/ImPlotSink.hpp"
+
+/**
+ * Access paths of a streaming ImPlotSink as the charts use them, i.e. through its SinkAdapter: the bulk samples() window vs.
+ * per-sample xAt()/yAt(), and the timestamp-indexed tag lookup of xyTagRange() vs. the default linear scan over all tags.
+ * Needs no GL context.
+ *
+ * Not registered with ctest, run manually: ./bm_SignalSink
+ */
+
+using namespace opendigitizer;
+using namespace opendigitizer::charts;
+using namespace boost::ut;
+using opendigitizer::test::Clock;
+
+namespace {
+using Sink = ImPlotSink<float>;
+
+constexpr double kSamplePeriod = 1e-6;
+
+/// publishes `nSamples` samples (and a tag every `tagStride` samples, 0: none) to the sink like processBulk() would
+void fill(Sink& sink, std::size_t nSamples, std::size_t tagStride = 0UZ) {
+    sink.requestCapacity("bm_SignalSink", nSamples);
+    std::lock_guard lock(sink.dataMutex());
+    sink._pending.x.push_back({.origin = 0.0, .period = kSamplePeriod, .originCount = 0UZ, .count = nSamples});
+    sink._pending.y.resize(nSamples);
+    for (std::size_t i = 0; i < nSamples; ++i) {
+        sink._pending.y[i] = static_cast<float>(i % 1000UZ);
+        if (tagStride > 0UZ && i % tagStride == 0UZ) {
+            sink._pending.tags.push_back({.timestamp = static_cast<double>(i) * kSamplePeriod, .map = {}});
+        }
+    }
+    sink.publishPending();
+}
+
+/// the same adapter with the default SignalSink::forEachTagInRange(), i.e. a scan over all tags per lookup
+struct LinearTagLookupAdapter : SinkAdapter<Sink> {
+    using SinkAdapter<Sink>::SinkAdapter;
+    void forEachTagInRange(double tMin, double tMax, std::function<void(double, const gr::property_map&)> callback) const override { SignalSink::forEachTagInRange(tMin, tMax, std::move(callback)); }
+};
+} // namespace
+
+const boost::ut::suite SignalSink_benchmarks = [] {
+    "bulk samples() vs. per-sample xAt()/yAt()"_test = [] {
+        constexpr std::size_t kSamples     = 1'000'000UZ;
+        constexpr std::size_t kRepetitions = 10UZ;
+
+        Sink sink(gr::property_map{});
+        fill(sink, kSamples);
+        const SinkAdapter<Sink> adapter(sink);
+        const SignalSink&       base = adapter; // go through the vtable like the charts do
+
+        std::vector<double> perSampleX(kSamples);
+        std::vector<float>  perSampleY(kSamples);
+        std::vector<double> bulkX(kSamples);
+        std::vector<float>  bulkY(kSamples);
+
+        auto bestPerSample = Clock::duration::max();
+        auto bestBulk      = Clock::duration::max();
+        for (std::size_t repetition = 0; repetition < kRepetitions; ++repetition) {
+            auto guard = base.dataGuard();
+            auto start = Clock::now();
+            for (std::size_t i = 0; i < kSamples; ++i) {
+                perSampleX[i] = base.xAt(i);
+                perSampleY[i] = base.yAt(i);
+            }
+            bestPerSample = std::min(bestPerSample, Clock::now() - start);
+
+            start              = Clock::now();
+            const auto samples = base.samples(0UZ, kSamples);
+            samples.fillX(0UZ, bulkX);
+            std::ranges::copy(samples.y, bulkY.begin());
+            bestBulk = std::min(bestBulk, Clock::now() - start);
+        }
+
+        expect(perSampleX == bulkX);
+        expect(perSampleY == bulkY);
+
+        using us = std::chrono::duration<double, std::micro>;
+        std::println("{} samples, best of {}: xAt()/yAt(): {:8.1f} us  samples(): {:8.1f} us  speed-up: {:.1f}x", kSamples, kRepetitions, //
+            us(bestPerSample).count(), us(bestBulk).count(), us(bestPerSample).count() / std::max(us(bestBulk).count(), 1e-3));
+    };
+
+    "indexed tag lookup (10k tags over 1M samples)"_test = [] {
+        constexpr std::size_t kSamples       = 1'000'000UZ;
+        constexpr std::size_t kTagStride     = 100UZ;    // -> 10k tags
+        constexpr std::size_t kLinearSamples = 20'000UZ; // the O(samples x tags) baseline only runs on a slice
+
+        Sink sink(gr::property_map{});
+        fill(sink, kSamples, kTagStride);
+        const SinkAdapter<Sink>      indexed(sink);
+        const LinearTagLookupAdapter linear(sink);
+
+        auto traverse = [](const SignalSink& adapter, double tMin, double tMax) {
+            auto        guard    = adapter.dataGuard();
+            std::size_t nSamples = 0UZ;
+            std::size_t nTagged  = 0UZ;
+            for (const auto& sample : adapter.xyTagRange(tMin, tMax)) {
+                ++nSamples;
+                nTagged += sample.tags.empty() ? 0UZ : 1UZ;
+            }
+            return std::pair{nSamples, nTagged};
+        };
+
+        using ns          = std::chrono::duration<double, std::nano>;
+        const double tEnd = static_cast<double>(kLinearSamples - 1UZ) * kSamplePeriod;
+
+        auto       start        = Clock::now();
+        const auto full         = traverse(indexed, -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity());
+        const auto indexedTime  = Clock::now() - start;
+        start                   = Clock::now();
+        const auto linearSlice  = traverse(linear, 0.0, tEnd);
+        const auto linearTime   = Clock::now() - start;
+        const auto indexedSlice = traverse(indexed, 0.0, tEnd);
+
+        expect(eq(full.first, kSamples));
+        expect(eq(full.second, kSamples / kTagStride));
+        expect(indexedSlice == linearSlice) << "both lookups must find the same tags";
+
+        const double indexedPerSample = ns(indexedTime).count() / static_cast<double>(kSamples);
+        const double linearPerSample  = ns(linearTime).count() / static_cast<double>(kLinearSamples);
+        std::println("xyTagRange with {} tags: indexed {:.1f} ns/sample ({} samples), linear scan {:.1f} ns/sample ({} samples), speed-up: {:.0f}x", //
+            kSamples / kTagStride, indexedPerSample, kSamples, linearPerSample, kLinearSamples, linearPerSample / std::max(indexedPerSample, 1e-3));
+    };
+};
+
+int main() { /* not needed for ut */ }
@@ -2,9 +2,41 @@
 
 #include <boost/ut.hpp>
 
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <cmath>
+#include <limits>
+#include <numeric>
 #include <thread>
+#include <vector>
+
+namespace {
+/// DataSet sink exposing its retained DataSets as one contiguous span, oldest first, like ImPlotSink::dataSets()
+class ContiguousDataSetSink : public opendigitizer::test::TestDataSetSink {
+    std::vector<gr::DataSet<float>> _history;
+    std::size_t                     _capacity;
+    std::size_t                     _published = 0UZ;
+
+public:
+    ContiguousDataSetSink(std::string name, std::size_t capacity) : TestDataSetSink(std::move(name), capacity), _capacity(capacity) {}
+
+    [[nodiscard]] std::size_t                         dataSetCount() const noexcept override { return _history.size(); }
+    [[nodiscard]] std::span<const gr::DataSet<float>> dataSets() const override { return _history; }
+    [[nodiscard]] std::size_t                         totalSampleCount() const noexcept override { return _published; }
+
+    void publish(float value) {
+        gr::DataSet<float> ds;
+        ds.axis_values   = {{0.f}};
+        ds.signal_values = {value};
+        if (_history.size() == _capacity) {
+            _history.erase(_history.begin());
+        }
+        _history.push_back(std::move(ds));
+        ++_published;
+    }
+};
+} // namespace
 
 int main() {
     using namespace boost::ut;
@@ -51,6 +83,39 @@ int main() {
         expect(eq(chart->signalSinkCount(), 0UZ));
     };
 
+    "XYChart copies only newly published DataSets into its history"_test = [] {
+        auto chart               = makeXYChart();
+        chart->max_history_count = 3U;
+
+        ContiguousDataSetSink   sink("history_sink", 10UZ);
+        XYChart::DataSetHistory history;
+        auto                    values = [&history] {
+            std::vector<float> result;
+            std::ranges::transform(history.dataSets, std::back_inserter(result), [](const auto& ds) { return ds.signal_values.front(); });
+            return result;
+        };
+
+        for (int i = 0; i < 5; ++i) {
+            sink.publish(static_cast<float>(i));
+        }
+        chart->updateDataSetHistory(sink, history);
+        expect(values() == std::vector{2.f, 3.f, 4.f});
+        const float* newest = history.dataSets.back().signal_values.data();
+
+        chart->updateDataSetHistory(sink, history); // nothing published meanwhile
+        expect(values() == std::vector{2.f, 3.f, 4.f});
+        expect(history.dataSets.back().signal_values.data() == newest) << "unchanged sink must not be re-copied";
+
+        sink.publish(5.f);
+        chart->updateDataSetHistory(sink, history);
+        expect(values() == std::vector{3.f, 4.f, 5.f});
+        expect(history.dataSets[1UZ].signal_values.data() == newest) << "retained DataSets must be kept, not re-copied";
+
+        chart->max_history_count = 5U; // cannot be continued from the 3 retained ones
+        chart->updateDataSetHistory(sink, history);
+        expect(values() == std::vector{1.f, 2.f, 3.f, 4.f, 5.f});
+    };
+
     "Chart mixin via concrete types"_test = [] {
         auto xyChart = makeXYChart("MixinTest");
 
@@ -460,5 +525,184 @@ int main() {
         expectEntry.template operator()<WaterfallPlot>();
     };
 
+    "SurfaceBuffer addresses rows by absolute index across wrap-around and resize"_test = [] {
+        SurfaceBuffer      buffer;
+        std::vector<float> freq{1.f, 2.f, 3.f};
+        buffer.init(freq.size(), 4UZ);
+        const std::size_t initialVersion = buffer._layoutVersion;
+        for (std::size_t row = 0; row < 10UZ; ++row) {
+            const std::vector<float> magnitudes(freq.size(), static_cast<float>(row));
+            buffer.pushRow(freq, magnitudes, freq.size(), static_cast<double>(row));
+        }
+        expect(eq(buffer._rowsPushed, 10UZ));
+        expect(eq(buffer._layoutVersion, initialVersion + 1UZ)) << "only the first frequency axis changes the layout";
+        expect(eq(buffer.newestTimestamp(), 9.0));
+        for (std::size_t row = 6UZ; row < 10UZ; ++row) {
+            expect(eq(buffer._timestamps[buffer.ringRowOf(row)], static_cast<double>(row)));
+        }
+
+        buffer.resizeHistory(3UZ);
+        expect(eq(buffer._layoutVersion, initialVersion + 2UZ));
+        for (std::size_t row = 7UZ; row < 10UZ; ++row) {
+            expect(eq(buffer._magnitudes[buffer.ringRowOf(row) * freq.size()], static_cast<float>(row)));
+        }
+    };
+
+    "decimateRow keeps single-bin peaks at any ratio"_test = [] {
+        std::vector<float> spectrum(1000UZ, -100.f);
+        spectrum[0]   = -20.f;
+        spectrum[517] = -10.f;
+        spectrum[999] = -30.f;
+        for (std::size_t columns : {7UZ, 64UZ, 333UZ, 512UZ, 999UZ}) {
+            std::vector<float> out(columns);
+            decimateRow(spectrum, out);
+            expect(eq(std::ranges::count(out, -10.f), 1L)) << "columns" << columns;
+            expect(eq(out.front(), -20.f));
+            expect(eq(out.back(), -30.f));
+            expect(eq(std::ranges::count(out, -100.f), static_cast<long>(columns) - 3L));
+        }
+
+        std::vector<float> widened(4UZ);
+        decimateRow(std::vector<float>{1.f, 2.f}, widened);
+        expect(widened == std::vector<float>{1.f, 1.f, 2.f, 2.f}) << "columns finer than the bins repeat them";
+
+        std::vector<float> rms(2UZ);
+        decimateRow(std::vector<float>{3.f, 4.f, 4.f, 3.f, 1.f, 1.f}, rms, Decimation::Rms);
+        expect(approx(rms[0], std::sqrt(41.f / 3.f), 1e-5f));
+        expect(approx(rms[1], std::sqrt(11.f / 3.f), 1e-5f));
+    };
+
+    "colourise matches colormapLookup and maps log scales by decade"_test = [] {
+        std::array<uint32_t, kColormapSize> lut{};
+        std::iota(lut.begin(), lut.end(), 0U); // pixel == LUT index
+
+        std::vector<float> values;
+        for (int i = -200; i <= 200; ++i) {
+            values.push_back(0.37f * static_cast<float>(i));
+        }
+        values.insert(values.end(), {std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), std::numeric_limits<float>::quiet_NaN()});
+        std::vector<uint32_t> pixels(values.size());
+        for (const auto& [scaleMin, scaleMax] : {std::pair{-50.0, 50.0}, std::pair{0.0, 10.0}, std::pair{-100.0, -20.0}, std::pair{5.0, 5.0}}) {
+            colourise(values, pixels, ColormapScale::linear(scaleMin, scaleMax), lut);
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                const auto expected = colormapLookup(static_cast<double>(values[i]), scaleMin, scaleMax, lut);
+                expect(le(std::max(expected, pixels[i]) - std::min(expected, pixels[i]), 1U)) << "value" << values[i] << "range" << scaleMin << scaleMax;
+            }
+        }
+
+        const std::vector<float> decades{-1.f, 0.f, 1.f, 10.f, 100.f, 1000.f, 1e6f};
+        colourise(decades, pixels, ColormapScale::logarithmic(1.0, 1000.0), lut);
+        expect(std::ranges::equal(std::span(pixels).first(decades.size()), std::vector<uint32_t>{0U, 0U, 0U, 85U, 170U, 255U, 255U}));
+    };
+
+    "LogBinningPlan matches buildLogBinnedRow and is only rebuilt on layout changes"_test = [] {
+        for (std::size_t nBins : {100UZ, 65536UZ}) {
+            std::vector<float> freqs(nBins);
+            std::vector<float> mags(nBins);
+            for (std::size_t k = 0; k < nBins; ++k) {
+                freqs[k] = 24000.f * static_cast<float>(k) / static_cast<float>(nBins);
+                mags[k]  = -60.f + 30.f * std::sin(0.1f * static_cast<float>(k));
+            }
+            mags[nBins / 3UZ] = -std::numeric_limits<float>::infinity(); // dB of an empty bin
+
+            std::vector<float> expected(kLogSpectrumColumns);
+            std::vector<float> binned(kLogSpectrumColumns);
+            LogBinningPlan     plan;
+            buildLogBinnedRow(freqs, mags, nBins, 10.0, 20000.0, expected);
+            expect(plan.apply(freqs, mags, nBins, 10.0, 20000.0, binned));
+            expect(binned == expected) << "nBins" << nBins;
+
+            std::ranges::reverse(mags); // same layout, new values
+            buildLogBinnedRow(freqs, mags, nBins, 10.0, 20000.0, expected);
+            expect(!plan.apply(freqs, mags, nBins, 10.0, 20000.0, binned));
+            expect(binned == expected);
+
+            std::ranges::reverse(freqs); // descending axis: bins of one column are no longer contiguous
+            buildLogBinnedRow(freqs, mags, nBins, 10.0, 20000.0, expected);
+            expect(plan.apply(freqs, mags, nBins, 10.0, 20000.0, binned));
+            expect(binned == expected);
+            expect(eq(plan.builds(), 2UZ));
+        }
+
+        LogBinningPlan           plan;
+        const std::vector<float> freqs{100.f, 200.f, 300.f, 400.f};
+        const std::vector<float> mags{-10.f, -10.f, -10.f, -40.f};
+        std::vector<float>       band(1UZ);
+        plan.apply(freqs, mags, freqs.size(), 50.0, 1000.0, band, LogBinning::Max);
+        expect(eq(band[0], -10.f));
+        plan.apply(freqs, mags, freqs.size(), 50.0, 1000.0, band, LogBinning::Mean);
+        expect(eq(band[0], -17.5f));
+        plan.apply(freqs, mags, freqs.size(), 50.0, 1000.0, band, LogBinning::PowerSum);
+        expect(approx(band[0], static_cast<float>(10.0 * std::log10(3.0 * 0.1 + 1e-4)), 1e-4f));
+        expect(eq(plan.builds(), 1UZ));
+
+        // a zero-power bin (-inf dB) or NaN must not poison the column, the aggregate is taken over the finite bins only
+        const std::vector<float> withEmptyBin{-10.f, -std::numeric_limits<float>::infinity(), -10.f, -40.f};
+        plan.apply(freqs, withEmptyBin, freqs.size(), 50.0, 1000.0, band, LogBinning::Max);
+        expect(eq(band[0], -10.f));
+        plan.apply(freqs, withEmptyBin, freqs.size(), 50.0, 1000.0, band, LogBinning::Mean);
+        expect(eq(band[0], -20.f));
+        plan.apply(freqs, withEmptyBin, freqs.size(), 50.0, 1000.0, band, LogBinning::PowerSum);
+        expect(approx(band[0], static_cast<float>(10.0 * std::log10(2.0 * 0.1 + 1e-4)), 1e-4f));
+        const std::vector<float> withNaNBin{-10.f, std::numeric_limits<float>::quiet_NaN(), -10.f, -40.f};
+        plan.apply(freqs, withNaNBin, freqs.size(), 50.0, 1000.0, band, LogBinning::Mean);
+        expect(eq(band[0], -20.f));
+
+        // a column without any finite bin repeats its left neighbour (columns split at sqrt(50 * 1000) ~ 224 Hz)
+        const std::vector<float> emptyUpperColumn{-10.f, -20.f, -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity()};
+        std::vector<float>       twoColumns(2UZ);
+        for (const auto mode : {LogBinning::Max, LogBinning::Mean, LogBinning::PowerSum}) {
+            plan.apply(freqs, emptyUpperColumn, freqs.size(), 50.0, 1000.0, twoColumns, mode);
+            expect(std::isfinite(twoColumns[0]) && twoColumns[1] == twoColumns[0]) << "mode" << static_cast<int>(mode);
+        }
+        expect(approx(twoColumns[0], static_cast<float>(10.0 * std::log10(0.1 + 0.01)), 1e-4f)) << "PowerSum of the lower column";
+    };
+
+    "DensityCpuKernel matches the scalar decay/normalise/colourise reference"_test = [] {
+        constexpr std::size_t kWidth  = 64UZ;
+        constexpr std::size_t kHeight = 32UZ;
+        constexpr double      kYMin   = -100.0;
+        constexpr double      kYMax   = 0.0;
+        constexpr double      kDecay  = 1.0 - 1.0 / 8.0;
+
+        std::array<uint32_t, kColormapSize> lut{};
+        std::iota(lut.begin(), lut.end(), 0U); // pixel == LUT index
+
+        DensityCpuKernel kernel;
+        kernel.resize(kWidth, kHeight);
+        std::vector<float> reference(kWidth * kHeight, 0.f);
+        std::vector<float> spectrum(kWidth);
+        for (std::size_t frame = 0; frame < 40UZ; ++frame) {
+            for (std::size_t i = 0; i < kWidth; ++i) { // a line at bin 20 over a slowly drifting noise floor
+                spectrum[i] = i == 20UZ ? -10.f : -80.f + 5.f * std::sin(static_cast<float>(i + frame));
+            }
+            kernel.update(spectrum, kWidth, static_cast<float>(kDecay), kYMin, kYMax, lut);
+
+            for (float& cell : reference) {
+                cell *= static_cast<float>(kDecay);
+            }
+            for (std::size_t i = 0; i < kWidth; ++i) {
+                const auto bin = static_cast<std::size_t>(std::clamp((kYMax - static_cast<double>(spectrum[i])) * static_cast<double>(kHeight) / (kYMax - kYMin), 0.0, static_cast<double>(kHeight - 1)));
+                reference[bin * kWidth + i] += 1.f;
+            }
+            const float maxDensity = std::max(*std::ranges::max_element(reference), 1.f);
+            expect(approx(kernel.peak(), maxDensity, 1e-4f)) << "frame" << frame;
+            for (std::size_t cell = 0; cell < reference.size(); ++cell) {
+                const auto expected = colormapLookup(static_cast<double>(reference[cell]), 0.0, static_cast<double>(maxDensity), lut);
+                expect(le(std::max(expected, kernel.pixels()[cell]) - std::min(expected, kernel.pixels()[cell]), 1U)) << "frame" << frame << "cell" << cell;
+            }
+        }
+        expect(lt(kernel.dirtyEnd() - kernel.dirtyBegin(), kHeight)) << "rows that never held density are not re-colourised";
+
+        // without decay, only the rows hit by the new spectrum change once the peak settles
+        kernel.resize(kWidth, kHeight);
+        const std::vector<float> flat(kWidth, -50.f);
+        kernel.update(flat, kWidth, 1.f, kYMin, kYMax, lut);
+        expect(eq(kernel.dirtyEnd() - kernel.dirtyBegin(), kHeight)) << "first update colourises the whole grid";
+        kernel.update(flat, kWidth, 1.f, kYMin, kYMax, lut);
+        expect(eq(kernel.dirtyEnd() - kernel.dirtyBegin(), 1UZ));
+        expect(eq(kernel.dirtyBegin(), 16UZ));
+    };
+
     return 0;
 }
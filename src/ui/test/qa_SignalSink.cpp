@@ -1,10 +1,14 @@
 #include "TestSinks.hpp"
 
+#include "../charts/ImplicitTimeAxis.hpp"
+#include "../charts/MinMaxPyramid.hpp"
+
 #include <boost/ut.hpp>
 
 #include <chrono>
 #include <cmath>
 #include <numbers>
+#include <random>
 #include <thread>
 
 int main() {
@@ -214,5 +218,120 @@ int main() {
         expect(std::abs(p5.y - 10.0) < 1e-9);
     };
 
+    "MinMaxPyramid extrema match a linear scan"_test = [] {
+        constexpr std::size_t                 kCapacity = 5000UZ;
+        MinMaxPyramid<float>                  pyramid(kCapacity);
+        std::vector<float>                    history; // all samples ever pushed, indexed by absolute sample index
+        std::mt19937                          gen(7);
+        std::uniform_real_distribution<float> value(-1.f, 1.f);
+        for (std::size_t i = 0; i < 3 * kCapacity + 123UZ; ++i) { // wraps around the capacity a few times
+            history.push_back(std::round(value(gen) * 20.f));     // coarse values -> plenty of ties, the first occurrence must win
+            pyramid.push(history.back());
+        }
+        expect(eq(pyramid.count(), history.size()));
+
+        const std::size_t                          oldest = history.size() - kCapacity;
+        std::uniform_int_distribution<std::size_t> start(oldest, history.size() - 1UZ);
+        for (std::size_t trial = 0; trial < 1000UZ; ++trial) {
+            const std::size_t first = start(gen);
+            const std::size_t n     = std::uniform_int_distribution<std::size_t>(1UZ, history.size() - first)(gen);
+            const auto        range = std::span(history).subspan(first, n);
+            const auto        ref   = std::ranges::minmax_element(range);
+            const auto        got   = pyramid.extrema(first, n, [&history](std::size_t i) { return history[i]; });
+            expect(eq(got.min, *ref.min) && eq(got.max, *ref.max)) << "range" << first << n;
+            expect(eq(got.minIndex, first + static_cast<std::size_t>(ref.min - range.begin())));
+            expect(eq(got.maxIndex, first + static_cast<std::size_t>(std::ranges::find(range, *ref.max) - range.begin())));
+        }
+    };
+
+    "MinMaxPyramid bulk pushRange() matches per-sample push()"_test = [] {
+        constexpr std::size_t                      kCapacity = 5000UZ;
+        MinMaxPyramid<float>                       single(kCapacity);
+        MinMaxPyramid<float>                       bulk(kCapacity);
+        std::vector<float>                         history;
+        std::mt19937                               gen(11);
+        std::uniform_real_distribution<float>      value(-1.f, 1.f);
+        std::uniform_int_distribution<std::size_t> chunkSize(0UZ, 2UZ * kCapacity); // includes empty and over-capacity chunks
+        while (history.size() < 10UZ * kCapacity) {
+            std::vector<float> chunk(chunkSize(gen));
+            std::ranges::generate(chunk, [&] { return std::round(value(gen) * 20.f); });
+            for (float sample : chunk) {
+                single.push(sample);
+            }
+            bulk.pushRange(chunk);
+            history.insert(history.end(), chunk.begin(), chunk.end());
+        }
+        expect(eq(bulk.count(), single.count()));
+
+        const std::size_t                          oldest = history.size() - kCapacity;
+        std::uniform_int_distribution<std::size_t> start(oldest, history.size() - 1UZ);
+        for (std::size_t trial = 0; trial < 1000UZ; ++trial) {
+            const std::size_t first    = start(gen);
+            const std::size_t n        = std::uniform_int_distribution<std::size_t>(1UZ, history.size() - first)(gen);
+            const auto        sampleAt = [&history](std::size_t i) { return history[i]; };
+            const auto        ref      = single.extrema(first, n, sampleAt);
+            const auto        got      = bulk.extrema(first, n, sampleAt);
+            expect(eq(got.min, ref.min) && eq(got.max, ref.max) && eq(got.minIndex, ref.minIndex) && eq(got.maxIndex, ref.maxIndex)) << "range" << first << n;
+        }
+    };
+
+    "ImplicitTimeAxis reproduces explicitly stored time stamps"_test = [] {
+        constexpr std::size_t kCapacity = 1000UZ;
+        ImplicitTimeAxis      axis(kCapacity);
+        std::vector<double>   history; // what ImPlotSink used to store per sample
+
+        double      utcOffset   = 1.7e9; // ns-level UTC precision matters
+        double      period      = 1e-6;
+        std::size_t sampleCount = 0UZ;
+        auto        produce     = [&](std::size_t n) {
+            axis.append({.origin = utcOffset, .period = period, .originCount = sampleCount, .count = n});
+            for (std::size_t i = 0; i < n; ++i, ++sampleCount) {
+                history.push_back(utcOffset + static_cast<double>(sampleCount) * period);
+            }
+        };
+        auto expectSameAsHistory = [&](std::string_view what) {
+            const std::size_t size = std::min(history.size(), axis.capacity());
+            expect(eq(axis.size(), size)) << what;
+            const auto          expected = std::span(history).last(size);
+            std::vector<double> filled(size);
+            axis.fill(0UZ, filled);
+            expect(std::ranges::equal(filled, expected)) << what << "fill()";
+            bool allEqual = true;
+            for (std::size_t i = 0; i < size; ++i) {
+                allEqual = allEqual && axis[i] == expected[i];
+            }
+            expect(allEqual) << what << "operator[]";
+            auto reader = axis.reader();
+            for (std::size_t i = 0; i < size; ++i) {
+                allEqual = allEqual && reader[i] == expected[i];
+            }
+            allEqual = allEqual && (size == 0UZ || reader[0UZ] == expected[0UZ]); // jumping back leaves the cached segment
+            expect(allEqual) << what << "reader()";
+        };
+
+        produce(300UZ);
+        produce(400UZ); // continues the segment
+        expect(eq(axis.segments(), 1UZ));
+        expectSameAsHistory("single segment");
+
+        utcOffset   = 1.7e9 + 0.5; // trigger: new time origin
+        sampleCount = 0UZ;
+        produce(250UZ);
+        period = 2e-6; // sample rate change
+        produce(500UZ);
+        expect(eq(axis.segments(), 3UZ)) << "one anchor per segment overlapping the retained window";
+        expectSameAsHistory("wrapped across segments");
+
+        const std::size_t lower = axis.lowerBound(history[history.size() - 300UZ]);
+        const std::size_t upper = axis.upperBound(history[history.size() - 100UZ]);
+        expect(eq(lower, kCapacity - 300UZ));
+        expect(eq(upper, kCapacity - 99UZ));
+
+        axis.resize(200UZ); // keeps the newest samples, like HistoryBuffer::resize()
+        history.erase(history.begin(), history.end() - 200);
+        expect(eq(axis.segments(), 1UZ)) << "segments older than the retained window are dropped";
+        expectSameAsHistory("after shrinking");
+    };
+
     return 0;
 }
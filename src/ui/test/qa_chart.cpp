@@ -21,10 +21,24 @@
 #include "blocks/ImPlotSink.hpp"
 #include "blocks/SineSource.hpp"
 #include "blocks/TestSpectrumGenerator.hpp"
+#include "charts/MinMaxPyramid.hpp"
+#include "charts/RenderPrep.hpp"
 
 #include <cmrc/cmrc.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <memory>
+#include <mutex>
+#include <numbers>
+#include <optional>
+#include <print>
+#include <random>
+#include <span>
+#include <thread>
+#include <vector>
 
 CMRC_DECLARE(ui_test_assets);
 
@@ -33,6 +47,395 @@ using namespace boost::ut;
 
 opendigitizer::test::TestDashboardRunner g_state;
 
+namespace {
+/// Y extent covered by a polyline within each pixel column, i.e. what a line renderer lights up
+std::vector<std::pair<double, double>> rasterise(std::span<const double> x, std::span<const double> y, double xOrigin, double columnWidth, std::size_t nColumns) {
+    std::vector<std::pair<double, double>> columns(nColumns, {std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()});
+
+    auto columnOf = [&](double xVal) { return static_cast<std::int64_t>(std::floor((xVal - xOrigin) / columnWidth)); };
+    auto touch    = [&](std::int64_t column, double yVal) {
+        if (column >= 0 && static_cast<std::size_t>(column) < nColumns) {
+            columns[static_cast<std::size_t>(column)].first  = std::min(columns[static_cast<std::size_t>(column)].first, yVal);
+            columns[static_cast<std::size_t>(column)].second = std::max(columns[static_cast<std::size_t>(column)].second, yVal);
+        }
+    };
+    for (std::size_t i = 0; i + 1 < x.size(); ++i) {
+        const auto interpolate = [&](double xVal) { return x[i + 1] == x[i] ? y[i] : y[i] + (y[i + 1] - y[i]) * (xVal - x[i]) / (x[i + 1] - x[i]); };
+        for (std::int64_t column = columnOf(x[i]); column <= columnOf(x[i + 1]); ++column) {
+            const double left  = xOrigin + static_cast<double>(column) * columnWidth;
+            const double right = left + columnWidth;
+            touch(column, interpolate(std::max(x[i], left)));
+            touch(column, interpolate(std::min(x[i + 1], right)));
+        }
+    }
+    return columns;
+}
+} // namespace
+
+const boost::ut::suite M4Decimation_tests = [] {
+    "visually equivalent to the undecimated line"_test = [] {
+        constexpr std::size_t            kSamples = 1'000'000UZ;
+        std::mt19937                     gen(42);
+        std::normal_distribution<double> noise(0.0, 0.05);
+        std::vector<double>              x(kSamples);
+        std::vector<double>              y(kSamples);
+        for (std::size_t i = 0; i < kSamples; ++i) {
+            x[i] = static_cast<double>(i) * 1e-6;
+            y[i] = std::sin(2.0 * std::numbers::pi * 5.0 * x[i]) + noise(gen) + (i % 99'991UZ == 0UZ ? 3.0 : 0.0); // sparse single-sample spikes
+        }
+
+        for (const auto& [xOrigin, pixels] : std::vector<std::pair<double, std::size_t>>{{0.0, 800UZ}, {-0.0123, 1920UZ}, {0.0, 333UZ}}) {
+            const double        columnWidth = (x.back() - xOrigin) / static_cast<double>(pixels);
+            std::vector<double> xDecimated;
+            std::vector<double> yDecimated;
+            opendigitizer::charts::decimation::m4(kSamples, [&x](std::size_t i) { return x[i]; }, [&y](std::size_t i) { return y[i]; }, xOrigin, columnWidth, xDecimated, yDecimated);
+
+            expect(le(xDecimated.size(), 4UZ * (pixels + 1UZ))) << "vertex count scales with the plot width";
+            expect(eq(xDecimated.front(), x.front()) && eq(xDecimated.back(), x.back()));
+
+            const auto  full       = rasterise(x, y, xOrigin, columnWidth, pixels);
+            const auto  decimated  = rasterise(xDecimated, yDecimated, xOrigin, columnWidth, pixels);
+            std::size_t mismatches = 0UZ;
+            for (std::size_t column = 0; column < pixels; ++column) {
+                if (std::abs(full[column].first - decimated[column].first) > 1e-9 || std::abs(full[column].second - decimated[column].second) > 1e-9) {
+                    ++mismatches;
+                }
+            }
+            expect(eq(mismatches, 0UZ)) << "pixels:" << pixels << "origin:" << xOrigin;
+
+            // column-wise variant with the extrema taken from a min/max pyramid must select the very same vertices
+            opendigitizer::charts::MinMaxPyramid<double> pyramid(kSamples);
+            pyramid.pushRange(y);
+            auto extremaOf = [&](std::size_t first, std::size_t n) {
+                const auto extrema = pyramid.extrema(first, n, [&y](std::size_t i) { return y[i]; });
+                return std::pair{extrema.minIndex, extrema.maxIndex};
+            };
+            std::vector<double> xPyramid;
+            std::vector<double> yPyramid;
+            opendigitizer::charts::decimation::m4(kSamples, [&x](std::size_t i) { return x[i]; }, [&y](std::size_t i) { return y[i]; }, extremaOf, xOrigin, columnWidth, xPyramid, yPyramid);
+            expect(xPyramid == xDecimated && yPyramid == yDecimated) << "pyramid-backed M4 differs, pixels:" << pixels;
+        }
+    };
+
+    "column-wise variant assigns samples on column edges like the linear one"_test = [] {
+        // 0.1 is not representable: i * 0.05 and the recomputed column ends k * 0.1 round differently at some edges
+        constexpr std::size_t                  kSamples = 2'000UZ;
+        constexpr double                       kWidth   = 0.1;
+        std::mt19937                           gen(42);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        std::vector<double>                    x(kSamples);
+        std::vector<double>                    y(kSamples);
+        for (std::size_t i = 0; i < kSamples; ++i) {
+            x[i] = static_cast<double>(i) * 0.5 * kWidth; // every other sample on a column edge
+            y[i] = dist(gen);
+        }
+        auto extremaOf = [&y](std::size_t first, std::size_t n) {
+            const auto [minIt, maxIt] = std::minmax_element(y.begin() + static_cast<std::ptrdiff_t>(first), y.begin() + static_cast<std::ptrdiff_t>(first + n));
+            return std::pair{static_cast<std::size_t>(minIt - y.begin()), static_cast<std::size_t>(maxIt - y.begin())};
+        };
+
+        std::vector<double> xLinear;
+        std::vector<double> yLinear;
+        std::vector<double> xColumnWise;
+        std::vector<double> yColumnWise;
+        opendigitizer::charts::decimation::m4(kSamples, [&x](std::size_t i) { return x[i]; }, [&y](std::size_t i) { return y[i]; }, 0.0, kWidth, xLinear, yLinear);
+        opendigitizer::charts::decimation::m4(kSamples, [&x](std::size_t i) { return x[i]; }, [&y](std::size_t i) { return y[i]; }, extremaOf, 0.0, kWidth, xColumnWise, yColumnWise);
+        expect(xColumnWise == xLinear && yColumnWise == yLinear);
+    };
+};
+
+namespace {
+std::atomic<std::size_t> gRampProduced   = 0UZ;
+std::atomic<bool>        gBurstRequested = false;
+std::atomic<bool>        gBurstFinished  = false;
+} // namespace
+
+/// hardware-paced stand-in: emits a ramp 0, 1, 2, ... in small chunks for `duration_ms`
+template<typename T>
+struct TimedRampSource : public gr::Block<TimedRampSource<T>> {
+    gr::PortOut<T> out;
+
+    gr::Size_t duration_ms = 500U;
+
+    GR_MAKE_REFLECTABLE(TimedRampSource, out, duration_ms);
+
+    std::chrono::steady_clock::time_point _start{};
+
+    void start() { _start = std::chrono::steady_clock::now(); }
+
+    gr::work::Status processBulk(gr::OutputSpanLike auto& output) {
+        if (std::chrono::steady_clock::now() - _start > std::chrono::milliseconds(duration_ms)) {
+            output.publish(0UZ);
+            return gr::work::Status::DONE;
+        }
+
+        std::this_thread::sleep_for(std::chrono::microseconds(100)); // pace like an ADC delivering ~64 samples per 100 us
+        const std::size_t n = std::min(output.size(), 64UZ);
+        for (std::size_t i = 0; i < n; ++i) {
+            output[i] = static_cast<T>(gRampProduced + i);
+        }
+        gRampProduced += n;
+        output.publish(n);
+        return gr::work::Status::OK;
+    }
+};
+
+/// triggered/gated stand-in: emits `burst_size` samples once gBurstRequested is set, then nothing until `duration_ms` expired
+template<typename T>
+struct BurstSource : public gr::Block<BurstSource<T>> {
+    gr::PortOut<T> out;
+
+    gr::Size_t burst_size  = 256U;
+    gr::Size_t duration_ms = 1000U;
+
+    GR_MAKE_REFLECTABLE(BurstSource, out, burst_size, duration_ms);
+
+    std::chrono::steady_clock::time_point _start{};
+    std::size_t                           _emitted = 0UZ;
+
+    void start() { _start = std::chrono::steady_clock::now(); }
+
+    gr::work::Status processBulk(gr::OutputSpanLike auto& output) {
+        if (std::chrono::steady_clock::now() - _start > std::chrono::milliseconds(duration_ms)) {
+            output.publish(0UZ);
+            gBurstFinished = true;
+            return gr::work::Status::DONE;
+        }
+        const std::size_t n = gBurstRequested ? std::min(output.size(), static_cast<std::size_t>(burst_size) - _emitted) : 0UZ;
+        for (std::size_t i = 0; i < n; ++i) {
+            output[i] = static_cast<T>(_emitted + i);
+        }
+        _emitted += n;
+        output.publish(n);
+        if (n == 0UZ) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1)); // idle input
+        }
+        return gr::work::Status::OK;
+    }
+};
+
+const boost::ut::suite ImPlotSinkHandoff_tests = [] {
+    "slow redraws do not stall the scheduler"_test = [] {
+        using namespace std::chrono_literals;
+        constexpr auto kSlowFrame = 50ms; // renderer holding the sink lock far longer than a frame budget
+
+        gr::BlockRegistry registry;
+        gr::registerBlock<TimedRampSource, float>(registry);
+        gr::registerBlock<opendigitizer::ImPlotSink, float>(registry);
+        gr::PluginLoader pluginLoader(registry, gr::globalSchedulerRegistry(), {});
+
+        auto loaded = gr::loadGrc(pluginLoader, R"(blocks:
+  - id: TimedRampSource<float32>
+    parameters:
+      name: stress_source
+      duration_ms: 600
+  - id: opendigitizer::ImPlotSink<float32>
+    parameters:
+      name: stress_sink
+      required_size: 65536
+connections:
+  - [stress_source, 0, stress_sink, 0]
+)");
+        expect(fatal(loaded.has_value()));
+        gr::scheduler::Simple<gr::scheduler::ExecutionPolicy::singleThreaded> scheduler;
+        std::ignore = scheduler.exchange(std::move(loaded).value());
+
+        std::atomic<bool> producing          = true;
+        std::size_t       frames             = 0UZ;
+        std::size_t       inconsistentFrames = 0UZ;
+        std::size_t       maxPendingSeen     = 0UZ; // largest segment processBulk() left pending while the renderer held the lock
+        std::thread       renderer([&] {
+            while (producing) {
+                auto sink = opendigitizer::charts::SinkRegistry::instance().findSink([](const auto& s) { return s.name() == "stress_sink"; });
+                if (sink) {
+                    auto       guard  = sink->dataGuard();
+                    const auto window = sink->samples(0UZ, sink->size());
+                    if ((window.xAxis != nullptr ? window.xAxis->size() - window.xAxisStart : window.x.size()) != window.y.size() || sink->totalSampleCount() < window.size()) {
+                        ++inconsistentFrames;
+                    }
+                    std::this_thread::sleep_for(kSlowFrame);
+                    if (auto* adapter = dynamic_cast<opendigitizer::SinkAdapter<opendigitizer::ImPlotSink<float>>*>(sink.get()); adapter != nullptr && adapter->blockPtr() != nullptr) {
+                        auto&           block = *adapter->blockPtr();
+                        std::lock_guard pendingLock(block._pendingMutex);
+                        maxPendingSeen = std::max(maxPendingSeen, block._pending.y.size());
+                    }
+                    ++frames;
+                }
+                std::this_thread::sleep_for(1ms); // the rest of the frame, without the lock
+            }
+        });
+
+        scheduler.runAndWait();
+        producing = false;
+        renderer.join();
+
+        // everything received while the renderer held the lock must have been published eventually (at the latest on stop())
+        auto sink = opendigitizer::charts::SinkRegistry::instance().findSink([](const auto& s) { return s.name() == "stress_sink"; });
+        expect(fatal(sink != nullptr));
+
+        expect(gt(frames, 0UZ)) << "renderer must have held the lock";
+        expect(eq(inconsistentFrames, 0UZ)) << "renderer must see a consistent snapshot";
+        // the source is paced to at most 64 samples per 100 us, i.e. far less than the backlog limit per 50 ms frame
+        expect(gt(maxPendingSeen, 0UZ)) << "processBulk() must have returned while the renderer held the lock";
+        expect(lt(maxPendingSeen, opendigitizer::ImPlotSink<float>::kMaxPendingBuffers * 65536UZ)) << "the scheduler waited for the renderer";
+
+        auto guard = sink->dataGuard();
+        expect(eq(sink->totalSampleCount(), gRampProduced.load()));
+        expect(eq(sink->size(), std::min(gRampProduced.load(), 65536UZ)));
+        expect(eq(sink->yAt(sink->size() - 1UZ), static_cast<float>(gRampProduced.load() - 1UZ)));
+    };
+
+    "a deferred segment becomes visible without further input"_test = [] {
+        using namespace std::chrono_literals;
+        constexpr std::size_t kBurst = 256UZ;
+
+        gr::BlockRegistry registry;
+        gr::registerBlock<BurstSource, float>(registry);
+        gr::registerBlock<opendigitizer::ImPlotSink, float>(registry);
+        gr::PluginLoader pluginLoader(registry, gr::globalSchedulerRegistry(), {});
+
+        auto loaded = gr::loadGrc(pluginLoader, R"(blocks:
+  - id: BurstSource<float32>
+    parameters:
+      name: burst_source
+      burst_size: 256
+      duration_ms: 2000
+  - id: opendigitizer::ImPlotSink<float32>
+    parameters:
+      name: burst_sink
+      required_size: 4096
+connections:
+  - [burst_source, 0, burst_sink, 0]
+)");
+        expect(fatal(loaded.has_value()));
+        gr::scheduler::Simple<gr::scheduler::ExecutionPolicy::singleThreaded> scheduler;
+        std::ignore = scheduler.exchange(std::move(loaded).value());
+        std::thread runner([&scheduler] { scheduler.runAndWait(); });
+
+        std::shared_ptr<opendigitizer::SignalSink> sink;
+        for (auto deadline = std::chrono::steady_clock::now() + 5s; !sink && std::chrono::steady_clock::now() < deadline;) {
+            sink = opendigitizer::charts::SinkRegistry::instance().findSink([](const auto& s) { return s.name() == "burst_sink"; });
+            std::this_thread::sleep_for(1ms);
+        }
+        expect(fatal(sink != nullptr));
+        auto* adapter = dynamic_cast<opendigitizer::SinkAdapter<opendigitizer::ImPlotSink<float>>*>(sink.get());
+        expect(fatal(adapter != nullptr && adapter->blockPtr() != nullptr));
+        auto& block = *adapter->blockPtr();
+
+        {
+            std::lock_guard lock(block.dataMutex()); // renderer busy while the burst arrives -> processBulk() has to defer it
+            gBurstRequested         = true;
+            std::size_t pendingSize = 0UZ;
+            for (auto deadline = std::chrono::steady_clock::now() + 5s; pendingSize < kBurst && std::chrono::steady_clock::now() < deadline;) {
+                std::this_thread::sleep_for(1ms);
+                std::lock_guard pendingLock(block._pendingMutex);
+                pendingSize = block._pending.y.size();
+            }
+            expect(fatal(eq(pendingSize, kBurst))) << "the burst must have been parked while the lock was held";
+        }
+
+        // no more input follows: the next reader taking the lock has to publish the parked segment
+        {
+            auto guard = sink->dataGuard();
+            expect(!gBurstFinished.load()) << "must be published while the graph still runs, not by stop()";
+            expect(eq(sink->size(), kBurst));
+            expect(eq(sink->totalSampleCount(), kBurst));
+            expect(eq(sink->yAt(kBurst - 1UZ), static_cast<float>(kBurst - 1UZ)));
+        }
+
+        runner.join();
+    };
+};
+
+const boost::ut::suite RenderPrep_tests = [] {
+    "render-prep slot publishes the result of one job at a time"_test = [] {
+        using namespace std::chrono_literals;
+        opendigitizer::charts::RenderPrepSlot<std::vector<float>> slot;
+        expect(slot.latest() == nullptr);
+
+        std::atomic<bool> release = false;
+        expect(slot.submit([&release] {
+            while (!release) {
+                std::this_thread::sleep_for(1ms);
+            }
+            return std::optional<std::vector<float>>{std::vector<float>{1.f, 2.f, 3.f}};
+        }));
+        expect(slot.busy());
+        expect(!slot.submit([] { return std::optional<std::vector<float>>{}; })) << "second job must be skipped while the first runs";
+        expect(slot.latest() == nullptr) << "nothing published before the job finished";
+
+        release = true;
+        for (auto deadline = std::chrono::steady_clock::now() + 5s; slot.busy() && std::chrono::steady_clock::now() < deadline;) {
+            std::this_thread::sleep_for(1ms);
+        }
+        expect(fatal(!slot.busy()));
+        const auto result = slot.latest();
+        expect(fatal(result != nullptr));
+        expect(*result == std::vector<float>{1.f, 2.f, 3.f});
+
+        // std::nullopt keeps the previous result
+        expect(slot.submit([] { return std::optional<std::vector<float>>{}; }));
+        for (auto deadline = std::chrono::steady_clock::now() + 5s; slot.busy() && std::chrono::steady_clock::now() < deadline;) {
+            std::this_thread::sleep_for(1ms);
+        }
+        expect(slot.latest() == result);
+    };
+
+    "sink destroyed while a render-prep job reads it"_test = [] {
+        using namespace std::chrono_literals;
+        using Sink               = opendigitizer::ImPlotSink<float>;
+        constexpr std::size_t kN = 100'000UZ;
+
+        auto block = std::make_unique<Sink>(gr::property_map{});
+        block->requestCapacity("qa_chart", kN);
+        {
+            std::lock_guard lock(block->dataMutex());
+            block->_pending.x.push_back({.origin = 0.0, .period = 1e-6, .originCount = 0UZ, .count = kN});
+            block->_pending.y.assign(kN, 1.f);
+            block->publishPending();
+        }
+        block->_sinkAdapter = std::make_shared<opendigitizer::SinkAdapter<Sink>>(*block); // normally created in settingsChanged()
+
+        std::shared_ptr<opendigitizer::SignalSink> sink    = block->_sinkAdapter; // what a chart's job captures
+        std::atomic<bool>                          reading = false;
+
+        opendigitizer::charts::RenderPrepSlot<double> slot;
+        expect(slot.submit([sink, &reading] {
+            auto guard = sink->dataGuard();
+            reading    = true;
+            std::this_thread::sleep_for(20ms); // the block's destructor starts meanwhile
+            const auto window = sink->samples(0UZ, sink->size());
+            double     sum    = 0.0;
+            for (std::size_t i = 0UZ; i < window.size(); ++i) {
+                sum += static_cast<double>(window.y[i]);
+            }
+            return std::optional<double>{sum};
+        }));
+        while (!reading) {
+            std::this_thread::sleep_for(1ms);
+        }
+        block.reset(); // must wait for the job instead of freeing the buffers under it
+
+        for (auto deadline = std::chrono::steady_clock::now() + 5s; slot.busy() && std::chrono::steady_clock::now() < deadline;) {
+            std::this_thread::sleep_for(1ms);
+        }
+        expect(fatal(!slot.busy()));
+        const auto result = slot.latest();
+        expect(fatal(result != nullptr));
+        expect(eq(*result, static_cast<double>(kN))) << "the job must have read the complete, intact buffer";
+
+        // jobs submitted after the destruction see an empty sink
+        expect(slot.submit([sink] {
+            auto guard = sink->dataGuard();
+            return sink->size() == 0UZ ? std::nullopt : std::optional<double>{-1.0};
+        }));
+        for (auto deadline = std::chrono::steady_clock::now() + 5s; slot.busy() && std::chrono::steady_clock::now() < deadline;) {
+            std::this_thread::sleep_for(1ms);
+        }
+        expect(slot.latest() == result);
+    };
+};
+
 struct TestApp : public DigitizerUi::test::ImGuiTestApp {
     using DigitizerUi::test::ImGuiTestApp::ImGuiTestApp;
 
@@ -67,6 +67,10 @@ struct Settings {
     std::string wasmServeDir{""};
     std::string defaultDashboard{"RemoteStream"};
     std::string remoteDashboards{"../dashboard/defaultDashboards"};
+    bool        eventDrivenNotify{false};
+    std::string schedulerPolicy{"singleThreadedBlocking"};
+    std::size_t schedulerThreads{0};
+    std::string schedulerCpuAffinity{""};
 
 private:
     Settings() {
@@ -92,14 +96,18 @@ private:
         if (std::string bindAddressesString = getValueFromEnv("DIGITIZER_BIND_ADDRESSES", ""s); !bindAddressesString.empty()) {
             bindAddresses = bindAddressesString | std::views::split(';') | std::views::transform([](auto&& s) { return s | std::ranges::to<std::string>(); }) | std::ranges::to<std::set>();
         }
-        darkMode          = getValueFromEnv("DIGITIZER_DARK_MODE", darkMode);                   // enable 'dark mode'
-        editableMode      = getValueFromEnv("DIGITIZER_EDIT_MODE", editableMode);               // enable 'editable mode'
-        checkCertificates = getValueFromEnv("DIGITIZER_CHECK_CERTIFICATES", checkCertificates); // disable checking validity of certificates
-        hostname          = getValueFromEnv("DIGITIZER_HOSTNAME", hostname);                    // hostname to set up or connect to
-        basePath          = getValueFromEnv("DIGITIZER_PATH", basePath);                        // path
-        wasmServeDir      = getValueFromEnv("DIGITIZER_WASM_SERVE_DIR", wasmServeDir);          // directory to serve wasm from
-        defaultDashboard  = getValueFromEnv("DIGITIZER_DEFAULT_DASHBOARD", defaultDashboard);   // Default dashboard to load from the service
-        remoteDashboards  = getValueFromEnv("DIGITIZER_REMOTE_DASHBOARDS", remoteDashboards);   // Directory the dashboard worker loads the dashboards from
+        darkMode             = getValueFromEnv("DIGITIZER_DARK_MODE", darkMode);                          // enable 'dark mode'
+        editableMode         = getValueFromEnv("DIGITIZER_EDIT_MODE", editableMode);                      // enable 'editable mode'
+        checkCertificates    = getValueFromEnv("DIGITIZER_CHECK_CERTIFICATES", checkCertificates);        // disable checking validity of certificates
+        hostname             = getValueFromEnv("DIGITIZER_HOSTNAME", hostname);                           // hostname to set up or connect to
+        basePath             = getValueFromEnv("DIGITIZER_PATH", basePath);                               // path
+        wasmServeDir         = getValueFromEnv("DIGITIZER_WASM_SERVE_DIR", wasmServeDir);                 // directory to serve wasm from
+        defaultDashboard     = getValueFromEnv("DIGITIZER_DEFAULT_DASHBOARD", defaultDashboard);          // Default dashboard to load from the service
+        remoteDashboards     = getValueFromEnv("DIGITIZER_REMOTE_DASHBOARDS", remoteDashboards);          // Directory the dashboard worker loads the dashboards from
+        eventDrivenNotify    = getValueFromEnv("DIGITIZER_EVENT_DRIVEN_NOTIFY", eventDrivenNotify);       // wake the acquisition worker on new data instead of polling
+        schedulerPolicy      = getValueFromEnv("DIGITIZER_SCHEDULER_POLICY", schedulerPolicy);            // flow graph execution policy: singleThreaded, singleThreadedBlocking or multiThreaded
+        schedulerThreads     = getValueFromEnv("DIGITIZER_SCHEDULER_THREADS", schedulerThreads);          // number of threads in the CPU pool executing the flow graph (default 0: keep the service's pool of two threads)
+        schedulerCpuAffinity = getValueFromEnv("DIGITIZER_SCHEDULER_CPU_AFFINITY", schedulerCpuAffinity); // CPUs the flow graph threads are pinned to, e.g. "0-3,6" (default: no restriction)
 #ifdef EMSCRIPTEN
         auto        finalURLChar = static_cast<char*>(EM_ASM_PTR({
             var finalURL         = window.location.href;
@@ -151,8 +159,8 @@ private:
             }
         }
 #endif
-        std::println("settings loaded: bindAddresses={}, darkMode={}, editable={}, checkCertificates={}, hostname={}, basePath='{}', wasmServeDir={}, defaultDashboard={}, remoteDashboards={}", //
-            gr::join(bindAddresses), darkMode, editableMode, checkCertificates, hostname, basePath, wasmServeDir, defaultDashboard, remoteDashboards);
+        std::println("settings loaded: bindAddresses={}, darkMode={}, editable={}, checkCertificates={}, hostname={}, basePath='{}', wasmServeDir={}, defaultDashboard={}, remoteDashboards={}, eventDrivenNotify={}, schedulerPolicy={}, schedulerThreads={}, schedulerCpuAffinity='{}'", //
+            gr::join(bindAddresses), darkMode, editableMode, checkCertificates, hostname, basePath, wasmServeDir, defaultDashboard, remoteDashboards, eventDrivenNotify, schedulerPolicy, schedulerThreads, schedulerCpuAffinity);
     }
 
 public: